@@ -7,14 +7,23 @@
 DEFINE_int32(cross_ratio, 0, "cross partition transaction ratio");
 DEFINE_int32(keys, 10000000, "number of accounts in a partition");
 DEFINE_double(zipf, 0, "skew factor");
+DEFINE_string(zipf_partitions, "", "comma-separated skew factors assigned to partitions round-robin, overrides --zipf per partition");
+DEFINE_int64(hot_accounts, 0, "number of hot accounts in a partition, 0 disables the hot set");
+DEFINE_int32(hot_ratio, 90, "percentage of account accesses that go to the hot accounts");
 
 bool do_tid_check = false;
 
 void check_context(star::smallbank::Context &context)
 {
-        // CXL transport supports single consumer only
+        // every i/o thread consumes its own CXL receive ring, the hosts check at startup that they run the same number of them
         if (context.use_cxl_transport == true)
-                DCHECK(context.io_thread_num == 1);
+                CHECK(context.io_thread_num >= 1);
+
+        // two distinct accounts are picked from the same partition, so the hot set needs at least two of them
+        if (context.hotAccountsPerPartition > 0) {
+                CHECK(context.hotAccountsPerPartition >= 2 && context.hotAccountsPerPartition < context.accountsPerPartition);
+                CHECK(context.hotAccountProbability >= 0 && context.hotAccountProbability <= 100);
+        }
 }
 
 int main(int argc, char *argv[])
@@ -28,18 +37,24 @@ int main(int argc, char *argv[])
 
 	context.crossPartitionProbability = FLAGS_cross_ratio;
 	context.accountsPerPartition = FLAGS_keys;
+	context.hotAccountsPerPartition = FLAGS_hot_accounts;
+	context.hotAccountProbability = FLAGS_hot_ratio;
 
 	context.granules_per_partition = FLAGS_granule_count;
 
         if (FLAGS_zipf > 0) {
 		context.isUniform = false;
 		star::Zipf::globalZipf().init(context.accountsPerPartition, FLAGS_zipf);
+		if (FLAGS_zipf_partitions.empty() == false) {
+			star::Zipf::initPartitionZipfs(context.accountsPerPartition, FLAGS_zipf_partitions);
+		}
 	}
 
 	LOG(INFO) << "crossPartitionProbability = " << context.crossPartitionProbability;
         LOG(INFO) << "accountsPerPartition = " << context.accountsPerPartition;
 	LOG(INFO) << "granules_per_partition = " << context.granules_per_partition;
         LOG(INFO) << "Zipf Theta = " << FLAGS_zipf;
+        LOG(INFO) << "hotAccountsPerPartition = " << context.hotAccountsPerPartition << ", hotAccountProbability = " << context.hotAccountProbability;
 
         check_context(context);
 
@@ -5,16 +5,20 @@
 #include "common/CXLMemory.h"
 
 DEFINE_int32(cross_ratio, 0, "cross partition transaction ratio");
-DEFINE_int32(keys, 10000000, "number of accounts in a partition");
+DEFINE_int32(keys, 10000000, "number of subscribers in a partition");
 DEFINE_double(zipf, 0, "skew factor");
+DEFINE_string(zipf_partitions, "", "comma-separated skew factors assigned to partitions round-robin, overrides --zipf per partition");
 
 bool do_tid_check = false;
 
 void check_context(star::tatp::Context &context)
 {
-        // CXL transport supports single consumer only
+        // every i/o thread consumes its own CXL receive ring, the hosts check at startup that they run the same number of them
         if (context.use_cxl_transport == true)
-                DCHECK(context.io_thread_num == 1);
+                CHECK(context.io_thread_num >= 1);
+
+        // subscriber IDs are 32-bit and UINT32_MAX is reserved for the max key
+        CHECK(static_cast<uint64_t>(context.partition_num) * context.numSubScriberPerPartition < UINT32_MAX);
 }
 
 int main(int argc, char *argv[])
@@ -34,6 +38,9 @@ int main(int argc, char *argv[])
         if (FLAGS_zipf > 0) {
 		context.isUniform = false;
 		star::Zipf::globalZipf().init(context.numSubScriberPerPartition, FLAGS_zipf);
+		if (FLAGS_zipf_partitions.empty() == false) {
+			star::Zipf::initPartitionZipfs(context.numSubScriberPerPartition, FLAGS_zipf_partitions);
+		}
 	}
 
 	LOG(INFO) << "crossPartitionProbability = " << context.crossPartitionProbability;
@@ -8,6 +8,7 @@ DEFINE_bool(operation_replication, false, "use operation replication");
 DEFINE_string(query, "neworder", "tpcc query, mixed, neworder, payment, test");
 DEFINE_int32(neworder_dist, 10, "new order distributed.");
 DEFINE_int32(payment_dist, 15, "payment distributed.");
+DEFINE_bool(payment_remote_by_name, false, "select remote payment customers by last name as well.");
 
 // ./main --logtostderr=1 --id=1 --servers="127.0.0.1:10010;127.0.0.1:10011"
 // cmake -DCMAKE_BUILD_TYPE=Release
@@ -15,9 +16,16 @@ bool do_tid_check = false;
 
 void check_context(star::tpcc::Context &context)
 {
-        // CXL transport supports single consumer only
+        // every i/o thread consumes its own CXL receive ring, the hosts check at startup that they run the same number of them
         if (context.use_cxl_transport == true)
-                DCHECK(context.io_thread_num == 1);
+                CHECK(context.io_thread_num >= 1);
+
+        // only the Pasha protocols resolve the name index of a remote partition in the shared region
+        if (context.paymentRemoteByName == true)
+                CHECK(context.protocol == "TwoPLPasha" || context.protocol == "SundialPasha" || context.protocol == "SiloPasha");
+
+        // only the customer and stock tables have CXL indexes, the other rows would have no reservation word
+        CHECK(context.aria_cxl == false) << "aria_cxl is not supported by TPC-C";
 }
 
 int main(int argc, char *argv[])
@@ -49,6 +57,7 @@ int main(int argc, char *argv[])
 
 	context.newOrderCrossPartitionProbability = FLAGS_neworder_dist;
 	context.paymentCrossPartitionProbability = FLAGS_payment_dist;
+	context.paymentRemoteByName = FLAGS_payment_remote_by_name;
 
         check_context(context);
 
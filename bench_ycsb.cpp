@@ -3,6 +3,11 @@
 #include "core/Macros.h"
 #include "common/WALLogger.h"
 #include "common/CXLMemory.h"
+#include "common/ShiftingZipf.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
 
 DEFINE_string(query, "rmw", "ycsb query, mixed, rmw, scan");
 DEFINE_bool(lotus_sp_parallel_exec_commit, false, "parallel execution and commit for Lotus");
@@ -11,7 +16,13 @@ DEFINE_int32(read_only_ratio, 0, "read only transaction ratio");
 DEFINE_int32(cross_ratio, 0, "cross partition transaction ratio");
 DEFINE_int32(keys, 200000, "keys in a partition.");
 DEFINE_double(zipf, 0, "skew factor");
+DEFINE_string(zipf_partitions, "", "comma-separated skew factors assigned to partitions round-robin, overrides --zipf per partition");
 DEFINE_int32(cross_part_num, 2, "Cross-partition partion #");
+DEFINE_string(hotspot_shift, "none", "how the zipf hot set moves over time: none, rotate, drift");
+DEFINE_int64(hotspot_period_ms, 0, "length of a hotspot phase in milliseconds, 0 disables phases");
+DEFINE_int64(hotspot_drift_keys, 1000, "keys the hot set slides by at each phase in drift mode");
+DEFINE_bool(hotspot_permute, false, "use a different hot set in each partition");
+DEFINE_string(zipf_phases, "", "comma-separated skew factors cycled through phases, e.g. 0.5,0.99 (needs --zipf > 0)");
 
 DEFINE_int32(nop_prob, 0, "prob of transactions having nop, out of 10000");
 DEFINE_int64(n_nop, 0, "total number of nop");
@@ -23,9 +34,13 @@ bool do_tid_check = false;
 
 void check_context(star::ycsb::Context &context)
 {
-        // CXL transport supports single consumer only
+        // every i/o thread consumes its own CXL receive ring, the hosts check at startup that they run the same number of them
         if (context.use_cxl_transport == true)
-                DCHECK(context.io_thread_num == 1);
+                CHECK(context.io_thread_num >= 1);
+
+        // keys drawn by hotspot shifting follow the skew of --zipf_phases, the per-partition skew would be ignored
+        if (star::ShiftingZipf::globalShiftingZipf().enabled())
+                CHECK(FLAGS_zipf_partitions.empty()) << "--zipf_partitions cannot be combined with hotspot shifting, use --zipf_phases";
 }
 
 int main(int argc, char *argv[])
@@ -74,6 +89,26 @@ int main(int argc, char *argv[])
 	if (FLAGS_zipf > 0) {
 		context.isUniform = false;
 		star::Zipf::globalZipf().init(context.keysPerPartition, FLAGS_zipf);
+		if (FLAGS_zipf_partitions.empty() == false) {
+			star::Zipf::initPartitionZipfs(context.keysPerPartition, FLAGS_zipf_partitions);
+		}
+
+		auto hotspot_mode = star::ShiftingZipf::mode_from_string(FLAGS_hotspot_shift);
+		std::vector<double> thetas;
+		std::stringstream ss(FLAGS_zipf_phases);
+		std::string theta;
+		while (std::getline(ss, theta, ',')) {
+			thetas.push_back(std::stod(theta));
+		}
+		if (hotspot_mode != star::ShiftingZipf::Mode::NONE || thetas.size() > 1 || FLAGS_hotspot_permute) {
+			if (thetas.empty()) {
+				thetas.push_back(FLAGS_zipf);
+			}
+			star::ShiftingZipf::globalShiftingZipf().init(context.keysPerPartition, thetas, hotspot_mode, FLAGS_hotspot_period_ms,
+								      FLAGS_hotspot_drift_keys, FLAGS_hotspot_permute, context.partition_num);
+			LOG(INFO) << "hotspot_shift " << FLAGS_hotspot_shift << ", hotspot_period_ms " << FLAGS_hotspot_period_ms << ", zipf_phases "
+				  << FLAGS_zipf_phases;
+		}
 	}
 
 	if (FLAGS_stragglers_zipf_factor > 0) {
@@ -45,6 +45,10 @@ class Context : public star::Context {
 
         int crossPartitionProbability = 0; // out of 100
 	std::size_t accountsPerPartition = 10000000;
+
+        // hot-account skew, 0 hot accounts disables it
+        std::size_t hotAccountsPerPartition = 0;
+        int hotAccountProbability = 90; // out of 100
 };
 } // namespace smallbank
 } // namespace star
@@ -96,21 +96,25 @@ class Database {
 
 		auto partitioner = PartitionerFactory::create_partitioner(context.partitioner, coordinator_id, context.coordinator_num);
 
+		// accounts are dense per partition, so both tables are arrays indexed by the account ID
 		for (auto partitionID = 0u; partitionID < partitionNum; partitionID++) {
                         // savings table
 			auto savingsTableID = smallbank::savings::tableID;
 			if (context.protocol == "Sundial") {
 				tbl_savings_vec.push_back(
-					std::make_unique<TableHashMap<997, smallbank::savings::key, smallbank::savings::value, smallbank::savings::KeyComparator, smallbank::savings::ValueComparator, MetaInitFuncSundial> >(savingsTableID, partitionID));
+					std::make_unique<TableArray<smallbank::savings::key, smallbank::savings::value, smallbank::savings::KeyComparator, smallbank::savings::ValueComparator, MetaInitFuncSundial> >(savingsTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
                         } else if (context.protocol == "SundialPasha") {
                                 tbl_savings_vec.push_back(
-					std::make_unique<TableHashMap<997, smallbank::savings::key, smallbank::savings::value, smallbank::savings::KeyComparator, smallbank::savings::ValueComparator, MetaInitFuncSundialPasha> >(savingsTableID, partitionID));
+					std::make_unique<TableArray<smallbank::savings::key, smallbank::savings::value, smallbank::savings::KeyComparator, smallbank::savings::ValueComparator, MetaInitFuncSundialPasha> >(savingsTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
                         } else if (context.protocol == "TwoPL") {
                                 tbl_savings_vec.push_back(
-					std::make_unique<TableHashMap<997, smallbank::savings::key, smallbank::savings::value, smallbank::savings::KeyComparator, smallbank::savings::ValueComparator, MetaInitFuncTwoPL> >(savingsTableID, partitionID));
+					std::make_unique<TableArray<smallbank::savings::key, smallbank::savings::value, smallbank::savings::KeyComparator, smallbank::savings::ValueComparator, MetaInitFuncTwoPL> >(savingsTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
                         } else if (context.protocol == "TwoPLPasha") {
                                 tbl_savings_vec.push_back(
-					std::make_unique<TableHashMap<997, smallbank::savings::key, smallbank::savings::value, smallbank::savings::KeyComparator, smallbank::savings::ValueComparator, MetaInitFuncTwoPLPasha> >(savingsTableID, partitionID));
+					std::make_unique<TableArray<smallbank::savings::key, smallbank::savings::value, smallbank::savings::KeyComparator, smallbank::savings::ValueComparator, MetaInitFuncTwoPLPasha> >(savingsTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
+                        } else if (context.protocol == "SiloPasha") {
+                                tbl_savings_vec.push_back(
+					std::make_unique<TableArray<smallbank::savings::key, smallbank::savings::value, smallbank::savings::KeyComparator, smallbank::savings::ValueComparator, MetaInitFuncSiloPasha> >(savingsTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
 			} else if (context.protocol != "HStore") {
 				CHECK(0);
 			} else {
@@ -121,16 +125,19 @@ class Database {
 			auto checkingTableID = smallbank::checking::tableID;
 			if (context.protocol == "Sundial") {
 				tbl_checking_vec.push_back(
-					std::make_unique<TableHashMap<997, smallbank::checking::key, smallbank::checking::value, smallbank::checking::KeyComparator, smallbank::checking::ValueComparator, MetaInitFuncSundial> >(checkingTableID, partitionID));
+					std::make_unique<TableArray<smallbank::checking::key, smallbank::checking::value, smallbank::checking::KeyComparator, smallbank::checking::ValueComparator, MetaInitFuncSundial> >(checkingTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
                         } else if (context.protocol == "SundialPasha") {
                                 tbl_checking_vec.push_back(
-					std::make_unique<TableHashMap<997, smallbank::checking::key, smallbank::checking::value, smallbank::checking::KeyComparator, smallbank::checking::ValueComparator, MetaInitFuncSundialPasha> >(checkingTableID, partitionID));
+					std::make_unique<TableArray<smallbank::checking::key, smallbank::checking::value, smallbank::checking::KeyComparator, smallbank::checking::ValueComparator, MetaInitFuncSundialPasha> >(checkingTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
                         } else if (context.protocol == "TwoPL") {
                                 tbl_checking_vec.push_back(
-					std::make_unique<TableHashMap<997, smallbank::checking::key, smallbank::checking::value, smallbank::checking::KeyComparator, smallbank::checking::ValueComparator, MetaInitFuncTwoPL> >(checkingTableID, partitionID));
+					std::make_unique<TableArray<smallbank::checking::key, smallbank::checking::value, smallbank::checking::KeyComparator, smallbank::checking::ValueComparator, MetaInitFuncTwoPL> >(checkingTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
                         } else if (context.protocol == "TwoPLPasha") {
                                 tbl_checking_vec.push_back(
-					std::make_unique<TableHashMap<997, smallbank::checking::key, smallbank::checking::value, smallbank::checking::KeyComparator, smallbank::checking::ValueComparator, MetaInitFuncTwoPLPasha> >(checkingTableID, partitionID));
+					std::make_unique<TableArray<smallbank::checking::key, smallbank::checking::value, smallbank::checking::KeyComparator, smallbank::checking::ValueComparator, MetaInitFuncTwoPLPasha> >(checkingTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
+                        } else if (context.protocol == "SiloPasha") {
+                                tbl_checking_vec.push_back(
+					std::make_unique<TableArray<smallbank::checking::key, smallbank::checking::value, smallbank::checking::KeyComparator, smallbank::checking::ValueComparator, MetaInitFuncSiloPasha> >(checkingTableID, partitionID, partitionID * context.accountsPerPartition, context.accountsPerPartition));
 			} else if (context.protocol != "HStore") {
 				CHECK(0);
 			} else {
@@ -277,11 +284,13 @@ class Database {
                         CHECK(success == true);
                 }
 
-                // insert a max key that represents the upper bound (for next-key locking)
-                savings::key max_key(UINT64_MAX);
-                savings::value dummy_value;
-                bool success = table->insert(&max_key, &dummy_value);
-                CHECK(success == true);
+                // insert a max key that represents the upper bound (for next-key locking), the array table needs none
+                if (table->tableType() == ITable::BTREE) {
+                        savings::key max_key(UINT64_MAX);
+                        savings::value dummy_value;
+                        bool success = table->insert(&max_key, &dummy_value);
+                        CHECK(success == true);
+                }
 	}
 
         void checkingInit(const Context &context, std::size_t partitionID)
@@ -301,11 +310,13 @@ class Database {
                         CHECK(success == true);
                 }
 
-                // insert a max key that represents the upper bound (for next-key locking)
-                checking::key max_key(UINT64_MAX);
-                checking::value dummy_value;
-                bool success = table->insert(&max_key, &dummy_value);
-                CHECK(success == true);
+                // insert a max key that represents the upper bound (for next-key locking), the array table needs none
+                if (table->tableType() == ITable::BTREE) {
+                        checking::key max_key(UINT64_MAX);
+                        checking::value dummy_value;
+                        bool success = table->insert(&max_key, &dummy_value);
+                        CHECK(success == true);
+                }
 	}
 
     public:
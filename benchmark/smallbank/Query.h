@@ -14,6 +14,25 @@ namespace star
 namespace smallbank
 {
 
+// picks an account of a partition and returns its global ID;
+// with a hot set, hotAccountProbability% of the picks go to the first hotAccountsPerPartition accounts (as in H-Store's SmallBank)
+inline uint64_t random_account_id(const Context &context, uint32_t partitionID, Random &random)
+{
+        uint64_t account_id = 0;
+        if (context.hotAccountsPerPartition > 0) {
+                if (random.uniform_dist(1, 100) <= context.hotAccountProbability) {
+                        account_id = random.uniform_dist(0, context.hotAccountsPerPartition - 1);
+                } else {
+                        account_id = random.uniform_dist(context.hotAccountsPerPartition, context.accountsPerPartition - 1);
+                }
+        } else if (context.isUniform) {
+                account_id = random.uniform_dist(0, static_cast<uint64_t>(context.accountsPerPartition) - 1);
+        } else {
+                account_id = Zipf::zipfForPartition(partitionID).value(random);
+        }
+        return context.getGlobalAccountID(account_id, partitionID);
+}
+
 struct BalanceQuery {
 	uint64_t account_id;
 	bool cross_partition;
@@ -59,19 +78,8 @@ class makeBalanceQuery {
                 query.parts[0] = partitionID;
                 query.cross_partition = false;
 
-                uint64_t account_id = 0;
-
                 // generate an account ID in a partition
-                if (context.isUniform) {
-                        account_id = random.uniform_dist(0, static_cast<uint64_t>(context.accountsPerPartition) - 1);
-                } else {
-                        account_id = Zipf::globalZipf().value(random.next_double());
-                }
-
-                // get the global key based on the generated partition ID
-                account_id = context.getGlobalAccountID(account_id, query.parts[0]);
-
-                query.account_id = account_id;
+                query.account_id = random_account_id(context, query.parts[0], random);
 
 		return query;
 	}
@@ -123,19 +131,8 @@ class makeDepositCheckingQuery {
                 query.parts[0] = partitionID;
                 query.cross_partition = false;
 
-                uint64_t account_id = 0;
-
                 // generate an account ID in a partition
-                if (context.isUniform) {
-                        account_id = random.uniform_dist(0, static_cast<uint64_t>(context.accountsPerPartition) - 1);
-                } else {
-                        account_id = Zipf::globalZipf().value(random.next_double());
-                }
-
-                // get the global key based on the generated partition ID
-                account_id = context.getGlobalAccountID(account_id, query.parts[0]);
-
-                query.account_id = account_id;
+                query.account_id = random_account_id(context, query.parts[0], random);
 
                 // like Motor, 1.3
                 query.amount = 1.3;
@@ -190,19 +187,8 @@ class makeTransactSavingQuery {
                 query.parts[0] = partitionID;
                 query.cross_partition = false;
 
-                uint64_t account_id = 0;
-
                 // generate an account ID in a partition
-                if (context.isUniform) {
-                        account_id = random.uniform_dist(0, static_cast<uint64_t>(context.accountsPerPartition) - 1);
-                } else {
-                        account_id = Zipf::globalZipf().value(random.next_double());
-                }
-
-                // get the global key based on the generated partition ID
-                account_id = context.getGlobalAccountID(account_id, query.parts[0]);
-
-                query.account_id = account_id;
+                query.account_id = random_account_id(context, query.parts[0], random);
 
                 // like Motor, 20.20
                 query.amount = 20.20;
@@ -275,33 +261,11 @@ class makeAmalgamateQuery {
                         query.num_parts = 1;
                 }
 
-                uint64_t first_account_id = 0, second_account_id = 0;
-
                 // generate two distinct account IDs
-                if (context.isUniform) {
-                        first_account_id = random.uniform_dist(0, static_cast<uint64_t>(context.accountsPerPartition) - 1);
-                        first_account_id = context.getGlobalAccountID(first_account_id, query.parts[0]);
-                        while (true) {
-                                second_account_id = random.uniform_dist(0, static_cast<uint64_t>(context.accountsPerPartition) - 1);
-                                second_account_id = context.getGlobalAccountID(second_account_id, query.parts[1]);
-                                if (second_account_id != first_account_id) {
-                                        break;
-                                }
-                        }
-                } else {
-                        first_account_id = Zipf::globalZipf().value(random.next_double());
-                        first_account_id = context.getGlobalAccountID(first_account_id, query.parts[0]);
-                        while (true) {
-                                second_account_id = Zipf::globalZipf().value(random.next_double());
-                                second_account_id = context.getGlobalAccountID(second_account_id, query.parts[1]);
-                                if (second_account_id != first_account_id) {
-                                        break;
-                                }
-                        }
-                }
-
-                query.first_account_id = first_account_id;
-                query.second_account_id = second_account_id;
+                query.first_account_id = random_account_id(context, query.parts[0], random);
+                do {
+                        query.second_account_id = random_account_id(context, query.parts[1], random);
+                } while (query.second_account_id == query.first_account_id);
 
 		return query;
 	}
@@ -353,19 +317,8 @@ class makeWriteCheckQuery {
                 query.parts[0] = partitionID;
                 query.cross_partition = false;
 
-                uint64_t account_id = 0;
-
                 // generate an account ID in a partition
-                if (context.isUniform) {
-                        account_id = random.uniform_dist(0, static_cast<uint64_t>(context.accountsPerPartition) - 1);
-                } else {
-                        account_id = Zipf::globalZipf().value(random.next_double());
-                }
-
-                // get the global key based on the generated partition ID
-                account_id = context.getGlobalAccountID(account_id, query.parts[0]);
-
-                query.account_id = account_id;
+                query.account_id = random_account_id(context, query.parts[0], random);
 
                 // like Motor, 5.0
                 query.amount = 5.0;
@@ -439,33 +392,11 @@ class makeSendPaymentQuery {
                         query.num_parts = 1;
                 }
 
-                uint64_t first_account_id = 0, second_account_id = 0;
-
                 // generate two distinct account IDs
-                if (context.isUniform) {
-                        first_account_id = random.uniform_dist(0, static_cast<uint64_t>(context.accountsPerPartition) - 1);
-                        first_account_id = context.getGlobalAccountID(first_account_id, query.parts[0]);
-                        while (true) {
-                                second_account_id = random.uniform_dist(0, static_cast<uint64_t>(context.accountsPerPartition) - 1);
-                                second_account_id = context.getGlobalAccountID(second_account_id, query.parts[1]);
-                                if (second_account_id != first_account_id) {
-                                        break;
-                                }
-                        }
-                } else {
-                        first_account_id = Zipf::globalZipf().value(random.next_double());
-                        first_account_id = context.getGlobalAccountID(first_account_id, query.parts[0]);
-                        while (true) {
-                                second_account_id = Zipf::globalZipf().value(random.next_double());
-                                second_account_id = context.getGlobalAccountID(second_account_id, query.parts[1]);
-                                if (second_account_id != first_account_id) {
-                                        break;
-                                }
-                        }
-                }
-
-                query.first_account_id = first_account_id;
-                query.second_account_id = second_account_id;
+                query.first_account_id = random_account_id(context, query.parts[0], random);
+                do {
+                        query.second_account_id = random_account_id(context, query.parts[1], random);
+                } while (query.second_account_id == query.first_account_id);
 
                 // like Motor, 5.0
                 query.amount = 5.0;
@@ -474,5 +405,5 @@ class makeSendPaymentQuery {
 	}
 };
 
-} // namespace ycsb
+} // namespace smallbank
 } // namespace star
@@ -144,6 +144,16 @@ template <class Transaction> class Balance : public Transaction {
 		query = makeBalanceQuery()(context, partition_id, granule_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeBalanceQuery()(context, partition_id, granule_id, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -262,6 +272,16 @@ template <class Transaction> class DepositChecking : public Transaction {
 		query = makeDepositCheckingQuery()(context, partition_id, granule_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeDepositCheckingQuery()(context, partition_id, granule_id, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -378,6 +398,16 @@ template <class Transaction> class TransactSaving : public Transaction {
 		query = makeTransactSavingQuery()(context, partition_id, granule_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeTransactSavingQuery()(context, partition_id, granule_id, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -506,6 +536,16 @@ template <class Transaction> class Amalgamate : public Transaction {
 		query = makeAmalgamateQuery()(context, partition_id, granule_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeAmalgamateQuery()(context, partition_id, granule_id, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -628,6 +668,16 @@ template <class Transaction> class WriteCheck : public Transaction {
 		query = makeWriteCheckQuery()(context, partition_id, granule_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeWriteCheckQuery()(context, partition_id, granule_id, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -750,6 +800,16 @@ template <class Transaction> class SendPayment : public Transaction {
 		query = makeSendPaymentQuery()(context, partition_id, granule_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeSendPaymentQuery()(context, partition_id, granule_id, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -99,20 +99,23 @@ class Database {
 		auto partitioner = PartitionerFactory::create_partitioner(context.partitioner, coordinator_id, context.coordinator_num);
 
 		for (auto partitionID = 0u; partitionID < partitionNum; partitionID++) {
-                        // subscriber table
+                        // subscriber table, subscriber IDs are dense per partition so it is an array indexed by S_ID
 			auto subscriberTableID = tatp::subscriber::tableID;
 			if (context.protocol == "Sundial") {
 				tbl_subscriber_vec.push_back(
-					std::make_unique<TableHashMap<997, tatp::subscriber::key, tatp::subscriber::value, tatp::subscriber::KeyComparator, tatp::subscriber::ValueComparator, MetaInitFuncSundial> >(subscriberTableID, partitionID));
+					std::make_unique<TableArray<tatp::subscriber::key, tatp::subscriber::value, tatp::subscriber::KeyComparator, tatp::subscriber::ValueComparator, MetaInitFuncSundial> >(subscriberTableID, partitionID, partitionID * context.numSubScriberPerPartition, context.numSubScriberPerPartition));
                         } else if (context.protocol == "SundialPasha") {
                                 tbl_subscriber_vec.push_back(
-					std::make_unique<TableHashMap<997, tatp::subscriber::key, tatp::subscriber::value, tatp::subscriber::KeyComparator, tatp::subscriber::ValueComparator, MetaInitFuncSundialPasha> >(subscriberTableID, partitionID));
+					std::make_unique<TableArray<tatp::subscriber::key, tatp::subscriber::value, tatp::subscriber::KeyComparator, tatp::subscriber::ValueComparator, MetaInitFuncSundialPasha> >(subscriberTableID, partitionID, partitionID * context.numSubScriberPerPartition, context.numSubScriberPerPartition));
                         } else if (context.protocol == "TwoPL") {
                                 tbl_subscriber_vec.push_back(
-					std::make_unique<TableHashMap<997, tatp::subscriber::key, tatp::subscriber::value, tatp::subscriber::KeyComparator, tatp::subscriber::ValueComparator, MetaInitFuncTwoPL> >(subscriberTableID, partitionID));
+					std::make_unique<TableArray<tatp::subscriber::key, tatp::subscriber::value, tatp::subscriber::KeyComparator, tatp::subscriber::ValueComparator, MetaInitFuncTwoPL> >(subscriberTableID, partitionID, partitionID * context.numSubScriberPerPartition, context.numSubScriberPerPartition));
                         } else if (context.protocol == "TwoPLPasha") {
                                 tbl_subscriber_vec.push_back(
-					std::make_unique<TableHashMap<997, tatp::subscriber::key, tatp::subscriber::value, tatp::subscriber::KeyComparator, tatp::subscriber::ValueComparator, MetaInitFuncTwoPLPasha> >(subscriberTableID, partitionID));
+					std::make_unique<TableArray<tatp::subscriber::key, tatp::subscriber::value, tatp::subscriber::KeyComparator, tatp::subscriber::ValueComparator, MetaInitFuncTwoPLPasha> >(subscriberTableID, partitionID, partitionID * context.numSubScriberPerPartition, context.numSubScriberPerPartition));
+                        } else if (context.protocol == "SiloPasha") {
+                                tbl_subscriber_vec.push_back(
+					std::make_unique<TableArray<tatp::subscriber::key, tatp::subscriber::value, tatp::subscriber::KeyComparator, tatp::subscriber::ValueComparator, MetaInitFuncSiloPasha> >(subscriberTableID, partitionID, partitionID * context.numSubScriberPerPartition, context.numSubScriberPerPartition));
 			} else if (context.protocol != "HStore") {
 				CHECK(0);
 			} else {
@@ -133,6 +136,9 @@ class Database {
                         } else if (context.protocol == "TwoPLPasha") {
                                 tbl_sec_subscriber_vec.push_back(
 					std::make_unique<TableHashMap<997, tatp::sec_subscriber::key, tatp::sec_subscriber::value, tatp::sec_subscriber::KeyComparator, tatp::sec_subscriber::ValueComparator, MetaInitFuncTwoPLPasha> >(sec_subscriberTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+                                tbl_sec_subscriber_vec.push_back(
+					std::make_unique<TableHashMap<997, tatp::sec_subscriber::key, tatp::sec_subscriber::value, tatp::sec_subscriber::KeyComparator, tatp::sec_subscriber::ValueComparator, MetaInitFuncSiloPasha> >(sec_subscriberTableID, partitionID));
 			} else if (context.protocol != "HStore") {
 				CHECK(0);
 			} else {
@@ -153,6 +159,9 @@ class Database {
                         } else if (context.protocol == "TwoPLPasha") {
                                 tbl_access_info_vec.push_back(
 					std::make_unique<TableHashMap<997, tatp::access_info::key, tatp::access_info::value, tatp::access_info::KeyComparator, tatp::access_info::ValueComparator, MetaInitFuncTwoPLPasha> >(accessInfoTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+                                tbl_access_info_vec.push_back(
+					std::make_unique<TableHashMap<997, tatp::access_info::key, tatp::access_info::value, tatp::access_info::KeyComparator, tatp::access_info::ValueComparator, MetaInitFuncSiloPasha> >(accessInfoTableID, partitionID));
 			} else if (context.protocol != "HStore") {
 				CHECK(0);
 			} else {
@@ -340,11 +349,13 @@ class Database {
                         CHECK(success == true);
                 }
 
-                // insert a max key that represents the upper bound (for next-key locking)
-                subscriber::key max_key(UINT32_MAX);
-                subscriber::value dummy_value;
-                bool success = table->insert(&max_key, &dummy_value);
-                CHECK(success == true);
+                // insert a max key that represents the upper bound (for next-key locking), the array table needs none
+                if (table->tableType() == ITable::BTREE) {
+                        subscriber::key max_key(UINT32_MAX);
+                        subscriber::value dummy_value;
+                        bool success = table->insert(&max_key, &dummy_value);
+                        CHECK(success == true);
+                }
 	}
 
         void secSubscriberInit(const Context &context, std::size_t partitionID)
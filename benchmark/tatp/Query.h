@@ -14,6 +14,18 @@ namespace star
 namespace tatp
 {
 
+// picks a subscriber of a partition and returns its global ID
+inline uint32_t random_subscriber_id(const Context &context, uint32_t partitionID, Random &random)
+{
+        uint32_t subscriber_id = 0;
+        if (context.isUniform) {
+                subscriber_id = random.uniform_dist(0, static_cast<uint32_t>(context.numSubScriberPerPartition) - 1);
+        } else {
+                subscriber_id = Zipf::zipfForPartition(partitionID).value(random);
+        }
+        return context.getGlobalAccountID(subscriber_id, partitionID);
+}
+
 struct GetSubsciberDataQuery {
 	uint32_t S_ID;
 	bool cross_partition;
@@ -59,19 +71,8 @@ class makeGetSubsciberDataQuery {
                 query.parts[0] = partitionID;
                 query.cross_partition = false;
 
-                uint32_t subscriber_id = 0;
-
-                // generate an subscriber ID in a partition
-                if (context.isUniform) {
-                        subscriber_id = random.uniform_dist(0, static_cast<uint32_t>(context.numSubScriberPerPartition) - 1);
-                } else {
-                        subscriber_id = Zipf::globalZipf().value(random.next_double());
-                }
-
-                // get the global key based on the generated partition ID
-                subscriber_id = context.getGlobalAccountID(subscriber_id, query.parts[0]);
-
-                query.S_ID = subscriber_id;
+                // generate a subscriber ID in a partition
+                query.S_ID = random_subscriber_id(context, query.parts[0], random);
 
 		return query;
 	}
@@ -124,22 +125,123 @@ class makeGetAccessDataQuery {
                 query.parts[0] = partitionID;
                 query.cross_partition = false;
 
-                uint32_t subscriber_id = 0;
+                // generate a subscriber ID in a partition
+                query.S_ID = random_subscriber_id(context, query.parts[0], random);
 
-                // generate an subscriber ID in a partition
-                if (context.isUniform) {
-                        subscriber_id = random.uniform_dist(0, static_cast<uint32_t>(context.numSubScriberPerPartition) - 1);
-                } else {
-                        subscriber_id = Zipf::globalZipf().value(random.next_double());
-                }
+                // generate ai_type
+                query.AI_TYPE = random.uniform_dist(1, 4);
 
-                // get the global key based on the generated partition ID
-                subscriber_id = context.getGlobalAccountID(subscriber_id, query.parts[0]);
+		return query;
+	}
+};
 
-                query.S_ID = subscriber_id;
+struct UpdateSubscriberDataQuery {
+	uint32_t S_ID;
+        uint8_t BIT_1;
 
-                // generate ai_type
-                query.AI_TYPE = random.uniform_dist(1, 4);
+	bool cross_partition;
+	int parts[5];
+	int granules[5][10];
+	int part_granule_count[5];
+	int num_parts = 0;
+
+	int32_t get_part(int i)
+	{
+		DCHECK(i < num_parts);
+		return parts[i];
+	}
+
+	int32_t get_part_granule_count(int i)
+	{
+		return part_granule_count[i];
+	}
+
+	int32_t get_granule(int i, int j)
+	{
+		DCHECK(i < num_parts);
+		DCHECK(j < part_granule_count[i]);
+		return granules[i][j];
+	}
+
+	int number_of_parts()
+	{
+		return num_parts;
+	}
+};
+
+class makeUpdateSubscriberDataQuery {
+    public:
+	UpdateSubscriberDataQuery operator()(const Context &context, uint32_t partitionID, uint32_t granuleID, Random &random) const
+	{
+		UpdateSubscriberDataQuery query;
+		query.num_parts = 1;
+		query.part_granule_count[0] = 0;
+
+                // always pick the local partition
+                query.parts[0] = partitionID;
+                query.cross_partition = false;
+
+                // generate a subscriber ID in a partition
+                query.S_ID = random_subscriber_id(context, query.parts[0], random);
+
+                // generate the new bit
+                query.BIT_1 = random.uniform_dist(0, 1);
+
+		return query;
+	}
+};
+
+struct UpdateLocationQuery {
+	uint32_t S_ID;
+        uint32_t VLR_LOCATION;
+
+	bool cross_partition;
+	int parts[5];
+	int granules[5][10];
+	int part_granule_count[5];
+	int num_parts = 0;
+
+	int32_t get_part(int i)
+	{
+		DCHECK(i < num_parts);
+		return parts[i];
+	}
+
+	int32_t get_part_granule_count(int i)
+	{
+		return part_granule_count[i];
+	}
+
+	int32_t get_granule(int i, int j)
+	{
+		DCHECK(i < num_parts);
+		DCHECK(j < part_granule_count[i]);
+		return granules[i][j];
+	}
+
+	int number_of_parts()
+	{
+		return num_parts;
+	}
+};
+
+class makeUpdateLocationQuery {
+    public:
+	UpdateLocationQuery operator()(const Context &context, uint32_t partitionID, uint32_t granuleID, Random &random) const
+	{
+		UpdateLocationQuery query;
+		query.num_parts = 1;
+		query.part_granule_count[0] = 0;
+
+                // always pick the local partition
+                query.parts[0] = partitionID;
+                query.cross_partition = false;
+
+                // generate a subscriber ID in a partition
+                query.S_ID = random_subscriber_id(context, query.parts[0], random);
+
+                // generate the new location, the transaction finds the subscriber by its SUB_NBR
+                query.VLR_LOCATION = random.uniform_dist(0, UINT32_MAX);
 
 		return query;
 	}
@@ -43,7 +43,7 @@ DO_STRUCT(subscriber, SUBSCRIBER_KEY_FIELDS, SUBSCRIBER_VALUE_FIELDS, NAMESPACE_
 #define SEC_SUBSCRIBER_GET_PLAIN_KEY_FUNC               \
         uint64_t get_plain_key() const                  \
         {                                               \
-                return std::stoi(SUB_NBR.c_str());      \
+                return std::stoull(SUB_NBR.c_str());    \
         }
 
 DO_STRUCT(sec_subscriber, SEC_SUBSCRIBER_KEY_FIELDS, SEC_SUBSCRIBER_VALUE_FIELDS, NAMESPACE_FIELDS, SEC_SUBSCRIBER_GET_PLAIN_KEY_FUNC)
@@ -57,7 +57,7 @@ DO_STRUCT(sec_subscriber, SEC_SUBSCRIBER_KEY_FIELDS, SEC_SUBSCRIBER_VALUE_FIELDS
 #define ACCESS_INFO_GET_PLAIN_KEY_FUNC                  \
         uint64_t get_plain_key() const                  \
         {                                               \
-                return S_ID * UINT32_MAX + AI_TYPE;     \
+                return (static_cast<uint64_t>(S_ID) << 8) | AI_TYPE; \
         }
 
 DO_STRUCT(access_info, ACCESS_INFO_KEY_FIELDS, ACCESS_INFO_VALUE_FIELDS, NAMESPACE_FIELDS, ACCESS_INFO_GET_PLAIN_KEY_FUNC)
@@ -120,11 +120,11 @@ template <> class Deserializer<tatp::access_info::value> {
 	{
                 std::size_t data_1_sz = Deserializer<decltype(result.DATA_1)>()(str, result.DATA_1);
 		str.remove_prefix(data_1_sz);
-                std::size_t data_2_sz = Deserializer<decltype(result.DATA_1)>()(str, result.DATA_1);
+                std::size_t data_2_sz = Deserializer<decltype(result.DATA_2)>()(str, result.DATA_2);
 		str.remove_prefix(data_2_sz);
-                std::size_t data_3_sz = Deserializer<decltype(result.DATA_1)>()(str, result.DATA_1);
+                std::size_t data_3_sz = Deserializer<decltype(result.DATA_3)>()(str, result.DATA_3);
 		str.remove_prefix(data_3_sz);
-                std::size_t data_4_sz = Deserializer<decltype(result.DATA_1)>()(str, result.DATA_1);
+                std::size_t data_4_sz = Deserializer<decltype(result.DATA_4)>()(str, result.DATA_4);
 		str.remove_prefix(data_4_sz);
 
                 return data_1_sz + data_2_sz + data_3_sz + data_4_sz;
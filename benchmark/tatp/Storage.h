@@ -16,6 +16,9 @@ struct Storage {
 	subscriber::key subscriber_key;
 	subscriber::value subscriber_value;
 
+        sec_subscriber::key sec_subscriber_key;
+	sec_subscriber::value sec_subscriber_value;
+
         access_info::key access_info_key;
 	access_info::value access_info_value;
 
@@ -137,6 +137,16 @@ template <class Transaction> class GetSubsciberData : public Transaction {
 		query = makeGetSubsciberDataQuery()(context, partition_id, granule_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeGetSubsciberDataQuery()(context, partition_id, granule_id, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -234,7 +244,7 @@ template <class Transaction> class GetAccessData : public Transaction {
 
 		t_local_work.end();
 		if (this->process_requests(worker_id)) {
-			return TransactionResult::ABORT_NORETRY;
+			return TransactionResult::ABORT;
 		}
 		t_local_work.reset();
 
@@ -248,6 +258,16 @@ template <class Transaction> class GetAccessData : public Transaction {
 		query = makeGetAccessDataQuery()(context, partition_id, granule_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeGetAccessDataQuery()(context, partition_id, granule_id, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -257,6 +277,259 @@ template <class Transaction> class GetAccessData : public Transaction {
 	GetAccessDataQuery query;
 };
 
+template <class Transaction> class UpdateSubscriberData : public Transaction {
+    public:
+	using DatabaseType = Database;
+	using ContextType = typename DatabaseType::ContextType;
+	using RandomType = typename DatabaseType::RandomType;
+	using StorageType = Storage;
+
+	UpdateSubscriberData(std::size_t coordinator_id, std::size_t partition_id, std::size_t granule_id, DatabaseType &db, const ContextType &context,
+			RandomType &random, Partitioner &partitioner, std::size_t ith_replica = 0)
+		: Transaction(coordinator_id, partition_id, partitioner, ith_replica)
+		, db(db)
+		, context(context)
+		, random(random)
+		, partition_id(partition_id)
+		, granule_id(granule_id)
+		, query(makeUpdateSubscriberDataQuery()(context, partition_id, granule_id, random))
+	{
+		storage = get_storage();
+	}
+
+        virtual ~UpdateSubscriberData()
+	{
+		put_storage(storage);
+		storage = nullptr;
+	}
+
+	virtual int32_t get_partition_count() override
+	{
+		return query.number_of_parts();
+	}
+
+	virtual int32_t get_partition(int ith_partition) override
+	{
+		return query.get_part(ith_partition);
+	}
+
+	virtual int32_t get_partition_granule_count(int ith_partition) override
+	{
+		return query.get_part_granule_count(ith_partition);
+	}
+
+	virtual int32_t get_granule(int ith_partition, int j) override
+	{
+		return query.get_granule(ith_partition, j);
+	}
+
+	virtual bool is_single_partition() override
+	{
+		return query.cross_partition == false;
+	}
+
+	virtual const std::string serialize(std::size_t ith_replica = 0) override
+	{
+		std::string res;
+		Encoder encoder(res);
+		encoder << this->transaction_id << this->straggler_wait_time << ith_replica << this->txn_random_seed_start << partition_id << granule_id;
+		encoder << get_partition_count();
+		// int granules_count = 0;
+		// for (int32_t i = 0; i < get_partition_count(); ++i)
+		//   granules_count += get_partition_granule_count(i);
+		// for (int32_t i = 0; i < get_partition_count(); ++i)
+		//   encoder << get_partition(i);
+		// encoder << granules_count;
+		// for (int32_t i = 0; i < get_partition_count(); ++i)
+		//   for (int32_t j = 0; j < get_partition_granule_count(i); ++j)
+		//     encoder << get_granule(i, j);
+		Transaction::serialize_lock_status(encoder);
+		return res;
+	}
+
+	TransactionResult execute(std::size_t worker_id) override
+	{
+                storage->cleanup();
+		ScopedTimer t_local_work([&, this](uint64_t us) { this->record_local_work_time(us); });
+
+                uint32_t subscriber_id = query.S_ID;
+
+                CHECK(context.getPartitionID(subscriber_id) == query.get_part(0));
+
+                int subscriberTableID = subscriber::tableID;
+                storage->subscriber_key.S_ID = subscriber_id;
+                this->search_for_update(subscriberTableID, context.getPartitionID(subscriber_id), storage->subscriber_key, storage->subscriber_value, 0);
+                this->update(subscriberTableID, context.getPartitionID(subscriber_id), storage->subscriber_key, storage->subscriber_value, 0);
+
+		t_local_work.end();
+		if (this->process_requests(worker_id)) {
+			return TransactionResult::ABORT;
+		}
+		t_local_work.reset();
+
+                // there is no special_facility table, only the subscriber is updated
+                storage->subscriber_value.BITS.assign(std::to_string(query.BIT_1));
+
+		return TransactionResult::READY_TO_COMMIT;
+	}
+
+	void reset_query() override
+	{
+		query = makeUpdateSubscriberDataQuery()(context, partition_id, granule_id, random);
+	}
+
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeUpdateSubscriberDataQuery()(context, partition_id, granule_id, random);
+	}
+
+    private:
+	DatabaseType &db;
+	const ContextType &context;
+	RandomType random;
+	Storage *storage = nullptr;
+	std::size_t partition_id, granule_id;
+	UpdateSubscriberDataQuery query;
+};
+
+template <class Transaction> class UpdateLocation : public Transaction {
+    public:
+	using DatabaseType = Database;
+	using ContextType = typename DatabaseType::ContextType;
+	using RandomType = typename DatabaseType::RandomType;
+	using StorageType = Storage;
+
+	UpdateLocation(std::size_t coordinator_id, std::size_t partition_id, std::size_t granule_id, DatabaseType &db, const ContextType &context,
+			RandomType &random, Partitioner &partitioner, std::size_t ith_replica = 0)
+		: Transaction(coordinator_id, partition_id, partitioner, ith_replica)
+		, db(db)
+		, context(context)
+		, random(random)
+		, partition_id(partition_id)
+		, granule_id(granule_id)
+		, query(makeUpdateLocationQuery()(context, partition_id, granule_id, random))
+	{
+		storage = get_storage();
+	}
+
+        virtual ~UpdateLocation()
+	{
+		put_storage(storage);
+		storage = nullptr;
+	}
+
+	virtual int32_t get_partition_count() override
+	{
+		return query.number_of_parts();
+	}
+
+	virtual int32_t get_partition(int ith_partition) override
+	{
+		return query.get_part(ith_partition);
+	}
+
+	virtual int32_t get_partition_granule_count(int ith_partition) override
+	{
+		return query.get_part_granule_count(ith_partition);
+	}
+
+	virtual int32_t get_granule(int ith_partition, int j) override
+	{
+		return query.get_granule(ith_partition, j);
+	}
+
+	virtual bool is_single_partition() override
+	{
+		return query.cross_partition == false;
+	}
+
+	virtual const std::string serialize(std::size_t ith_replica = 0) override
+	{
+		std::string res;
+		Encoder encoder(res);
+		encoder << this->transaction_id << this->straggler_wait_time << ith_replica << this->txn_random_seed_start << partition_id << granule_id;
+		encoder << get_partition_count();
+		// int granules_count = 0;
+		// for (int32_t i = 0; i < get_partition_count(); ++i)
+		//   granules_count += get_partition_granule_count(i);
+		// for (int32_t i = 0; i < get_partition_count(); ++i)
+		//   encoder << get_partition(i);
+		// encoder << granules_count;
+		// for (int32_t i = 0; i < get_partition_count(); ++i)
+		//   for (int32_t j = 0; j < get_partition_granule_count(i); ++j)
+		//     encoder << get_granule(i, j);
+		Transaction::serialize_lock_status(encoder);
+		return res;
+	}
+
+	TransactionResult execute(std::size_t worker_id) override
+	{
+                storage->cleanup();
+		ScopedTimer t_local_work([&, this](uint64_t us) { this->record_local_work_time(us); });
+
+                uint32_t subscriber_id = query.S_ID;
+
+                CHECK(context.getPartitionID(subscriber_id) == query.get_part(0));
+
+                // find the subscriber by its SUB_NBR, the secondary index is never updated so it is read without locking
+                int secSubscriberTableID = sec_subscriber::tableID;
+                std::stringstream sub_nbr;
+                sub_nbr << std::setw(15) << std::setfill('0') << subscriber_id;
+                storage->sec_subscriber_key.SUB_NBR.assign(sub_nbr.str());
+                this->search_local_index(secSubscriberTableID, context.getPartitionID(subscriber_id), storage->sec_subscriber_key, storage->sec_subscriber_value, true);
+
+		t_local_work.end();
+		this->process_requests(worker_id, false);
+		t_local_work.reset();
+
+                subscriber_id = storage->sec_subscriber_value.S_ID;
+                DCHECK(subscriber_id == query.S_ID);
+
+                int subscriberTableID = subscriber::tableID;
+                storage->subscriber_key.S_ID = subscriber_id;
+                this->search_for_update(subscriberTableID, context.getPartitionID(subscriber_id), storage->subscriber_key, storage->subscriber_value, 0);
+                this->update(subscriberTableID, context.getPartitionID(subscriber_id), storage->subscriber_key, storage->subscriber_value, 0);
+
+		t_local_work.end();
+		if (this->process_requests(worker_id)) {
+			return TransactionResult::ABORT;
+		}
+		t_local_work.reset();
+
+                storage->subscriber_value.VLR_LOCATION = query.VLR_LOCATION;
+
+		return TransactionResult::READY_TO_COMMIT;
+	}
+
+	void reset_query() override
+	{
+		query = makeUpdateLocationQuery()(context, partition_id, granule_id, random);
+	}
+
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeUpdateLocationQuery()(context, partition_id, granule_id, random);
+	}
+
+    private:
+	DatabaseType &db;
+	const ContextType &context;
+	RandomType random;
+	Storage *storage = nullptr;
+	std::size_t partition_id, granule_id;
+	UpdateLocationQuery query;
+};
+
 } // namespace tatp
 
 } // namespace star
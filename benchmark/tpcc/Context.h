@@ -41,6 +41,9 @@ class Context : public star::Context {
 
 	int newOrderCrossPartitionProbability = 10; // out of 100
 	int paymentCrossPartitionProbability = 15; // out of 100
+
+	// remote Payment customers are also selected by last name, which needs the customer name index published in CXL
+	bool paymentRemoteByName = false;
 };
 } // namespace tpcc
 } // namespace star
@@ -161,6 +161,7 @@ class Database {
 		std::size_t coordinator_id = context.coordinator_id;
 		std::size_t partitionNum = context.partition_num;
 		std::size_t threadsNum = context.worker_num;
+		btree_fill_factor = context.btree_fill_factor;
 
 		auto partitioner = PartitionerFactory::create_partitioner(context.partitioner, coordinator_id, context.coordinator_num);
 
@@ -172,18 +173,21 @@ class Database {
 			auto warehouseTableID = warehouse::tableID;
 			if (context.protocol == "Sundial") {
 				tbl_warehouse_vec.push_back(
-					std::make_unique<TableBTreeOLC<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator, MetaInitFuncSundial> >(warehouseTableID, partitionID));
+					std::make_unique<TableArray<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator, MetaInitFuncSundial> >(warehouseTableID, partitionID, partitionID + 1, 1));
                         } else if (context.protocol == "SundialPasha") {
 				tbl_warehouse_vec.push_back(
-					std::make_unique<TableBTreeOLC<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator, MetaInitFuncSundialPasha> >(warehouseTableID, partitionID));
+					std::make_unique<TableArray<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator, MetaInitFuncSundialPasha> >(warehouseTableID, partitionID, partitionID + 1, 1));
                         } else if (context.protocol == "TwoPL") {
                                 tbl_warehouse_vec.push_back(
-					std::make_unique<TableBTreeOLC<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator, MetaInitFuncTwoPL> >(warehouseTableID, partitionID));
+					std::make_unique<TableArray<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator, MetaInitFuncTwoPL> >(warehouseTableID, partitionID, partitionID + 1, 1));
                         } else if (context.protocol == "TwoPLPasha") {
                                 tbl_warehouse_vec.push_back(
-					std::make_unique<TableBTreeOLC<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator, MetaInitFuncTwoPLPasha> >(warehouseTableID, partitionID));
+					std::make_unique<TableArray<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator, MetaInitFuncTwoPLPasha> >(warehouseTableID, partitionID, partitionID + 1, 1));
+                        } else if (context.protocol == "SiloPasha") {
+                                tbl_warehouse_vec.push_back(
+					std::make_unique<TableArray<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator, MetaInitFuncSiloPasha> >(warehouseTableID, partitionID, partitionID + 1, 1));
 			} else if (context.protocol != "HStore") {
-				tbl_warehouse_vec.push_back(std::make_unique<TableBTreeOLC<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator> >(warehouseTableID, partitionID));
+				tbl_warehouse_vec.push_back(std::make_unique<TableArray<warehouse::key, warehouse::value, warehouse::KeyComparator, warehouse::ValueComparator> >(warehouseTableID, partitionID, partitionID + 1, 1));
 			} else {
 				if (context.lotus_checkpoint == COW_ON_CHECKPOINT_OFF_LOGGING_ON ||
 				    context.lotus_checkpoint == COW_ON_CHECKPOINT_ON_LOGGING_OFF ||
@@ -199,18 +203,21 @@ class Database {
 			auto districtTableID = district::tableID;
 			if (context.protocol == "Sundial") {
 				tbl_district_vec.push_back(
-					std::make_unique<TableBTreeOLC<district::key, district::value, district::KeyComparator, district::ValueComparator, MetaInitFuncSundial> >(districtTableID, partitionID));
+					std::make_unique<TableArray<district::key, district::value, district::KeyComparator, district::ValueComparator, MetaInitFuncSundial> >(districtTableID, partitionID, (partitionID + 1) * (DISTRICT_PER_WAREHOUSE + 1) + 1, DISTRICT_PER_WAREHOUSE));
                         } else if (context.protocol == "SundialPasha") {
 				tbl_district_vec.push_back(
-					std::make_unique<TableBTreeOLC<district::key, district::value, district::KeyComparator, district::ValueComparator, MetaInitFuncSundialPasha> >(districtTableID, partitionID));
+					std::make_unique<TableArray<district::key, district::value, district::KeyComparator, district::ValueComparator, MetaInitFuncSundialPasha> >(districtTableID, partitionID, (partitionID + 1) * (DISTRICT_PER_WAREHOUSE + 1) + 1, DISTRICT_PER_WAREHOUSE));
 			} else if (context.protocol == "TwoPL") {
 				tbl_district_vec.push_back(
-					std::make_unique<TableBTreeOLC<district::key, district::value, district::KeyComparator, district::ValueComparator, MetaInitFuncTwoPL> >(districtTableID, partitionID));
+					std::make_unique<TableArray<district::key, district::value, district::KeyComparator, district::ValueComparator, MetaInitFuncTwoPL> >(districtTableID, partitionID, (partitionID + 1) * (DISTRICT_PER_WAREHOUSE + 1) + 1, DISTRICT_PER_WAREHOUSE));
                         } else if (context.protocol == "TwoPLPasha") {
 				tbl_district_vec.push_back(
-					std::make_unique<TableBTreeOLC<district::key, district::value, district::KeyComparator, district::ValueComparator, MetaInitFuncTwoPLPasha> >(districtTableID, partitionID));
+					std::make_unique<TableArray<district::key, district::value, district::KeyComparator, district::ValueComparator, MetaInitFuncTwoPLPasha> >(districtTableID, partitionID, (partitionID + 1) * (DISTRICT_PER_WAREHOUSE + 1) + 1, DISTRICT_PER_WAREHOUSE));
+                        } else if (context.protocol == "SiloPasha") {
+				tbl_district_vec.push_back(
+					std::make_unique<TableArray<district::key, district::value, district::KeyComparator, district::ValueComparator, MetaInitFuncSiloPasha> >(districtTableID, partitionID, (partitionID + 1) * (DISTRICT_PER_WAREHOUSE + 1) + 1, DISTRICT_PER_WAREHOUSE));
                         } else if (context.protocol != "HStore") {
-				tbl_district_vec.push_back(std::make_unique<TableBTreeOLC<district::key, district::value, district::KeyComparator, district::ValueComparator> >(districtTableID, partitionID));
+				tbl_district_vec.push_back(std::make_unique<TableArray<district::key, district::value, district::KeyComparator, district::ValueComparator> >(districtTableID, partitionID, (partitionID + 1) * (DISTRICT_PER_WAREHOUSE + 1) + 1, DISTRICT_PER_WAREHOUSE));
 			} else {
 				if (context.lotus_checkpoint == COW_ON_CHECKPOINT_OFF_LOGGING_ON ||
 				    context.lotus_checkpoint == COW_ON_CHECKPOINT_ON_LOGGING_OFF ||
@@ -236,6 +243,9 @@ class Database {
                         } else if (context.protocol == "TwoPLPasha") {
 				tbl_customer_vec.push_back(
 					std::make_unique<TableBTreeOLC<customer::key, customer::value, customer::KeyComparator, customer::ValueComparator, MetaInitFuncTwoPLPasha> >(customerTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+				tbl_customer_vec.push_back(
+					std::make_unique<TableBTreeOLC<customer::key, customer::value, customer::KeyComparator, customer::ValueComparator, MetaInitFuncSiloPasha> >(customerTableID, partitionID));
                         } else if (context.protocol != "HStore") {
 				std::make_unique<TableBTreeOLC<customer::key, customer::value, customer::KeyComparator, customer::ValueComparator> >(customerTableID, partitionID);
 			} else {
@@ -267,6 +277,10 @@ class Database {
 				tbl_customer_name_idx_vec.push_back(
 					std::make_unique<TableHashMap<997, customer_name_idx::key, customer_name_idx::value, customer_name_idx::KeyComparator, customer_name_idx::ValueComparator, MetaInitFuncTwoPLPasha> >(
 						customerNameIdxTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+				tbl_customer_name_idx_vec.push_back(
+					std::make_unique<TableHashMap<997, customer_name_idx::key, customer_name_idx::value, customer_name_idx::KeyComparator, customer_name_idx::ValueComparator, MetaInitFuncSiloPasha> >(
+						customerNameIdxTableID, partitionID));
 			} else {
 				tbl_customer_name_idx_vec.push_back(
 					std::make_unique<TableHashMap<997, customer_name_idx::key, customer_name_idx::value, customer_name_idx::KeyComparator, customer_name_idx::ValueComparator> >(customerNameIdxTableID, partitionID));
@@ -285,6 +299,9 @@ class Database {
                         } else if (context.protocol == "TwoPLPasha") {
 				tbl_history_vec.push_back(
 					std::make_unique<TableBTreeOLC<history::key, history::value, history::KeyComparator, history::ValueComparator, MetaInitFuncTwoPLPasha> >(historyTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+				tbl_history_vec.push_back(
+					std::make_unique<TableBTreeOLC<history::key, history::value, history::KeyComparator, history::ValueComparator, MetaInitFuncSiloPasha> >(historyTableID, partitionID));
                         } else if (context.protocol != "HStore") {
 				tbl_history_vec.push_back(
 					std::make_unique<TableBTreeOLC<history::key, history::value, history::KeyComparator, history::ValueComparator> >(historyTableID, partitionID));
@@ -312,6 +329,9 @@ class Database {
                         } else if (context.protocol == "TwoPLPasha") {
 				tbl_new_order_vec.push_back(
 					std::make_unique<TableBTreeOLC<new_order::key, new_order::value, new_order::KeyComparator, new_order::ValueComparator, MetaInitFuncTwoPLPasha> >(newOrderTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+				tbl_new_order_vec.push_back(
+					std::make_unique<TableBTreeOLC<new_order::key, new_order::value, new_order::KeyComparator, new_order::ValueComparator, MetaInitFuncSiloPasha> >(newOrderTableID, partitionID));
                         } else if (context.protocol != "HStore") {
 				tbl_new_order_vec.push_back(
 					std::make_unique<TableBTreeOLC<new_order::key, new_order::value, new_order::KeyComparator, new_order::ValueComparator> >(newOrderTableID, partitionID));
@@ -340,6 +360,9 @@ class Database {
                         } else if (context.protocol == "TwoPLPasha") {
 				tbl_order_vec.push_back(
 					std::make_unique<TableBTreeOLC<order::key, order::value, order::KeyComparator, order::ValueComparator, MetaInitFuncTwoPLPasha> >(orderTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+				tbl_order_vec.push_back(
+					std::make_unique<TableBTreeOLC<order::key, order::value, order::KeyComparator, order::ValueComparator, MetaInitFuncSiloPasha> >(orderTableID, partitionID));
                         } else if (context.protocol != "HStore") {
 				tbl_order_vec.push_back(
 					std::make_unique<TableBTreeOLC<order::key, order::value, order::KeyComparator, order::ValueComparator> >(orderTableID, partitionID));
@@ -366,6 +389,9 @@ class Database {
 			} else if (context.protocol == "TwoPLPasha") {
 				tbl_order_cust_vec.push_back(
 					std::make_unique<TableBTreeOLC<order_customer::key, order_customer::value, order_customer::KeyComparator, order_customer::ValueComparator, MetaInitFuncTwoPLPasha> >(orderCustTableID, partitionID));
+			} else if (context.protocol == "SiloPasha") {
+				tbl_order_cust_vec.push_back(
+					std::make_unique<TableBTreeOLC<order_customer::key, order_customer::value, order_customer::KeyComparator, order_customer::ValueComparator, MetaInitFuncSiloPasha> >(orderCustTableID, partitionID));
                         } else if (context.protocol != "HStore") {
 				tbl_order_cust_vec.push_back(
 					std::make_unique<TableBTreeOLC<order_customer::key, order_customer::value, order_customer::KeyComparator, order_customer::ValueComparator> >(orderCustTableID, partitionID));
@@ -392,6 +418,9 @@ class Database {
                         } else if (context.protocol == "TwoPLPasha") {
 				tbl_order_line_vec.push_back(
 					std::make_unique<TableBTreeOLC<order_line::key, order_line::value, order_line::KeyComparator, order_line::ValueComparator, MetaInitFuncTwoPLPasha> >(orderLineTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+				tbl_order_line_vec.push_back(
+					std::make_unique<TableBTreeOLC<order_line::key, order_line::value, order_line::KeyComparator, order_line::ValueComparator, MetaInitFuncSiloPasha> >(orderLineTableID, partitionID));
                         } else if (context.protocol != "HStore") {
 				tbl_order_line_vec.push_back(
 					std::make_unique<TableBTreeOLC<order_line::key, order_line::value, order_line::KeyComparator, order_line::ValueComparator> >(orderLineTableID, partitionID));
@@ -420,6 +449,9 @@ class Database {
                         } else if (context.protocol == "TwoPLPasha") {
 				tbl_stock_vec.push_back(
 					std::make_unique<TableBTreeOLC<stock::key, stock::value, stock::KeyComparator, stock::ValueComparator, MetaInitFuncTwoPLPasha> >(stockTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+				tbl_stock_vec.push_back(
+					std::make_unique<TableBTreeOLC<stock::key, stock::value, stock::KeyComparator, stock::ValueComparator, MetaInitFuncSiloPasha> >(stockTableID, partitionID));
                         } else if (context.protocol != "HStore") {
 				tbl_stock_vec.push_back(std::make_unique<TableBTreeOLC<stock::key, stock::value, stock::KeyComparator, stock::ValueComparator> >(stockTableID, partitionID));
 			} else {
@@ -435,15 +467,17 @@ class Database {
 
 		auto itemTableID = item::tableID;
 		if (context.protocol == "Sundial") {
-			tbl_item_vec.push_back(std::make_unique<TableBTreeOLC<item::key, item::value, item::KeyComparator, item::ValueComparator, MetaInitFuncSundial> >(itemTableID, 0));
+			tbl_item_vec.push_back(std::make_unique<TableArray<item::key, item::value, item::KeyComparator, item::ValueComparator, MetaInitFuncSundial> >(itemTableID, 0, 1, ITEM_NUM));
                 } else if (context.protocol == "SundialPasha") {
-			tbl_item_vec.push_back(std::make_unique<TableBTreeOLC<item::key, item::value, item::KeyComparator, item::ValueComparator, MetaInitFuncSundialPasha> >(itemTableID, 0));
+			tbl_item_vec.push_back(std::make_unique<TableArray<item::key, item::value, item::KeyComparator, item::ValueComparator, MetaInitFuncSundialPasha> >(itemTableID, 0, 1, ITEM_NUM));
                 } else if (context.protocol == "TwoPL") {
-			tbl_item_vec.push_back(std::make_unique<TableBTreeOLC<item::key, item::value, item::KeyComparator, item::ValueComparator, MetaInitFuncTwoPL> >(itemTableID, 0));
+			tbl_item_vec.push_back(std::make_unique<TableArray<item::key, item::value, item::KeyComparator, item::ValueComparator, MetaInitFuncTwoPL> >(itemTableID, 0, 1, ITEM_NUM));
                 } else if (context.protocol == "TwoPLPasha") {
-			tbl_item_vec.push_back(std::make_unique<TableBTreeOLC<item::key, item::value, item::KeyComparator, item::ValueComparator, MetaInitFuncTwoPLPasha> >(itemTableID, 0));
+			tbl_item_vec.push_back(std::make_unique<TableArray<item::key, item::value, item::KeyComparator, item::ValueComparator, MetaInitFuncTwoPLPasha> >(itemTableID, 0, 1, ITEM_NUM));
+                } else if (context.protocol == "SiloPasha") {
+			tbl_item_vec.push_back(std::make_unique<TableArray<item::key, item::value, item::KeyComparator, item::ValueComparator, MetaInitFuncSiloPasha> >(itemTableID, 0, 1, ITEM_NUM));
 		} else if (context.protocol != "HStore") {
-			tbl_item_vec.push_back(std::make_unique<TableBTreeOLC<item::key, item::value, item::KeyComparator, item::ValueComparator> >(itemTableID, 0));
+			tbl_item_vec.push_back(std::make_unique<TableArray<item::key, item::value, item::KeyComparator, item::ValueComparator> >(itemTableID, 0, 1, ITEM_NUM));
 		} else {
 			if (context.lotus_checkpoint == COW_ON_CHECKPOINT_OFF_LOGGING_ON || context.lotus_checkpoint == COW_ON_CHECKPOINT_ON_LOGGING_OFF ||
 			    context.lotus_checkpoint == COW_ON_CHECKPOINT_ON_LOGGING_ON) {
@@ -932,25 +966,27 @@ class Database {
 
                         auto customerTableID = customer::tableID;
                         cxl_tbl_vecs[customerTableID].resize(partitionNum);
-                        auto customer_cxl_btreetables = reinterpret_cast<CXLTableBTreeOLC<customer::key, customer::KeyComparator>::CXLBTree *>(cxl_memory.cxlalloc_malloc_wrapper(
-                                        sizeof(CXLTableBTreeOLC<customer::key, customer::KeyComparator>::CXLBTree) * partitionNum, CXLMemory::INDEX_ALLOCATION));
+                        // the plain keys fit the 32-bit prefixes of the compact node format
+                        auto customer_cxl_btreetables = reinterpret_cast<CXLTableBTreeOLC<customer::key, customer::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree *>(cxl_memory.cxlalloc_malloc_wrapper(
+                                        sizeof(CXLTableBTreeOLC<customer::key, customer::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree) * partitionNum, CXLMemory::INDEX_ALLOCATION));
                         for (int i = 0; i < partitionNum; i++) {
                                 auto cxl_table = &customer_cxl_btreetables[i];
-                                new(cxl_table) CXLTableBTreeOLC<customer::key, customer::KeyComparator>::CXLBTree();
+                                new(cxl_table) CXLTableBTreeOLC<customer::key, customer::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree();
                                 cxl_table_ptrs[customerTableID * partitionNum + i] = reinterpret_cast<void *>(cxl_table);
-                                cxl_tbl_vecs[customerTableID][i] = new CXLTableBTreeOLC<customer::key, customer::KeyComparator>(cxl_table, customerTableID, i);
+                                cxl_tbl_vecs[customerTableID][i] = new CXLTableBTreeOLC<customer::key, customer::KeyComparator, CXLBTreeNodeFormat::Compact>(cxl_table, customerTableID, i);
                         }
 
-                        // auto customerNameIdxTableID = customer_name_idx::tableID;
-                        // cxl_tbl_vecs[customerNameIdxTableID].resize(partitionNum);
-                        // CCHashTable *customer_name_idx_cxl_hashtables = reinterpret_cast<CCHashTable *>(cxl_memory.cxlalloc_malloc_wrapper(
-                        //                 sizeof(CCHashTable) * partitionNum, CXLMemory::INDEX_ALLOCATION));
-                        // for (int i = 0; i < partitionNum; i++) {
-                        //         CCHashTable *cxl_table = &customer_name_idx_cxl_hashtables[i];
-                        //         new(cxl_table) CCHashTable(cxl_hashtable_bkt_cnt);
-                        //         cxl_table_ptrs[customerNameIdxTableID * partitionNum + i] = reinterpret_cast<void *>(cxl_table);
-                        //         cxl_tbl_vecs[customerNameIdxTableID][i] = new CXLTableHashMap<customer_name_idx::key>(cxl_table, customerNameIdxTableID, i);
-                        // }
+                        // the customer name index is not migrated row by row, every host publishes it for its partitions
+                        auto customerNameIdxTableID = customer_name_idx::tableID;
+                        cxl_customer_name_idx_vec.resize(partitionNum);
+                        CCHashTable *customer_name_idx_cxl_hashtables = reinterpret_cast<CCHashTable *>(cxl_memory.cxlalloc_malloc_wrapper(
+                                        sizeof(CCHashTable) * partitionNum, CXLMemory::INDEX_ALLOCATION));
+                        for (int i = 0; i < partitionNum; i++) {
+                                CCHashTable *cxl_table = &customer_name_idx_cxl_hashtables[i];
+                                new(cxl_table) CCHashTable(cxl_name_idx_bkt_cnt);
+                                cxl_table_ptrs[customerNameIdxTableID * partitionNum + i] = reinterpret_cast<void *>(cxl_table);
+                                cxl_customer_name_idx_vec[i] = new CXLTableSharedIndex<customer_name_idx::key, customer_name_idx::value>(cxl_table, customerNameIdxTableID, i);
+                        }
 
                         // auto historyTableID = history::tableID;
                         // cxl_tbl_vecs[historyTableID].resize(partitionNum);
@@ -1020,13 +1056,14 @@ class Database {
 
                         auto stockTableID = stock::tableID;
                         cxl_tbl_vecs[stockTableID].resize(partitionNum);
-                        auto stock_cxl_btreetables = reinterpret_cast<CXLTableBTreeOLC<stock::key, stock::KeyComparator>::CXLBTree *>(cxl_memory.cxlalloc_malloc_wrapper(
-                                        sizeof(CXLTableBTreeOLC<stock::key, stock::KeyComparator>::CXLBTree) * partitionNum, CXLMemory::INDEX_ALLOCATION));
+                        // the plain keys fit the 32-bit prefixes of the compact node format
+                        auto stock_cxl_btreetables = reinterpret_cast<CXLTableBTreeOLC<stock::key, stock::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree *>(cxl_memory.cxlalloc_malloc_wrapper(
+                                        sizeof(CXLTableBTreeOLC<stock::key, stock::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree) * partitionNum, CXLMemory::INDEX_ALLOCATION));
                         for (int i = 0; i < partitionNum; i++) {
                                 auto cxl_table = &stock_cxl_btreetables[i];
-                                new(cxl_table) CXLTableBTreeOLC<stock::key, stock::KeyComparator>::CXLBTree();
+                                new(cxl_table) CXLTableBTreeOLC<stock::key, stock::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree();
                                 cxl_table_ptrs[stockTableID * partitionNum + i] = reinterpret_cast<void *>(cxl_table);
-                                cxl_tbl_vecs[stockTableID][i] = new CXLTableBTreeOLC<stock::key, stock::KeyComparator>(cxl_table, stockTableID, i);
+                                cxl_tbl_vecs[stockTableID][i] = new CXLTableBTreeOLC<stock::key, stock::KeyComparator, CXLBTreeNodeFormat::Compact>(cxl_table, stockTableID, i);
                         }
 
                         CXLMemory::commit_shared_data_initialization(CXLMemory::cxl_data_migration_root_index, cxl_table_ptrs);
@@ -1054,16 +1091,16 @@ class Database {
                         auto customerTableID = customer::tableID;
                         cxl_tbl_vecs[customerTableID].resize(partitionNum);
                         for (int i = 0; i < partitionNum; i++) {
-                                auto cxl_table = reinterpret_cast<CXLTableBTreeOLC<customer::key, customer::KeyComparator>::CXLBTree *>(cxl_table_ptrs[customerTableID * partitionNum + i].get());
-                                cxl_tbl_vecs[customerTableID][i] = new CXLTableBTreeOLC<customer::key, customer::KeyComparator>(cxl_table, customerTableID, i);
+                                auto cxl_table = reinterpret_cast<CXLTableBTreeOLC<customer::key, customer::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree *>(cxl_table_ptrs[customerTableID * partitionNum + i].get());
+                                cxl_tbl_vecs[customerTableID][i] = new CXLTableBTreeOLC<customer::key, customer::KeyComparator, CXLBTreeNodeFormat::Compact>(cxl_table, customerTableID, i);
                         }
 
-                        // auto customerNameIdxTableID = customer_name_idx::tableID;
-                        // cxl_tbl_vecs[customerNameIdxTableID].resize(partitionNum);
-                        // for (int i = 0; i < partitionNum; i++) {
-                        //         CCHashTable *cxl_table = reinterpret_cast<CCHashTable *>(cxl_table_ptrs[customerNameIdxTableID * partitionNum + i].get());
-                        //         cxl_tbl_vecs[customerNameIdxTableID][i] = new CXLTableHashMap<customer_name_idx::key>(cxl_table, customerNameIdxTableID, i);
-                        // }
+                        auto customerNameIdxTableID = customer_name_idx::tableID;
+                        cxl_customer_name_idx_vec.resize(partitionNum);
+                        for (int i = 0; i < partitionNum; i++) {
+                                CCHashTable *cxl_table = reinterpret_cast<CCHashTable *>(cxl_table_ptrs[customerNameIdxTableID * partitionNum + i].get());
+                                cxl_customer_name_idx_vec[i] = new CXLTableSharedIndex<customer_name_idx::key, customer_name_idx::value>(cxl_table, customerNameIdxTableID, i);
+                        }
 
                         // auto historyTableID = history::tableID;
                         // cxl_tbl_vecs[historyTableID].resize(partitionNum);
@@ -1111,16 +1148,37 @@ class Database {
                         auto stockTableID = stock::tableID;
                         cxl_tbl_vecs[stockTableID].resize(partitionNum);
                         for (int i = 0; i < partitionNum; i++) {
-                                auto cxl_table = reinterpret_cast<CXLTableBTreeOLC<stock::key, stock::KeyComparator>::CXLBTree *>(cxl_table_ptrs[stockTableID * partitionNum + i].get());
-                                cxl_tbl_vecs[stockTableID][i] = new CXLTableBTreeOLC<stock::key, stock::KeyComparator>(cxl_table, stockTableID, i);
+                                auto cxl_table = reinterpret_cast<CXLTableBTreeOLC<stock::key, stock::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree *>(cxl_table_ptrs[stockTableID * partitionNum + i].get());
+                                cxl_tbl_vecs[stockTableID][i] = new CXLTableBTreeOLC<stock::key, stock::KeyComparator, CXLBTreeNodeFormat::Compact>(cxl_table, stockTableID, i);
                         }
 
                         LOG(INFO) << "TPCC retrieves data migration metadata";
                 }
 
+                publish_customer_name_idx(context);
+
                 return cxl_tbl_vecs;
         }
 
+        // the name index never changes after loading, so readers on other hosts need no concurrency control
+        void publish_customer_name_idx(const Context &context)
+        {
+                auto partitioner = PartitionerFactory::create_partitioner(context.partitioner, context.coordinator_id, context.coordinator_num);
+
+                for (auto i = 0u; i < tbl_customer_name_idx_vec.size(); i++) {
+                        if (partitioner->has_master_partition(i)) {
+                                auto publish = [&](ITable *table, const void *key, std::tuple<MetaDataType *, void *> &row, bool) -> bool {
+                                        bool ret = cxl_customer_name_idx_vec[i]->insert(key, std::get<1>(row));
+                                        CHECK(ret == true);
+                                        return true;
+                                };
+                                tbl_customer_name_idx_vec[i]->move_all_into_cxl(publish);
+                        }
+                        tbl_customer_name_idx_vec[i]->set_shared_index(cxl_customer_name_idx_vec[i]);
+                }
+                LOG(INFO) << "TPCC publishes the customer name index";
+        }
+
         void move_all_tables_into_cxl(std::function<migration_result(ITable *, const void *, std::tuple<MetaDataType *, void *> &, bool)> move_in_func)
         {
                 // disabled for now
@@ -1170,6 +1228,7 @@ class Database {
 
 		// For each row in the WAREHOUSE table, 10 rows in the DISTRICT table
 
+		table->bulk_load_begin(btree_fill_factor);
 		for (int i = 1; i <= DISTRICT_PER_WAREHOUSE; i++) {
 			district::key key;
 			key.D_W_ID = partitionID + 1;
@@ -1186,9 +1245,10 @@ class Database {
 			value.D_YTD = 3000;
 			value.D_NEXT_O_ID = 3001;
 
-			bool success = table->insert(&key, &value);
+			bool success = table->bulk_load_append(&key, &value);
                         CHECK(success == true);
 		}
+		table->bulk_load_end();
 	}
 
 	void customerInit(std::size_t partitionID)
@@ -1199,6 +1259,7 @@ class Database {
 		// For each row in the WAREHOUSE table, 10 rows in the DISTRICT table
 		// For each row in the DISTRICT table, 3,000 rows in the CUSTOMER table
 
+		table->bulk_load_begin(btree_fill_factor);
 		for (int i = 1; i <= DISTRICT_PER_WAREHOUSE; i++) {
 			for (int j = 1; j <= CUSTOMER_PER_DISTRICT; j++) {
 				customer::key key;
@@ -1244,10 +1305,11 @@ class Database {
 					value.C_CREDIT.assign("GC");
 				}
 
-				bool success = table->insert(&key, &value);
+				bool success = table->bulk_load_append(&key, &value);
                                 CHECK(success == true);
 			}
 		}
+		table->bulk_load_end();
 	}
 
 	void customerNameIdxInit(std::size_t partitionID)
@@ -1340,6 +1402,7 @@ class Database {
 		// For each row in the ORDER table from 2101 to 3000, 1 row in the NEW_ORDER
 		// table
 
+		table->bulk_load_begin(btree_fill_factor);
 		for (int i = 1; i <= DISTRICT_PER_WAREHOUSE; i++) {
 			for (int j = 2101; j <= 3000; j++) {
 				new_order::key key;
@@ -1349,10 +1412,11 @@ class Database {
 
 				new_order::value value;
 
-				bool success = table->insert(&key, &value);
+				bool success = table->bulk_load_append(&key, &value);
                                 CHECK(success == true);
 			}
 		}
+		table->bulk_load_end();
 
                 // test correctness
                 for (int i = 1; i <= DISTRICT_PER_WAREHOUSE; i++) {
@@ -1406,6 +1470,7 @@ class Database {
 			perm.push_back(i);
 		}
 
+		table->bulk_load_begin(btree_fill_factor);
 		for (int i = 1; i <= DISTRICT_PER_WAREHOUSE; i++) {
 			std::shuffle(perm.begin(), perm.end(), std::default_random_engine());
 
@@ -1427,10 +1492,11 @@ class Database {
 					value.O_CARRIER_ID = 0;
 				}
 
-				bool success = table->insert(&key, &value);
+				bool success = table->bulk_load_append(&key, &value);
                                 CHECK(success == true);
 			}
 		}
+		table->bulk_load_end();
 
                 // insert a max key that represents the upper bound (for next-key locking)
                 order::key max_key;
@@ -1521,6 +1587,7 @@ class Database {
 
 		ITable *order_table = find_table(order::tableID, partitionID);
 
+		table->bulk_load_begin(btree_fill_factor);
 		for (int i = 1; i <= DISTRICT_PER_WAREHOUSE; i++) {
 			order::key order_key;
 			order_key.O_W_ID = partitionID + 1;
@@ -1553,11 +1620,12 @@ class Database {
 						value.OL_DELIVERY_D = 0;
 						value.OL_AMOUNT = static_cast<float>(random.uniform_dist(1, 999999)) / 100;
 					}
-					bool success = table->insert(&key, &value);
+					bool success = table->bulk_load_append(&key, &value);
                                         CHECK(success == true);
 				}
 			}
 		}
+		table->bulk_load_end();
 
                 // insert a max key that represents the upper bound (for next-key locking)
                 order_line::key max_key;
@@ -1604,6 +1672,7 @@ class Database {
 
 		// 100,000 rows in the ITEM table
 
+		table->bulk_load_begin(btree_fill_factor);
 		for (int i = 1; i <= ITEM_NUM; i++) {
 			item::key key;
 			key.I_ID = i;
@@ -1630,16 +1699,19 @@ class Database {
 
 			value.I_DATA.assign(i_data);
 
-			bool success = table->insert(&key, &value);
+			bool success = table->bulk_load_append(&key, &value);
                         CHECK(success == true);
 		}
-
-                // insert a max key that represents the upper bound (for next-key locking)
-                item::key max_key;
-                item::value dummy_value;
-                max_key.I_ID = INT32_MAX;
-                bool success = table->insert(&max_key, &dummy_value);
-                CHECK(success == true);
+		table->bulk_load_end();
+
+                // insert a max key that represents the upper bound (for next-key locking), the array table needs none
+                if (table->tableType() == ITable::BTREE) {
+                        item::key max_key;
+                        item::value dummy_value;
+                        max_key.I_ID = INT32_MAX;
+                        bool success = table->insert(&max_key, &dummy_value);
+                        CHECK(success == true);
+                }
 	}
 
 	void stockInit(std::size_t partitionID)
@@ -1651,6 +1723,7 @@ class Database {
 
 		// For each row in the WAREHOUSE table, 100,000 rows in the STOCK table
 
+		table->bulk_load_begin(btree_fill_factor);
 		for (int i = 1; i <= STOCK_PER_WAREHOUSE; i++) {
 			stock::key key;
 			key.S_W_ID = partitionID + 1; // partition_id from 0, W_ID from 1
@@ -1690,9 +1763,10 @@ class Database {
 
 			value.S_DATA.assign(s_data);
 
-			bool success = table->insert(&key, &value);
+			bool success = table->bulk_load_append(&key, &value);
                         CHECK(success == true);
 		}
+		table->bulk_load_end();
 	}
 
     public:
@@ -1701,10 +1775,14 @@ class Database {
 
     private:
         static constexpr uint64_t cxl_hashtable_bkt_cnt = 50000;
+        static constexpr uint64_t cxl_name_idx_bkt_cnt = 16384;
 
 	std::vector<ThreadPool *> threadpools;
 	WALLogger *checkpoint_file_writer = nullptr;
 
+	// tables whose rows are generated in key order are bulk loaded with this fill factor
+	double btree_fill_factor = 1.0;
+
 	std::vector<std::vector<ITable *> > tbl_vecs;
 
 	std::vector<std::unique_ptr<ITable> > tbl_warehouse_vec;
@@ -1720,6 +1798,7 @@ class Database {
 	std::vector<std::unique_ptr<ITable> > tbl_stock_vec;
 
         std::vector<std::vector<CXLTableBase *> > cxl_tbl_vecs;
+        std::vector<CXLTableBase *> cxl_customer_name_idx_vec;
 };
 } // namespace tpcc
 } // namespace star
@@ -303,8 +303,15 @@ class makePaymentQuery {
 			query.C_D_ID = random.uniform_dist(1, 10);
 			query.granules[1][query.part_granule_count[1]++] = did_to_granule_id(query.C_D_ID, context);
 
-                        // always use C_ID for remote transactions
-                        query.C_ID = random.non_uniform_distribution(1023, 1, 3000);
+                        // use C_ID for remote transactions, unless the name index of the remote partition can be read in CXL;
+                        // only then is the by-name choice drawn, so the random stream is otherwise unchanged
+                        if (context.paymentRemoteByName && random.uniform_dist(1, 100) <= 60) {
+                                std::string last_name = random.rand_last_name(random.non_uniform_distribution(255, 0, 999));
+                                query.C_LAST.assign(last_name);
+                                query.C_ID = 0;
+                        } else {
+                                query.C_ID = random.non_uniform_distribution(1023, 1, 3000);
+                        }
 		} else {
 			// If x > 15 a customer is selected from the selected district number
 			// (C_D_ID = D_ID) and the home warehouse number (C_W_ID = W_ID).
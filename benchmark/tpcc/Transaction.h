@@ -351,6 +351,15 @@ template <class Transaction> class NewOrder : public Transaction {
 		query = makeNewOrderQuery()(context, partition_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		query = makeNewOrderQuery()(context, partition_id + 1, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -583,6 +592,15 @@ template <class Transaction> class Payment : public Transaction {
 		query = makePaymentQuery()(context, partition_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		query = makePaymentQuery()(context, partition_id + 1, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -733,6 +751,15 @@ template <class Transaction> class OrderStatus : public Transaction {
 		query = makeOrderStatusQuery()(context, partition_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		query = makeOrderStatusQuery()(context, partition_id + 1, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -911,6 +938,16 @@ template <class Transaction> class Delivery : public Transaction {
 		query = makeDeliveryQuery()(context, partition_id, random, query.sub_query_id);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, RandomType &random, uint64_t sub_query_id)
+	{
+		CHECK(sub_query_id >= 0 && sub_query_id < DISTRICT_PER_WAREHOUSE);
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		query = makeDeliveryQuery()(context, partition_id + 1, random, sub_query_id);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -1056,6 +1093,15 @@ template <class Transaction> class StockLevel : public Transaction {
 		query = makeStockLevelQuery()(context, partition_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		query = makeStockLevelQuery()(context, partition_id + 1, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -1161,6 +1207,15 @@ template <class Transaction> class Test : public Transaction {
 		query = makeTestQuery()(context, partition_id, random);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		query = makeTestQuery()(context, partition_id + 1, random);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
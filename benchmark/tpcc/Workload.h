@@ -11,6 +11,7 @@
 #include "benchmark/tpcc/Storage.h"
 #include "benchmark/tpcc/Transaction.h"
 #include "core/Partitioner.h"
+#include "core/TransactionPool.h"
 
 namespace star
 {
@@ -32,15 +33,20 @@ template <class Transaction> class Workload {
 		, random(random)
 		, partitioner(partitioner)
                 , delivery_cur_sub_query_id(0)
+		, pool(NUM_POOL_SLOTS)
 	{
 	}
 
-	static uint64_t next_transaction_id(uint64_t coordinator_id)
+	// tid format : coordinator id (16 bits) | cluster worker id (16 bits) | per-worker counter (32 bits)
+	// every worker owns a disjoint id space, so no shared counter is touched on the hot path
+	uint64_t next_transaction_id(uint64_t coordinator_id, uint64_t cluster_worker_id)
 	{
-		constexpr int coordinator_id_offset = 32;
-		static std::atomic<int64_t> tid_static{ 1 };
-		auto tid = tid_static.fetch_add(1);
-		return (coordinator_id << coordinator_id_offset) | tid;
+		constexpr int coordinator_id_offset = 48;
+		constexpr int worker_id_offset = 32;
+		auto tid = ++tid_counter;
+		// ids must stay unique for the whole run, so the counter cannot wrap into ids handed out before
+		CHECK(tid < (1ull << worker_id_offset)) << "worker " << cluster_worker_id << " ran out of transaction ids";
+		return (coordinator_id << coordinator_id_offset) | (cluster_worker_id << worker_id_offset) | tid;
 	}
 
 	std::unique_ptr<TransactionType> next_transaction(ContextType &context, std::size_t partition_id, std::size_t worker_id, std::size_t granule_id = 0)
@@ -48,55 +54,59 @@ template <class Transaction> class Workload {
 		int x = random.uniform_dist(1, 100);
 		std::unique_ptr<TransactionType> p;
 
-		static std::atomic<uint64_t> tid_cnt(0);
-		long long transactionId = tid_cnt.fetch_add(1);
 		auto random_seed = Time::now();
 
 		std::string transactionType;
 		random.set_seed(random_seed);
 		if (context.workloadType == TPCCWorkloadType::MIXED) {
                         if (x <= 4) {
-                                p = std::make_unique<OrderStatus<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner);
+                                p = make_transaction<OrderStatus>(ORDER_STATUS, context, partition_id);
 				transactionType = "TPCC OrderStatus";
                         } else if (x <= 4 + 4) {
-                                p = std::make_unique<Delivery<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner, delivery_cur_sub_query_id);
+                                p = make_transaction<Delivery>(DELIVERY, context, partition_id, delivery_cur_sub_query_id);
 				transactionType = "TPCC Delivery";
                                 delivery_cur_sub_query_id++;
                                 if (delivery_cur_sub_query_id == DISTRICT_PER_WAREHOUSE)
                                         delivery_cur_sub_query_id = 0;
                         } else if (x <= 4 + 4 + 4) {
-				p = std::make_unique<StockLevel<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner);
+				p = make_transaction<StockLevel>(STOCK_LEVEL, context, partition_id);
 				transactionType = "TPCC StockLevel";
                         } else if (x <= 4 + 4 + 4 + 43) {
-				p = std::make_unique<Payment<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner);
+				p = make_transaction<Payment>(PAYMENT, context, partition_id);
 				transactionType = "TPCC Payment";
 			} else {
-				p = std::make_unique<NewOrder<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner);
+				p = make_transaction<NewOrder>(NEW_ORDER, context, partition_id);
 				transactionType = "TPCC NewOrder";
 			}
                 } else if (context.workloadType == TPCCWorkloadType::FIRST_TWO) {
                         if (x <= 50) {
-                                p = std::make_unique<Payment<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner);
+                                p = make_transaction<Payment>(PAYMENT, context, partition_id);
 				transactionType = "TPCC Payment";
 			} else {
-				p = std::make_unique<NewOrder<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner);
+				p = make_transaction<NewOrder>(NEW_ORDER, context, partition_id);
 				transactionType = "TPCC NewOrder";
 			}
                 } else if (context.workloadType == TPCCWorkloadType::TEST) {
-			p = std::make_unique<Test<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner);
+			p = make_transaction<Test>(TEST, context, partition_id);
 			transactionType = "TPCC Test";
 		} else if (context.workloadType == TPCCWorkloadType::NEW_ORDER_ONLY) {
-			p = std::make_unique<NewOrder<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner);
+			p = make_transaction<NewOrder>(NEW_ORDER, context, partition_id);
 			transactionType = "TPCC NewOrder";
 		} else {
-			p = std::make_unique<Payment<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner);
+			p = make_transaction<Payment>(PAYMENT, context, partition_id);
 			transactionType = "TPCC Payment";
 		}
 		p->txn_random_seed_start = random_seed;
-		p->transaction_id = next_transaction_id(coordinator_id);
+		p->transaction_id = next_transaction_id(coordinator_id, worker_id);
 		return p;
 	}
 
+	// hand a finished transaction back so that next_transaction can reuse it
+	void recycle_transaction(std::unique_ptr<TransactionType> txn)
+	{
+		pool.put(std::move(txn));
+	}
+
 	std::unique_ptr<TransactionType> deserialize_from_raw(ContextType &context, const std::string &data)
 	{
 		Decoder decoder(data);
@@ -154,12 +164,29 @@ template <class Transaction> class Workload {
         }
 
     private:
+	enum PoolSlot { NEW_ORDER, PAYMENT, ORDER_STATUS, DELIVERY, STOCK_LEVEL, TEST, NUM_POOL_SLOTS };
+
+	template <template <class> class T, class... Args>
+	std::unique_ptr<TransactionType> make_transaction(PoolSlot slot, ContextType &context, std::size_t partition_id, Args... args)
+	{
+		auto txn = pool.template get<T<Transaction> >(slot);
+		if (txn != nullptr) {
+			txn->reinit(partition_id, random, args...);
+			return std::unique_ptr<TransactionType>(txn);
+		}
+		std::unique_ptr<TransactionType> p = std::make_unique<T<Transaction> >(coordinator_id, partition_id, db, context, random, partitioner, args...);
+		p->pool_slot = slot;
+		return p;
+	}
+
 	std::size_t coordinator_id;
 	DatabaseType &db;
 	RandomType &random;
 	Partitioner &partitioner;
 
         uint64_t delivery_cur_sub_query_id;
+	TransactionPool<TransactionType> pool;
+	uint64_t tid_counter = 0;
 };
 
 } // namespace tpcc
@@ -93,6 +93,7 @@ class Database {
 		std::size_t coordinator_id = context.coordinator_id;
 		std::size_t partitionNum = context.partition_num;
 		std::size_t threadsNum = context.worker_num;
+		btree_fill_factor = context.btree_fill_factor;
 
 		auto partitioner = PartitionerFactory::create_partitioner(context.partitioner, coordinator_id, context.coordinator_num);
 
@@ -108,8 +109,12 @@ class Database {
                                 tbl_ycsb_vec.push_back(
 					std::make_unique<TableBTreeOLC<ycsb::key, ycsb::value, ycsb::KeyComparator, ycsb::ValueComparator, MetaInitFuncTwoPL> >(ycsbTableID, partitionID));
                         } else if (context.protocol == "TwoPLPasha") {
+                                // keep in sync with TypedTables<ycsb::Database, MetaInitFuncTwoPLPasha>
                                 tbl_ycsb_vec.push_back(
 					std::make_unique<TableBTreeOLC<ycsb::key, ycsb::value, ycsb::KeyComparator, ycsb::ValueComparator, MetaInitFuncTwoPLPasha> >(ycsbTableID, partitionID));
+                        } else if (context.protocol == "SiloPasha") {
+                                tbl_ycsb_vec.push_back(
+					std::make_unique<TableBTreeOLC<ycsb::key, ycsb::value, ycsb::KeyComparator, ycsb::ValueComparator, MetaInitFuncSiloPasha> >(ycsbTableID, partitionID));
 			} else if (context.protocol != "HStore") {
 				tbl_ycsb_vec.push_back(std::make_unique<TableHashMap<997, ycsb::key, ycsb::value, ycsb::KeyComparator, ycsb::ValueComparator> >(ycsbTableID, partitionID));
 			} else {
@@ -214,13 +219,14 @@ class Database {
 
                         auto ycsbTableID = ycsb::tableID;
                         cxl_tbl_vecs[ycsbTableID].resize(partitionNum);
-                        auto ycsb_cxl_btreetables = reinterpret_cast<CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator>::CXLBTree *>(cxl_memory.cxlalloc_malloc_wrapper(
-                                        sizeof(CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator>::CXLBTree) * partitionNum, CXLMemory::INDEX_ALLOCATION));
+                        // the plain keys fit the 32-bit prefixes of the compact node format
+                        auto ycsb_cxl_btreetables = reinterpret_cast<CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree *>(cxl_memory.cxlalloc_malloc_wrapper(
+                                        sizeof(CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree) * partitionNum, CXLMemory::INDEX_ALLOCATION));
                         for (int i = 0; i < partitionNum; i++) {
                                 auto cxl_table = &ycsb_cxl_btreetables[i];
-                                new(cxl_table) CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator>::CXLBTree();
+                                new(cxl_table) CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree();
                                 cxl_table_ptrs[ycsbTableID * partitionNum + i] = reinterpret_cast<void *>(cxl_table);
-                                cxl_tbl_vecs[ycsbTableID][i] = new CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator>(cxl_table, ycsbTableID, i);
+                                cxl_tbl_vecs[ycsbTableID][i] = new CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator, CXLBTreeNodeFormat::Compact>(cxl_table, ycsbTableID, i);
                         }
 
                         CXLMemory::commit_shared_data_initialization(CXLMemory::cxl_data_migration_root_index, cxl_table_ptrs);
@@ -234,8 +240,8 @@ class Database {
                         auto ycsbTableID = ycsb::tableID;
                         cxl_tbl_vecs[ycsbTableID].resize(partitionNum);
                         for (int i = 0; i < partitionNum; i++) {
-                                auto cxl_table = reinterpret_cast<CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator>::CXLBTree *>(cxl_table_ptrs[ycsbTableID * partitionNum + i].get());
-                                cxl_tbl_vecs[ycsbTableID][i] = new CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator>(cxl_table, ycsbTableID, i);
+                                auto cxl_table = reinterpret_cast<CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator, CXLBTreeNodeFormat::Compact>::CXLBTree *>(cxl_table_ptrs[ycsbTableID * partitionNum + i].get());
+                                cxl_tbl_vecs[ycsbTableID][i] = new CXLTableBTreeOLC<ycsb::key, ycsb::KeyComparator, CXLBTreeNodeFormat::Compact>(cxl_table, ycsbTableID, i);
                         }
                         LOG(INFO) << "YCSB retrieves data migration metadata";
                 }
@@ -247,7 +253,10 @@ class Database {
         {
                 for (int i = 0; i < tbl_vecs.size(); i++) {
                         for (int j = 0; j < tbl_vecs[i].size(); j++) {
+                                // the migrated rows are collected and the CXL index is built bottom-up from them in key order
+                                cxl_tbl_vecs[i][j]->collect_begin();
                                 tbl_vecs[i][j]->move_all_into_cxl(move_in_func);
+                                cxl_tbl_vecs[i][j]->collect_end(btree_fill_factor);
                         }
                 }
         }
@@ -271,6 +280,8 @@ class Database {
 		std::size_t partitionNum = context.partition_num;
 		std::size_t totalKeys = keysPerPartition * partitionNum;
 
+		// both partitionings generate the keys of a partition in ascending order
+		table->bulk_load_begin(context.btree_fill_factor);
 		if (context.strategy == PartitionStrategy::RANGE) {
 			// use range partitioning
 
@@ -290,7 +301,7 @@ class Database {
 				value.Y_F09.assign(random.a_string(YCSB_FIELD_SIZE, YCSB_FIELD_SIZE));
 				value.Y_F10.assign(random.a_string(YCSB_FIELD_SIZE, YCSB_FIELD_SIZE));
 
-				bool success = table->insert(&key, &value);
+				bool success = table->bulk_load_append(&key, &value);
                                 CHECK(success == true);
 			}
 
@@ -313,10 +324,11 @@ class Database {
 				value.Y_F09.assign(random.a_string(YCSB_FIELD_SIZE, YCSB_FIELD_SIZE));
 				value.Y_F10.assign(random.a_string(YCSB_FIELD_SIZE, YCSB_FIELD_SIZE));
 
-				bool success = table->insert(&key, &value);
+				bool success = table->bulk_load_append(&key, &value);
                                 CHECK(success == true);
 			}
 		}
+		table->bulk_load_end();
 
                 // insert a max key that represents the upper bound (for next-key locking)
                 ycsb::key max_key;
@@ -335,6 +347,7 @@ class Database {
 
 	std::vector<ThreadPool *> threadpools;
 	WALLogger *checkpoint_file_writer = nullptr;
+	double btree_fill_factor = 1.0;
 
 	std::vector<std::vector<ITable *> > tbl_vecs;
 	std::vector<std::unique_ptr<ITable> > tbl_ycsb_vec;
@@ -342,4 +355,19 @@ class Database {
         std::vector<std::vector<CXLTableBase *> > cxl_tbl_vecs;
 };
 } // namespace ycsb
+
+// under TwoPLPasha, every partition of the ycsb table is a TableBTreeOLC (see Database::initialize)
+template <> class TypedTables<ycsb::Database, MetaInitFuncTwoPLPasha> {
+    public:
+	using TableType = TableBTreeOLC<ycsb::ycsb::key, ycsb::ycsb::value, ycsb::ycsb::KeyComparator, ycsb::ycsb::ValueComparator, MetaInitFuncTwoPLPasha>;
+
+	static constexpr bool typed = true;
+
+	static TableType *find_table(ycsb::Database &db, std::size_t table_id, std::size_t partition_id)
+	{
+		ITable *table = db.find_table(table_id, partition_id);
+		DCHECK(dynamic_cast<TableType *>(table) != nullptr);
+		return static_cast<TableType *>(table);
+	}
+};
 } // namespace star
@@ -7,6 +7,7 @@
 #include <vector>
 #include "benchmark/ycsb/Context.h"
 #include "benchmark/ycsb/Random.h"
+#include "common/ShiftingZipf.h"
 #include "common/Zipf.h"
 
 namespace star
@@ -17,6 +18,44 @@ extern bool warmed_up;
 namespace ycsb
 {
 
+// draws a skewed key of a partition, following the current hotspot phase if hotspot shifting is enabled
+inline uint32_t zipf_key(Random &random, uint32_t partitionID)
+{
+	auto &shifting_zipf = ShiftingZipf::globalShiftingZipf();
+	if (shifting_zipf.enabled()) {
+		return shifting_zipf.value(random, partitionID);
+	}
+	return Zipf::zipfForPartition(partitionID).value(random);
+}
+
+// draws the zipf rank of a skewed key before its partition is chosen, which keeps the order of the random draws;
+// with per-partition skew the rank depends on the partition and is drawn by zipf_place() instead
+inline uint32_t zipf_rank(Random &random, uint64_t &phase)
+{
+	if (Zipf::partitionZipfs().empty() == false) {
+		return 0;
+	}
+	auto &shifting_zipf = ShiftingZipf::globalShiftingZipf();
+	if (shifting_zipf.enabled()) {
+		phase = shifting_zipf.current_phase();
+		return shifting_zipf.rank(random, phase);
+	}
+	return Zipf::globalZipf().value(random);
+}
+
+// turns a rank from zipf_rank() into a skewed key of a partition
+inline uint32_t zipf_place(Random &random, uint32_t rank, uint64_t phase, uint32_t partitionID)
+{
+	if (Zipf::partitionZipfs().empty() == false) {
+		return Zipf::zipfForPartition(partitionID).value(random);
+	}
+	auto &shifting_zipf = ShiftingZipf::globalShiftingZipf();
+	if (shifting_zipf.enabled()) {
+		return shifting_zipf.map(rank, partitionID, phase);
+	}
+	return rank;
+}
+
 template <std::size_t N> struct RMWQuery {
 	int32_t Y_KEY[N];
 	bool UPDATE[N];
@@ -78,6 +117,7 @@ template <std::size_t N> class makeRMWQuery {
 			}
 
 			uint32_t key;
+			uint64_t phase = 0;
 
 			// generate a key in a partition
 			bool retry;
@@ -90,8 +130,8 @@ template <std::size_t N> class makeRMWQuery {
 					key = i == 0 ? random.uniform_dist(0, static_cast<uint32_t>(context.keysPerGranule) - 1) :
 						       random.uniform_dist(0, static_cast<uint32_t>(context.keysPerPartition) - 1);
 				} else {
-					key = i == 0 ? random.uniform_dist(0, static_cast<uint32_t>(context.keysPerGranule) - 1) :
-						       Zipf::globalZipf().value(random.next_double());
+					// placed in the partition the key lands in, see below
+					key = i == 0 ? random.uniform_dist(0, static_cast<uint32_t>(context.keysPerGranule) - 1) : zipf_rank(random, phase);
 				}
 				int this_partition_idx = 0;
 
@@ -120,12 +160,12 @@ template <std::size_t N> class makeRMWQuery {
 					}
 					auto newPartitionID = query.parts[i % query.num_parts];
 					query.Y_KEY[i] = i == 0 ? context.getGlobalKeyID(key, newPartitionID, granuleID) :
-								  context.getGlobalKeyID(key, newPartitionID);
+								  context.getGlobalKeyID(context.isUniform ? key : zipf_place(random, key, phase, newPartitionID), newPartitionID);
 					query.cross_partition = true;
 					this_partition_idx = i % query.num_parts;
 				} else {
 					query.Y_KEY[i] = i == 0 ? context.getGlobalKeyID(key, partitionID, granuleID) :
-								  context.getGlobalKeyID(key, partitionID);
+								  context.getGlobalKeyID(context.isUniform ? key : zipf_place(random, key, phase, partitionID), partitionID);
 				}
 
 				for (auto k = 0u; k < i; k++) {
@@ -202,6 +242,7 @@ template <std::size_t N> class makeScanQuery {
 		int crossPartitionPartNum = random.uniform_dist(2, context.crossPartitionPartNum);
 		for (auto i = 0u; i < N; i++) {
 			uint32_t key;
+			uint64_t phase = 0;
 
 			// generate a key in a partition
 			bool retry;
@@ -214,8 +255,8 @@ template <std::size_t N> class makeScanQuery {
 					key = i == 0 ? random.uniform_dist(0, static_cast<uint32_t>(context.keysPerGranule) - 1) :
 						       random.uniform_dist(0, static_cast<uint32_t>(context.keysPerPartition) - 1);
 				} else {
-					key = i == 0 ? random.uniform_dist(0, static_cast<uint32_t>(context.keysPerGranule) - 1) :
-						       Zipf::globalZipf().value(random.next_double());
+					// placed in the partition the key lands in, see below
+					key = i == 0 ? random.uniform_dist(0, static_cast<uint32_t>(context.keysPerGranule) - 1) : zipf_rank(random, phase);
 				}
 
 				int this_partition_idx = 0;
@@ -244,12 +285,12 @@ template <std::size_t N> class makeScanQuery {
 					}
 					auto newPartitionID = query.parts[i % query.num_parts];
 					query.Y_KEY[i] = i == 0 ? context.getGlobalKeyID(key, newPartitionID, granuleID) :
-								  context.getGlobalKeyID(key, newPartitionID);
+								  context.getGlobalKeyID(context.isUniform ? key : zipf_place(random, key, phase, newPartitionID), newPartitionID);
 					query.cross_partition = true;
 					this_partition_idx = i % query.num_parts;
 				} else {
 					query.Y_KEY[i] = i == 0 ? context.getGlobalKeyID(key, partitionID, granuleID) :
-								  context.getGlobalKeyID(key, partitionID);
+								  context.getGlobalKeyID(context.isUniform ? key : zipf_place(random, key, phase, partitionID), partitionID);
 				}
 
 				for (auto k = 0u; k < i; k++) {
@@ -333,7 +374,7 @@ template <std::size_t N> class makeInsertQuery {
                                         // This granule will be served as the coordinating granule
                                         key = random.uniform_dist(0, static_cast<uint32_t>(context.keysPerPartition) - 1);
                                 } else {
-                                        key = Zipf::globalZipf().value(random.next_double());
+                                        key = zipf_key(random, query.parts[0]);
                                 }
 
                                 // we do not want to insert extra keys into the database
@@ -422,7 +463,7 @@ template <std::size_t N> class makeDeleteQuery {
                                 // This granule will be served as the coordinating granule
                                 key = random.uniform_dist(0, static_cast<uint32_t>(context.keysPerPartition) - 1);
                         } else {
-                                key = Zipf::globalZipf().value(random.next_double());
+                                key = zipf_key(random, query.parts[0]);
                         }
 
                         // get the global key based on the generated partition ID
@@ -202,6 +202,16 @@ template <class Transaction> class ReadModifyWrite : public Transaction {
 		query = makeRMWQuery<keys_num>()(context, partition_id, granule_id, random, this->partitioner);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeRMWQuery<keys_num>()(context, partition_id, granule_id, random, this->partitioner);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -315,6 +325,16 @@ template <class Transaction> class Scan : public Transaction {
 		query = makeScanQuery<scan_num>()(context, partition_id, granule_id, random, this->partitioner);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeScanQuery<scan_num>()(context, partition_id, granule_id, random, this->partitioner);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -482,6 +502,16 @@ template <class Transaction> class Insert : public Transaction {
 		query = makeInsertQuery<insert_num>()(context, partition_id, granule_id, random, this->partitioner);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeInsertQuery<insert_num>()(context, partition_id, granule_id, random, this->partitioner);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
@@ -613,6 +643,16 @@ template <class Transaction> class Delete : public Transaction {
 		query = makeDeleteQuery<delete_num>()(context, partition_id, granule_id, random, this->partitioner);
 	}
 
+	// re-initialize a pooled transaction for a new query, see TransactionPool
+	void reinit(std::size_t partition_id, std::size_t granule_id, RandomType &random)
+	{
+		Transaction::reinit(partition_id);
+		this->random = random;
+		this->partition_id = partition_id;
+		this->granule_id = granule_id;
+		query = makeDeleteQuery<delete_num>()(context, partition_id, granule_id, random, this->partitioner);
+	}
+
     private:
 	DatabaseType &db;
 	const ContextType &context;
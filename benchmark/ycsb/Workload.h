@@ -10,6 +10,7 @@
 #include "benchmark/ycsb/Storage.h"
 #include "benchmark/ycsb/Transaction.h"
 #include "core/Partitioner.h"
+#include "core/TransactionPool.h"
 
 namespace star
 {
@@ -30,15 +31,19 @@ template <class Transaction> class Workload {
 		, db(db)
 		, random(random)
 		, partitioner(partitioner)
+		, pool(NUM_POOL_SLOTS)
 	{
 	}
 
-	static uint64_t next_transaction_id(uint64_t coordinator_id, uint64_t cluster_worker_id)
+	// tid format : coordinator id (16 bits) | cluster worker id (16 bits) | per-worker counter (32 bits)
+	// every worker owns a disjoint id space, so no shared counter is touched on the hot path
+	uint64_t next_transaction_id(uint64_t coordinator_id, uint64_t cluster_worker_id)
 	{
-		constexpr int coordinator_id_offset = 40;
+		constexpr int coordinator_id_offset = 48;
 		constexpr int worker_id_offset = 32;
-		static std::atomic<int64_t> tid_static{ 1 };
-		auto tid = tid_static.fetch_add(1);
+		auto tid = ++tid_counter;
+		// ids must stay unique for the whole run, so the counter cannot wrap into ids handed out before
+		CHECK(tid < (1ull << worker_id_offset)) << "worker " << cluster_worker_id << " ran out of transaction ids";
 		return (coordinator_id << coordinator_id_offset) | (cluster_worker_id << worker_id_offset) | tid;
 	}
 
@@ -47,28 +52,26 @@ template <class Transaction> class Workload {
 		int x = random.uniform_dist(1, 100);
                 std::unique_ptr<TransactionType> p;
 
-		static std::atomic<uint64_t> tid_cnt(0);
-		long long transactionId = tid_cnt.fetch_add(1);
 		auto random_seed = Time::now();
 
                 std::string transactionType;
 		random.set_seed(random_seed);
                 if (context.workloadType == YCSBWorkloadType::MIXED) {
                         if (x <= 80) {
-                                p = std::make_unique<Scan<Transaction> >(coordinator_id, partition_id, granule_id, db, context, random, partitioner);
+                                p = make_transaction<Scan>(SCAN, context, partition_id, granule_id);
                         } else if (x <= 90) {
-                                p = std::make_unique<Insert<Transaction> >(coordinator_id, partition_id, granule_id, db, context, random, partitioner);
+                                p = make_transaction<Insert>(INSERT, context, partition_id, granule_id);
                         } else {
-                                p = std::make_unique<Delete<Transaction> >(coordinator_id, partition_id, granule_id, db, context, random, partitioner);
+                                p = make_transaction<Delete>(DELETE, context, partition_id, granule_id);
                         }
                 } else if (context.workloadType == YCSBWorkloadType::RMW) {
-                        p = std::make_unique<ReadModifyWrite<Transaction> >(coordinator_id, partition_id, granule_id, db, context, random, partitioner);
+                        p = make_transaction<ReadModifyWrite>(RMW, context, partition_id, granule_id);
                 } else if (context.workloadType == YCSBWorkloadType::SCAN) {
-                        p = std::make_unique<Scan<Transaction> >(coordinator_id, partition_id, granule_id, db, context, random, partitioner);
+                        p = make_transaction<Scan>(SCAN, context, partition_id, granule_id);
                 } else if (context.workloadType == YCSBWorkloadType::INSERT) {
-                        p = std::make_unique<Insert<Transaction> >(coordinator_id, partition_id, granule_id, db, context, random, partitioner);
+                        p = make_transaction<Insert>(INSERT, context, partition_id, granule_id);
                 } else if (context.workloadType == YCSBWorkloadType::DELETE) {
-                        p = std::make_unique<Delete<Transaction> >(coordinator_id, partition_id, granule_id, db, context, random, partitioner);
+                        p = make_transaction<Delete>(DELETE, context, partition_id, granule_id);
                 } else {
                         CHECK(0);
                 }
@@ -77,6 +80,12 @@ template <class Transaction> class Workload {
 		return p;
 	}
 
+	// hand a finished transaction back so that next_transaction can reuse it
+	void recycle_transaction(std::unique_ptr<TransactionType> txn)
+	{
+		pool.put(std::move(txn));
+	}
+
 	std::unique_ptr<TransactionType> deserialize_from_raw(ContextType &context, const std::string &data)
 	{
 		Decoder decoder(data);
@@ -134,10 +143,27 @@ template <class Transaction> class Workload {
         }
 
     private:
+	enum PoolSlot { RMW, SCAN, INSERT, DELETE, NUM_POOL_SLOTS };
+
+	template <template <class> class T>
+	std::unique_ptr<TransactionType> make_transaction(PoolSlot slot, ContextType &context, std::size_t partition_id, std::size_t granule_id)
+	{
+		auto txn = pool.template get<T<Transaction> >(slot);
+		if (txn != nullptr) {
+			txn->reinit(partition_id, granule_id, random);
+			return std::unique_ptr<TransactionType>(txn);
+		}
+		std::unique_ptr<TransactionType> p = std::make_unique<T<Transaction> >(coordinator_id, partition_id, granule_id, db, context, random, partitioner);
+		p->pool_slot = slot;
+		return p;
+	}
+
 	std::size_t coordinator_id;
 	DatabaseType &db;
 	RandomType &random;
 	Partitioner &partitioner;
+	TransactionPool<TransactionType> pool;
+	uint64_t tid_counter = 0;
 };
 
 } // namespace ycsb
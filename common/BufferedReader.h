@@ -72,7 +72,7 @@ class BufferedReader {
 
 	std::unique_ptr<Message> next_message()
 	{
-		DCHECK(socket != nullptr);
+		DCHECK(socket != nullptr || cxl_ringbuffer != nullptr);
 
 		fetch_message();
 		if (!has_message()) {
@@ -106,29 +106,25 @@ class BufferedReader {
     private:
 	void fetch_message()
 	{
-		DCHECK(socket != nullptr);
+		DCHECK(socket != nullptr || cxl_ringbuffer != nullptr);
 
 		// return if there is a message left
 		if (has_message()) {
 			return;
 		}
 
-		// copy left bytes
+		// the leftover bytes of a partial message are only moved to the front once the free tail gets short,
+		// so most reads append to the buffer without copying anything
 		DCHECK(bytes_read <= bytes_total);
 		auto bytes_left = bytes_total - bytes_read;
-		bytes_total = 0;
-
-		if (bytes_left > 0 && bytes_read > 0) {
-			if (bytes_left <= bytes_read) { // non overlapping
-				std::memcpy(buffer, buffer + bytes_read, bytes_left);
-			} else {
-				for (auto i = 0u; i < bytes_left; i++) {
-					buffer[i] = buffer[i + bytes_read];
-				}
-			}
+		if (bytes_left == 0) {
+			bytes_read = 0;
+			bytes_total = 0;
+		} else if (BUFFER_SIZE - bytes_total < COMPACT_THRESHOLD || !message_fits()) {
+			std::memmove(buffer, buffer + bytes_read, bytes_left);
+			bytes_total = bytes_left;
+			bytes_read = 0;
 		}
-		bytes_total = bytes_left;
-		bytes_read = 0;
 
 		// read new message
                 long bytes_received = 0;
@@ -162,8 +158,19 @@ class BufferedReader {
 		return bytes_read + Message::get_message_length(header) <= bytes_total;
 	}
 
+	// whether the partial message at bytes_read can be completed without moving it
+	bool message_fits()
+	{
+		if (bytes_read + Message::get_prefix_size() > bytes_total) {
+			return bytes_read + Message::get_prefix_size() <= BUFFER_SIZE;
+		}
+		auto header = *reinterpret_cast<Message::header_type *>(buffer + bytes_read);
+		return bytes_read + Message::get_message_length(header) <= BUFFER_SIZE;
+	}
+
     public:
 	static constexpr uint32_t BUFFER_SIZE = 1024 * 1024 * 4; // 4MB
+	static constexpr uint32_t COMPACT_THRESHOLD = 1024 * 64; // larger than any CXL ring entry
 
     private:
         bool use_cxl_transport;
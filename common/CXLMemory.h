@@ -44,6 +44,8 @@ class CXLMemory {
         static constexpr uint64_t cxl_lru_trackers_root_index = 2;
         static constexpr uint64_t cxl_global_epoch_root_index = 3;
         static constexpr uint64_t cxl_global_ebr_meta_root_index = 4;
+        static constexpr uint64_t cxl_aria_root_index = 5;
+        static constexpr uint64_t cxl_calvin_root_index = 6;
 
         void init(Context context)
         {
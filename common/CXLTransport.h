@@ -14,29 +14,92 @@
 namespace star
 {
 
+/*
+ * Every host has one receive ring per i/o thread. Ring (node, group) is consumed by the incoming
+ * dispatcher of i/o thread group on host node, which serves the workers whose id is group modulo
+ * the number of i/o threads, so messages of different worker groups never share a consumer.
+ *
+ * With worker lanes, every worker also has a lane (node, worker) that it drains by itself.
+ * Worker k of every host sends its requests and responses to the lane of worker k of the destination,
+ * bypassing the dispatchers and the in-memory queues.
+ */
 class CXLTransport {
     public:
-        CXLTransport(MPSCRingBuffer *cxl_ringbuffers)
+        // published by coordinator 0 in front of the rings, every other host checks that it indexes them the same way
+        struct Layout {
+                uint64_t node_num;
+                uint64_t rings_per_node;
+                uint64_t lanes_per_node;
+                char padding[40];       // the rings start on a cache line
+
+                MPSCRingBuffer *get_ringbuffers()
+                {
+                        return reinterpret_cast<MPSCRingBuffer *>(this + 1);
+                }
+        };
+
+        CXLTransport(MPSCRingBuffer *cxl_ringbuffers, uint64_t rings_per_node, MPSCRingBuffer *cxl_worker_lanes = nullptr, uint64_t lanes_per_node = 0)
                 : cxl_ringbuffers(cxl_ringbuffers)
+                , rings_per_node(rings_per_node)
+                , cxl_worker_lanes(cxl_worker_lanes)
+                , lanes_per_node(lanes_per_node)
         {}
 
+        static MPSCRingBuffer &get_ringbuffer(MPSCRingBuffer *cxl_ringbuffers, uint64_t rings_per_node, uint64_t node_id, uint64_t group_id)
+        {
+                return cxl_ringbuffers[node_id * rings_per_node + group_id % rings_per_node];
+        }
+
+        // the ring is picked by the worker that generated the message
         void send(Message *message)
+        {
+                send(message, message->get_worker_id());
+        }
+
+        void send(Message *message, uint64_t group_id)
         {
                 auto dest_node_id = message->get_dest_node_id();
                 auto message_length = message->get_message_length();
 
                 uint64_t bytes_sent = 0;
-                bytes_sent = cxl_ringbuffers[dest_node_id].send(message->get_raw_ptr(), message_length);
+                bytes_sent = get_ringbuffer(cxl_ringbuffers, rings_per_node, dest_node_id, group_id).send(message->get_raw_ptr(), message_length);
                 CHECK(bytes_sent == message_length);
         }
 
-        uint64_t recv(uint64_t src_node_id, char *buffer, uint64_t buffer_size)
+        uint64_t recv(uint64_t node_id, uint64_t group_id, char *buffer, uint64_t buffer_size)
+        {
+                return get_ringbuffer(cxl_ringbuffers, rings_per_node, node_id, group_id).recv(buffer, buffer_size);
+        }
+
+        bool has_worker_lanes()
+        {
+                return cxl_worker_lanes != nullptr;
+        }
+
+        MPSCRingBuffer &get_worker_lane(uint64_t node_id, uint64_t worker_id)
+        {
+                DCHECK(worker_id < lanes_per_node);
+                return cxl_worker_lanes[node_id * lanes_per_node + worker_id];
+        }
+
+        // messages waiting in all receive rings of a host
+        uint64_t queue_depth(uint64_t node_id)
         {
-                return cxl_ringbuffers[src_node_id].recv(buffer, buffer_size);
+                uint64_t depth = 0;
+                for (uint64_t i = 0; i < rings_per_node; i++) {
+                        depth += get_ringbuffer(cxl_ringbuffers, rings_per_node, node_id, i).size();
+                }
+                for (uint64_t i = 0; i < lanes_per_node; i++) {
+                        depth += get_worker_lane(node_id, i).size();
+                }
+                return depth;
         }
 
     private:
         MPSCRingBuffer *cxl_ringbuffers = nullptr;
+        uint64_t rings_per_node = 1;
+        MPSCRingBuffer *cxl_worker_lanes = nullptr;
+        uint64_t lanes_per_node = 0;
 };
 
 extern CXLTransport *cxl_transport;
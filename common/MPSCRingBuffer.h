@@ -26,7 +26,7 @@ class MPSCRingBuffer {
 
         MPSCRingBuffer(uint64_t entry_struct_size, uint64_t entry_num)
                 : entry_struct_size(entry_struct_size)
-                , entry_data_size(entry_struct_size - 9)
+                , entry_data_size(entry_data_size_of(entry_struct_size))
                 , entry_num(entry_num)
                 , head(0)
                 , tail(0)
@@ -43,6 +43,12 @@ class MPSCRingBuffer {
                 }
         }
 
+        // bytes of a message that fit into an entry, the rest holds the entry header
+        static uint64_t entry_data_size_of(uint64_t entry_struct_size)
+        {
+                return entry_struct_size - offsetof(Entry, data);
+        }
+
         uint64_t get_entry_num()
         {
                 return entry_num;
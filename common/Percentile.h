@@ -5,76 +5,156 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <glog/logging.h>
 
-#include "Random.h"
-// The nearest-rank method
-// https://en.wikipedia.org/wiki/Percentile
+// Log-linear (HDR-style) histogram.
+// Values below 2^kSubBucketBits are recorded exactly, larger values fall into one of 2^(kSubBucketBits-1)
+// linear sub-buckets of their power-of-two range, so any percentile is within 1/2^(kSubBucketBits-1) of the true value.
+// The nearest-rank method is used to answer percentiles: https://en.wikipedia.org/wiki/Percentile
 
 namespace star
 {
 extern bool warmed_up;
 template <class T> class Percentile {
     public:
+	static constexpr int kSubBucketBits = 7;
+	static constexpr std::size_t kSubBucketCount = 1ull << kSubBucketBits;
+	static constexpr std::size_t kSubBucketHalfCount = kSubBucketCount / 2;
+	static constexpr std::size_t kBucketCount = kSubBucketCount + (64 - kSubBucketBits) * kSubBucketHalfCount;
+
+	using element_type = T;
+
 	Percentile()
-		: rand((uint64_t)this)
+		: counts(new std::atomic<uint64_t>[kBucketCount]())
 	{
 	}
-	using element_type = T;
+
+	Percentile(const Percentile &other)
+		: Percentile()
+	{
+		merge(other);
+	}
+
+	Percentile &operator=(const Percentile &other)
+	{
+		if (this != &other) {
+			clear();
+			merge(other);
+		}
+		return *this;
+	}
+
+	// Every histogram has a single writer; counters are updated with plain relaxed loads and stores,
+	// so other threads can read or merge a histogram while it is being recorded to.
 	void add(const element_type &value)
 	{
-		if (warmed_up == false || rand.uniform_dist(0, 100) > 10) // record 2% of the data
+		if (warmed_up == false)
 			return;
-		isSorted_ = false;
-		data_.push_back(value);
-		sum += value;
+		record(value);
 	}
 
 	void add(const std::vector<element_type> &v)
 	{
-		isSorted_ = false;
-		std::copy(v.begin(), v.end(), std::back_inserter(data_));
+		for (auto &value : v) {
+			record(value);
+		}
 	}
 
-	void clear()
+	void merge(const Percentile &other)
+	{
+		for (auto i = 0u; i < kBucketCount; i++) {
+			auto c = other.counts[i].load(std::memory_order_relaxed);
+			if (c != 0) {
+				add_bucket(i, c);
+			}
+		}
+		add_summary(other.sum_.load(std::memory_order_relaxed), other.min_.load(std::memory_order_relaxed),
+			    other.max_.load(std::memory_order_relaxed));
+	}
+
+	// removes the samples of an earlier snapshot of this histogram, leaving the samples recorded since then
+	// (min and max stay those of the whole histogram)
+	void subtract(const Percentile &snapshot)
 	{
-		isSorted_ = true;
-		data_.clear();
+		for (auto i = 0u; i < kBucketCount; i++) {
+			auto c = snapshot.counts[i].load(std::memory_order_relaxed);
+			if (c != 0) {
+				DCHECK(counts[i].load(std::memory_order_relaxed) >= c);
+				counts[i].store(counts[i].load(std::memory_order_relaxed) - c, std::memory_order_relaxed);
+			}
+		}
+		count_.store(count_.load(std::memory_order_relaxed) - snapshot.count_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		sum_.store(sum_.load(std::memory_order_relaxed) - snapshot.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
 	}
 
-	auto size()
+	void clear()
 	{
-		return data_.size();
+		for (auto i = 0u; i < kBucketCount; i++) {
+			counts[i].store(0, std::memory_order_relaxed);
+		}
+		count_.store(0, std::memory_order_relaxed);
+		sum_.store(0, std::memory_order_relaxed);
+		min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+		max_.store(0, std::memory_order_relaxed);
 	}
 
-	element_type avg()
+	uint64_t size() const
 	{
-		return sum / (size() + 0.1);
+		return count_.load(std::memory_order_relaxed);
 	}
 
-	element_type nth(double n)
+	element_type avg() const
 	{
-		if (data_.size() == 0) {
+		auto n = size();
+		if (n == 0) {
 			return 0;
 		}
-		checkSort();
-		DCHECK(n > 0 && n <= 100);
-		auto sz = size();
-		auto i = static_cast<decltype(sz)>(ceil(n / 100 * sz)) - 1;
-		DCHECK(i >= 0 && i < size());
-		return data_[i];
+		return sum_.load(std::memory_order_relaxed) / n;
 	}
 
-	void save_cdf(const std::string &path)
+	element_type min() const
 	{
-		if (data_.size() == 0) {
-			return;
+		return size() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+	}
+
+	element_type max() const
+	{
+		return max_.load(std::memory_order_relaxed);
+	}
+
+	element_type nth(double n) const
+	{
+		auto sz = size();
+		if (sz == 0) {
+			return 0;
+		}
+		DCHECK(n > 0 && n <= 100);
+		auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(n / 100 * sz)));
+		uint64_t seen = 0;
+		for (auto i = 0u; i < kBucketCount; i++) {
+			seen += counts[i].load(std::memory_order_relaxed);
+			if (seen >= rank) {
+				// the midpoint of the bucket, clamped to the recorded extremes
+				auto v = std::min(std::max(bucket_midpoint(i), min_.load(std::memory_order_relaxed)), max_.load(std::memory_order_relaxed));
+				return static_cast<element_type>(v);
+			}
 		}
-		checkSort();
+		return max();
+	}
 
-		if (path.empty()) {
+	void save_cdf(const std::string &path) const
+	{
+		auto sz = size();
+		if (sz == 0 || path.empty()) {
 			return;
 		}
 
@@ -83,35 +163,99 @@ template <class T> class Percentile {
 
 		cdf << "value\tcdf" << std::endl;
 
-		// output ~ 1k rows
-		auto step_size = std::max(1, int(data_.size() * 0.99 / 1000));
+		uint64_t seen = 0;
+		for (auto i = 0u; i < kBucketCount; i++) {
+			auto c = counts[i].load(std::memory_order_relaxed);
+			if (c == 0) {
+				continue;
+			}
+			seen += c;
+			cdf << bucket_midpoint(i) << "\t" << 1.0 * seen / sz << std::endl;
+		}
 
-		std::vector<element_type> cdf_result;
+		cdf.close();
+	}
 
-		for (auto i = 0u; i < 0.99 * data_.size(); i += step_size) {
-			cdf_result.push_back(data_[i]);
+	// serialization support, used to merge histograms across coordinators
+	template <class Func> void for_each_bucket(Func func) const
+	{
+		for (auto i = 0u; i < kBucketCount; i++) {
+			auto c = counts[i].load(std::memory_order_relaxed);
+			if (c != 0) {
+				func(static_cast<uint32_t>(i), c);
+			}
 		}
+	}
+
+	void add_bucket(uint32_t bucket, uint64_t count)
+	{
+		DCHECK(bucket < kBucketCount);
+		counts[bucket].store(counts[bucket].load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+		count_.store(count_.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+	}
 
-		for (auto i = 0u; i < cdf_result.size(); i++) {
-			cdf << cdf_result[i] << "\t" << 1.0 * (i + 1) / cdf_result.size() << std::endl;
+	void add_summary(uint64_t sum, uint64_t min, uint64_t max)
+	{
+		sum_.store(sum_.load(std::memory_order_relaxed) + sum, std::memory_order_relaxed);
+		if (min < min_.load(std::memory_order_relaxed)) {
+			min_.store(min, std::memory_order_relaxed);
+		}
+		if (max > max_.load(std::memory_order_relaxed)) {
+			max_.store(max, std::memory_order_relaxed);
 		}
+	}
 
-		cdf.close();
+	uint64_t raw_sum() const
+	{
+		return sum_.load(std::memory_order_relaxed);
+	}
+
+	uint64_t raw_min() const
+	{
+		return min_.load(std::memory_order_relaxed);
+	}
+
+	uint64_t raw_max() const
+	{
+		return max_.load(std::memory_order_relaxed);
 	}
 
     private:
-	void checkSort()
+	void record(const element_type &value)
+	{
+		// negative values (e.g., clock skew) are recorded as 0
+		uint64_t v = value < 0 ? 0 : static_cast<uint64_t>(value);
+		add_bucket(bucket_index(v), 1);
+		add_summary(v, v, v);
+	}
+
+	static uint32_t bucket_index(uint64_t v)
+	{
+		if (v < kSubBucketCount) {
+			return static_cast<uint32_t>(v);
+		}
+		int msb = 63 - __builtin_clzll(v);
+		int shift = msb - (kSubBucketBits - 1);
+		auto sub = (v >> shift) - kSubBucketHalfCount;
+		return static_cast<uint32_t>(kSubBucketCount + (shift - 1) * kSubBucketHalfCount + sub);
+	}
+
+	static uint64_t bucket_midpoint(uint32_t bucket)
 	{
-		if (!isSorted_) {
-			std::sort(data_.begin(), data_.end());
-			isSorted_ = true;
+		if (bucket < kSubBucketCount) {
+			return bucket;
 		}
+		auto shift = (bucket - kSubBucketCount) / kSubBucketHalfCount + 1;
+		auto sub = (bucket - kSubBucketCount) % kSubBucketHalfCount + kSubBucketHalfCount;
+		auto low = static_cast<uint64_t>(sub) << shift;
+		return low + ((1ull << shift) >> 1);
 	}
 
     private:
-	Random rand;
-	bool isSorted_ = true;
-	std::vector<element_type> data_;
-	element_type sum = 0;
+	std::unique_ptr<std::atomic<uint64_t>[]> counts;
+	std::atomic<uint64_t> count_{ 0 };
+	std::atomic<uint64_t> sum_{ 0 };
+	std::atomic<uint64_t> min_{ std::numeric_limits<uint64_t>::max() };
+	std::atomic<uint64_t> max_{ 0 };
 };
-} // namespace star
\ No newline at end of file
+} // namespace star
@@ -0,0 +1,181 @@
+//
+// Zipfian key generator whose hot set moves over time
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "common/Zipf.h"
+
+namespace star
+{
+
+/*
+ * Time is divided into phases of period_ms milliseconds, aligned to the wall clock so that all hosts in the pod
+ * agree on the current phase. Each phase has its own skew (thetas are cycled) and its own hot set:
+ *
+ *   NONE   - the hot set stays put (only the optional per-partition permutation applies)
+ *   ROTATE - the hot set jumps to a pseudo-random location of each partition at every phase change
+ *   DRIFT  - the hot set slides by drift_keys keys at every phase change
+ *
+ * value() draws a zipf rank and turns it into a key of a given partition with map(), both under the same phase.
+ * map() is a bijection on [0, n), so duplicate detection on keys still works.
+ */
+class ShiftingZipf {
+    public:
+	enum class Mode { NONE, ROTATE, DRIFT };
+
+	static Mode mode_from_string(const std::string &mode)
+	{
+		if (mode == "none") {
+			return Mode::NONE;
+		} else if (mode == "rotate") {
+			return Mode::ROTATE;
+		} else if (mode == "drift") {
+			return Mode::DRIFT;
+		}
+		CHECK(false) << "unknown hotspot shift mode " << mode;
+		return Mode::NONE;
+	}
+
+	void init(int n, const std::vector<double> &thetas, Mode mode, uint64_t period_ms, uint64_t drift_keys, bool permute, std::size_t partition_num)
+	{
+		CHECK(n > 0);
+		CHECK(thetas.size() > 0);
+		CHECK(period_ms > 0 || (mode == Mode::NONE && thetas.size() == 1));
+
+		n_ = n;
+		mode_ = mode;
+		period_ms_ = period_ms;
+		drift_keys_ = drift_keys;
+		thetas_ = thetas;
+
+		zipfs_.resize(thetas.size());
+		for (auto i = 0u; i < thetas.size(); i++) {
+			zipfs_[i].init(n, thetas[i]);
+		}
+
+		// per-partition permutation r -> (r * mult + add) mod n, mult must be coprime with n
+		multipliers_.assign(partition_num, 1);
+		addends_.assign(partition_num, 0);
+		if (permute) {
+			for (auto i = 0u; i < partition_num; i++) {
+				uint64_t mult = (mix(i + 1) % n_) | 1;
+				while (gcd(mult, n_) != 1) {
+					mult = (mult + 2) % n_;
+				}
+				multipliers_[i] = mult;
+				addends_[i] = mix(~i) % n_;
+			}
+		}
+
+		hasInit = true;
+	}
+
+	bool enabled() const
+	{
+		return hasInit;
+	}
+
+	// the clock is read once per key, so a phase change cannot fall between drawing a rank and placing it
+	template <class RandomType> int value(RandomType &random, std::size_t partition_id)
+	{
+		auto phase = current_phase();
+		return map(rank(random, phase), partition_id, phase);
+	}
+
+	// the zipf rank of value() under a given phase, for callers that place it with map() once the partition is known
+	template <class RandomType> int rank(RandomType &random, uint64_t phase)
+	{
+		DCHECK(hasInit);
+		log_phase_change(phase);
+		return zipfs_[phase % zipfs_.size()].value(random);
+	}
+
+	int map(int rank, std::size_t partition_id, uint64_t phase) const
+	{
+		DCHECK(hasInit);
+		DCHECK(partition_id < multipliers_.size());
+		DCHECK(rank >= 0 && static_cast<uint64_t>(rank) < n_);
+		uint64_t key = (static_cast<uint64_t>(rank) * multipliers_[partition_id] + addends_[partition_id]) % n_;
+		return static_cast<int>((key + offset(phase, partition_id)) % n_);
+	}
+
+	uint64_t current_phase() const
+	{
+		if (period_ms_ == 0) {
+			return 0;
+		}
+		auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		return now / period_ms_;
+	}
+
+	static ShiftingZipf &globalShiftingZipf()
+	{
+		static ShiftingZipf z;
+		return z;
+	}
+
+    private:
+	uint64_t offset(uint64_t phase, std::size_t partition_id) const
+	{
+		switch (mode_) {
+		case Mode::ROTATE:
+			return mix(phase * 0x9E3779B97F4A7C15ULL + partition_id) % n_;
+		case Mode::DRIFT:
+			return (phase % n_) * (drift_keys_ % n_) % n_;
+		default:
+			return 0;
+		}
+	}
+
+	void log_phase_change(uint64_t phase)
+	{
+		auto last = last_logged_phase_.load(std::memory_order_relaxed);
+		if (last == phase) {
+			return;
+		}
+		if (last_logged_phase_.compare_exchange_strong(last, phase)) {
+			LOG(INFO) << "hotspot phase " << phase << ": theta " << thetas_[phase % thetas_.size()] << ", offset of partition 0 "
+				  << offset(phase, 0);
+		}
+	}
+
+	static uint64_t mix(uint64_t x)
+	{
+		// splitmix64 finalizer
+		x += 0x9E3779B97F4A7C15ULL;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+		return x ^ (x >> 31);
+	}
+
+	static uint64_t gcd(uint64_t a, uint64_t b)
+	{
+		while (b != 0) {
+			auto t = a % b;
+			a = b;
+			b = t;
+		}
+		return a;
+	}
+
+	bool hasInit = false;
+
+	uint64_t n_ = 0;
+	Mode mode_ = Mode::NONE;
+	uint64_t period_ms_ = 0;
+	uint64_t drift_keys_ = 0;
+	std::vector<double> thetas_;
+	std::vector<Zipf> zipfs_;
+	std::vector<uint64_t> multipliers_, addends_;
+	std::atomic<uint64_t> last_logged_phase_{ UINT64_MAX };
+};
+
+} // namespace star
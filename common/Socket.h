@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <arpa/inet.h>
+#include <climits>
 #include <cstdlib>
 #include <cstring>
 #include <errno.h>
@@ -12,6 +14,7 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 namespace star
@@ -145,6 +148,32 @@ class Socket {
 		return n;
 	}
 
+	// writes all buffers with as few system calls as possible; iov is consumed in place
+	long writev_n_bytes(struct iovec *iov, int iovcnt)
+	{
+		DCHECK(fd >= 0);
+		long n = 0;
+		while (iovcnt > 0) {
+			long bytes_written = writev(fd, iov, std::min(iovcnt, IOV_MAX));
+			if (bytes_written < 0) {
+				CHECK(errno == EINTR || errno == EWOULDBLOCK || errno == EAGAIN);
+				continue;
+			}
+			n += bytes_written;
+			// skip the buffers that are fully written and advance the partially written one
+			while (iovcnt > 0 && bytes_written >= static_cast<long>(iov->iov_len)) {
+				bytes_written -= iov->iov_len;
+				iov++;
+				iovcnt--;
+			}
+			if (iovcnt > 0) {
+				iov->iov_base = static_cast<char *>(iov->iov_base) + bytes_written;
+				iov->iov_len -= bytes_written;
+			}
+		}
+		return n;
+	}
+
 	template <class T> long write_number(const T &n)
 	{
 		DCHECK(fd >= 0);
@@ -214,6 +214,12 @@ class WALLogger {
                 return 0;
         }
 
+        // number of epochs the global epoch is ahead of the last epoch this logger made durable
+        virtual uint64_t get_epoch_lag()
+        {
+                return 0;
+        }
+
 	virtual void print_sync_stats(){};
 
 	const std::string filename;
@@ -466,8 +472,9 @@ class PashaGroupCommitLogger : public WALLogger {
                 LOG(INFO) << "logger thread started!";
                 while (stopFlag.load() == false) {
                         if ((Time::now() - last_sync_time) / 1000 >= group_commit_latency_us) {
-                                this->cxl_global_epoch->fetch_add(1);
+                                auto epoch = this->cxl_global_epoch->fetch_add(1);
                                 do_sync();
+                                synced_epoch.store(epoch);
                                 last_sync_time = Time::now();
                         }
                         std::this_thread::sleep_for(std::chrono::microseconds(2));
@@ -544,6 +551,13 @@ class PashaGroupCommitLogger : public WALLogger {
                 file_writer.close();
 	}
 
+        uint64_t get_epoch_lag() override
+        {
+                auto global_epoch = this->cxl_global_epoch->load();
+                auto epoch = synced_epoch.load();
+                return global_epoch > epoch ? global_epoch - epoch : 0;
+        }
+
         void print_sync_stats() override
 	{
                 LOG(INFO) << "Group Commit Stats: "
@@ -571,6 +585,7 @@ class PashaGroupCommitLogger : public WALLogger {
         DirectFileWriter file_writer;
 	std::vector<LockfreeLogBufferQueue *> &log_buffer_queues;
         std::atomic<uint64_t> *cxl_global_epoch{ nullptr };
+        std::atomic<uint64_t> synced_epoch{ 0 };
 	std::size_t group_commit_latency_us{ 0 };
 
         // statistics
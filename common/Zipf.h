@@ -5,39 +5,86 @@
 #pragma once
 
 #include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <glog/logging.h>
 
 namespace star
 {
 
+/*
+ * Zipfian ranks in [0, n), rank k is drawn with probability proportional to 1 / (k + 1)^theta.
+ *
+ * Small key spaces use a Walker/Vose alias table: one uniform, one multiply and one table probe per sample.
+ * Tables are built once per (n, theta) and shared read-only by every Zipf with the same parameters.
+ * Key spaces larger than kAliasTableMaxKeys use rejection-inversion (Hormann and Derflinger), which needs
+ * only a handful of precomputed constants, so init() is O(1) no matter how large n is.
+ *
+ * value() is const and keeps no state, so one Zipf can be shared by all workers.
+ */
 class Zipf {
     public:
+	static constexpr int kAliasTableMaxKeys = 1 << 22;
+
 	void init(int n, double theta)
 	{
+		CHECK(n > 0);
+		CHECK(theta >= 0);
+
 		hasInit = true;
 
 		n_ = n;
 		theta_ = theta;
-		alpha_ = 1.0 / (1.0 - theta_);
-		zetan_ = zeta(n_);
-		eta_ = (1.0 - std::pow(2.0 / n_, 1.0 - theta_)) / (1.0 - zeta(2) / zetan_);
+
+		if (n_ <= kAliasTableMaxKeys) {
+			alias_table_ = get_alias_table(n_, theta_);
+		} else {
+			alias_table_.reset();
+			h_integral_x1_ = h_integral(1.5) - 1.0;
+			h_integral_n_ = h_integral(n_ + 0.5);
+			s_ = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0));
+		}
 	}
 
-	int value(double u)
+	template <class RandomType> int value(RandomType &random) const
 	{
-		CHECK(hasInit);
-
-		double uz = u * zetan_;
-		int v;
-		if (uz < 1) {
-			v = 0;
-		} else if (uz < 1 + std::pow(0.5, theta_)) {
-			v = 1;
-		} else {
-			v = static_cast<int>(n_ * std::pow(eta_ * u - eta_ + 1, alpha_));
+		DCHECK(hasInit);
+
+		if (alias_table_) {
+			return alias_table_->sample(random.next_double());
+		}
+
+		while (true) {
+			double u = h_integral_n_ + random.next_double() * (h_integral_x1_ - h_integral_n_);
+			double x = h_integral_inverse(u);
+			int64_t k = static_cast<int64_t>(x + 0.5);
+			if (k < 1) {
+				k = 1;
+			} else if (k > n_) {
+				k = n_;
+			}
+			// most samples are accepted by the first test without evaluating h
+			if (k - x <= s_ || u >= h_integral(k + 0.5) - h(k)) {
+				DCHECK(k >= 1 && k <= n_);
+				return static_cast<int>(k - 1);
+			}
 		}
-		DCHECK(v >= 0 && v < n_);
-		return v;
+	}
+
+	int size() const
+	{
+		return n_;
+	}
+
+	double theta() const
+	{
+		return theta_;
 	}
 
 	static Zipf &globalZipf()
@@ -52,26 +99,157 @@ class Zipf {
 		return z;
 	}
 
+	// per-partition generators, partition i uses entry i % size(); empty if every partition uses globalZipf()
+	static std::vector<Zipf> &partitionZipfs()
+	{
+		static std::vector<Zipf> zipfs;
+		return zipfs;
+	}
+
+	// thetas is a comma-separated list of skew factors, e.g. "0.99,0.5", assigned to partitions round-robin
+	static void initPartitionZipfs(int n, const std::string &thetas)
+	{
+		auto &zipfs = partitionZipfs();
+		zipfs.clear();
+		std::stringstream ss(thetas);
+		std::string theta;
+		while (std::getline(ss, theta, ',')) {
+			zipfs.emplace_back();
+			zipfs.back().init(n, std::stod(theta));
+		}
+	}
+
+	static const Zipf &zipfForPartition(std::size_t partition_id)
+	{
+		auto &zipfs = partitionZipfs();
+		if (zipfs.empty()) {
+			return globalZipf();
+		}
+		return zipfs[partition_id % zipfs.size()];
+	}
+
     private:
-	double zeta(int n)
+	class AliasTable {
+	    public:
+		AliasTable(int n, double theta)
+			: prob(n)
+			, alias(n)
+		{
+			std::vector<double> weights(n);
+			double sum = 0;
+			for (auto i = 0; i < n; i++) {
+				weights[i] = std::pow(1.0 / (i + 1), theta);
+				sum += weights[i];
+			}
+
+			std::vector<int> small, large;
+			for (auto i = 0; i < n; i++) {
+				weights[i] = weights[i] * n / sum;
+				if (weights[i] < 1.0) {
+					small.push_back(i);
+				} else {
+					large.push_back(i);
+				}
+			}
+
+			while (!small.empty() && !large.empty()) {
+				int s = small.back(), l = large.back();
+				small.pop_back();
+				prob[s] = weights[s];
+				alias[s] = l;
+				weights[l] = (weights[l] + weights[s]) - 1.0;
+				if (weights[l] < 1.0) {
+					large.pop_back();
+					small.push_back(l);
+				}
+			}
+			// leftovers are 1.0 up to rounding
+			for (auto i : large) {
+				prob[i] = 1.0;
+				alias[i] = i;
+			}
+			for (auto i : small) {
+				prob[i] = 1.0;
+				alias[i] = i;
+			}
+		}
+
+		int sample(double u) const
+		{
+			double x = u * prob.size();
+			auto idx = static_cast<std::size_t>(x);
+			if (idx >= prob.size()) {
+				idx = prob.size() - 1;
+			}
+			return x - idx < prob[idx] ? static_cast<int>(idx) : alias[idx];
+		}
+
+	    private:
+		std::vector<float> prob;
+		std::vector<int> alias;
+	};
+
+	static std::shared_ptr<const AliasTable> get_alias_table(int n, double theta)
 	{
-		DCHECK(hasInit);
+		static std::mutex mutex;
+		static std::map<std::pair<int, double>, std::shared_ptr<const AliasTable> > tables;
 
-		double sum = 0;
+		std::lock_guard<std::mutex> guard(mutex);
+		auto &table = tables[std::make_pair(n, theta)];
+		if (!table) {
+			table = std::make_shared<const AliasTable>(n, theta);
+		}
+		return table;
+	}
+
+	// rejection-inversion helpers, x is a 1-based rank
+	double h(double x) const
+	{
+		return std::exp(-theta_ * std::log(x));
+	}
 
-		for (auto i = 1; i <= n; i++) {
-			sum += std::pow(1.0 / i, theta_);
+	double h_integral(double x) const
+	{
+		double log_x = std::log(x);
+		return helper2((1.0 - theta_) * log_x) * log_x;
+	}
+
+	double h_integral_inverse(double x) const
+	{
+		double t = x * (1.0 - theta_);
+		if (t < -1.0) {
+			t = -1.0;
 		}
+		return std::exp(helper1(t) * x);
+	}
 
-		return sum;
+	// log(1 + x) / x, stable around 0
+	static double helper1(double x)
+	{
+		if (std::abs(x) > 1e-8) {
+			return std::log1p(x) / x;
+		}
+		return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+	}
+
+	// (exp(x) - 1) / x, stable around 0
+	static double helper2(double x)
+	{
+		if (std::abs(x) > 1e-8) {
+			return std::expm1(x) / x;
+		}
+		return 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
 	}
 
 	bool hasInit = false;
 
-	int n_;
-	double theta_;
-	double alpha_;
-	double zetan_;
-	double eta_;
+	int n_ = 0;
+	double theta_ = 0;
+
+	std::shared_ptr<const AliasTable> alias_table_;
+
+	double h_integral_x1_ = 0;
+	double h_integral_n_ = 0;
+	double s_ = 0;
 };
 } // namespace star
@@ -4,6 +4,7 @@
 #include <immintrin.h>
 #include <sched.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cstring>
@@ -153,6 +154,66 @@ static inline void prefetch(char *ptr, size_t len)
 	// }
 }
 
+/**
+ * A KeyComparator that orders keys by an unsigned 64-bit prefix first can expose it as
+ * `static uint64_t key_prefix(const KeyType &key)`.
+ * Nodes of such trees keep a dense array of the prefixes of their keys, which lowerBound searches with SIMD compares;
+ * the comparator is only called on keys whose prefix ties with the searched one.
+ */
+template <class KeyComparator, class KeyType, class = void> struct KeyPrefixTraits {
+	static constexpr bool enabled = false;
+
+	static uint64_t get(const KeyType &key)
+	{
+		return 0;
+	}
+};
+
+template <class KeyComparator, class KeyType>
+struct KeyPrefixTraits<KeyComparator, KeyType, decltype((void)KeyComparator::key_prefix(std::declval<const KeyType &>()))> {
+	static constexpr bool enabled = true;
+
+	static uint64_t get(const KeyType &key)
+	{
+		return KeyComparator::key_prefix(key);
+	}
+};
+
+/**
+ * position of the first prefix in the sorted prefixes[0, n) that is not smaller than `prefix`
+ * a branch-free binary search narrows the range down to 16 prefixes, which are counted with SIMD compares
+ */
+static inline unsigned prefixLowerBound(const uint64_t *prefixes, unsigned n, uint64_t prefix)
+{
+	unsigned base = 0;
+	while (n > 16) {
+		unsigned half = n / 2;
+		base = prefixes[base + half] < prefix ? base + half : base;
+		n -= half;
+	}
+
+	unsigned i = 0, pos = base;
+#if defined(__AVX512F__)
+	const __m512i key = _mm512_set1_epi64(prefix);
+	for (; i + 8 <= n; i += 8) {
+		__mmask8 less = _mm512_cmplt_epu64_mask(_mm512_loadu_si512(prefixes + base + i), key);
+		pos += __builtin_popcount(less);
+	}
+#elif defined(__AVX2__)
+	// AVX2 only compares signed integers, flipping the sign bit keeps the unsigned order
+	const __m256i sign = _mm256_set1_epi64x(0x8000000000000000ull);
+	const __m256i key = _mm256_xor_si256(_mm256_set1_epi64x(prefix), sign);
+	for (; i + 4 <= n; i += 4) {
+		__m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(prefixes + base + i)), sign);
+		pos += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(key, v))));
+	}
+#endif
+	for (; i < n; i++) {
+		pos += prefixes[base + i] < prefix;
+	}
+	return pos;
+}
+
 /**
  * class BPlusTree
  * This implementation assumes that KeyType has properly implemented default constructor, copy-constructor, assignment-constructor, destructor.
@@ -169,6 +230,13 @@ class BPlusTree {
 	/** this is the element type of the leaf node */
 	using KeyValuePair = std::pair<KeyType, ValueType>;
 
+	/** the number of keys descending the tree together in lookup_batch */
+	static constexpr std::size_t kLookupBatchSize = 16;
+
+	/** nodes keep the prefixes of their keys if the comparator exposes them, see KeyPrefixTraits */
+	using KeyPrefix = KeyPrefixTraits<KeyComparator, KeyType>;
+	static constexpr uint64_t kKeyPrefixSize = KeyPrefix::enabled ? sizeof(uint64_t) : 0;
+
 	/**
 	 * enum class NodeType - B+ Tree node type
 	 */
@@ -558,12 +626,15 @@ class BPlusTree {
 	 */
 	class BTreeLeaf : public NodeBase {
 	    public:
-		static constexpr uint64_t maxEntries = (LeafPageSize - sizeof(NodeBase) - sizeof(BTreeLeaf *) * 2) / (sizeof(KeyValuePair));
+		static constexpr uint64_t maxEntries = (LeafPageSize - sizeof(NodeBase) - sizeof(BTreeLeaf *) * 2) / (sizeof(KeyValuePair) + kKeyPrefixSize);
 		static_assert(maxEntries >= 3, "maxEntries of BTreeLeaf must >= 3");
 
 		BTreeLeaf *pre_;
 		BTreeLeaf *next_;
 
+		/** prefixes_[i] is the prefix of keys_[i], empty if the comparator has no key prefix */
+		uint64_t prefixes_[KeyPrefix::enabled ? maxEntries : 0];
+
 		/** This is the array that we perform search on */
 		KeyType keys_[maxEntries];
 		ValueType values_[maxEntries];
@@ -610,6 +681,7 @@ class BPlusTree {
 
 			res = true;
 			this->setCount(this->getCount() - 1);
+			updatePrefixes(pos);
 			return res;
 		}
 		/**
@@ -663,6 +735,7 @@ class BPlusTree {
 		void merge(BTreeLeaf *sibling)
 		{
 			assert(hasEnoughSpace(sibling->getCount()));
+			unsigned oldCount = this->getCount();
 			for (uint16_t i = this->getCount(); i < sibling->getCount() + this->getCount(); i++) {
 				new (&keys_[i]) KeyType{ sibling->keys_[i - this->getCount()] }; // Placement new
 				new (&values_[i]) ValueType{ sibling->values_[i - this->getCount()] };
@@ -670,6 +743,7 @@ class BPlusTree {
 				sibling->values_[i - this->getCount()].~ValueType();
 			}
 			this->setCount(this->getCount() + sibling->getCount());
+			updatePrefixes(oldCount);
 			this->next_ = sibling->next_;
                         if (this->next_)
                                 sibling->next_->pre_ = this;
@@ -719,13 +793,30 @@ class BPlusTree {
 					values_[pos] = createValue();
 				}
 				this->setCount(this->getCount() + 1);
+				updatePrefixes(pos);
 				success = true;
 				return values_[pos];
 			}
 		}
 
+		void updatePrefixes(unsigned from)
+		{
+			if (KeyPrefix::enabled) {
+				for (unsigned i = from; i < this->getCount(); i++) {
+					prefixes_[i] = KeyPrefix::get(keys_[i]);
+				}
+			}
+		}
+
 		unsigned lowerBound(const KeyType &k, const KeyComparator &keyComp_)
 		{
+			if (KeyPrefix::enabled) {
+				uint64_t prefix = KeyPrefix::get(k);
+				unsigned pos = prefixLowerBound(prefixes_, this->getCount(), prefix);
+				while (pos < this->getCount() && prefixes_[pos] == prefix && keyComp_(keys_[pos], k) < 0)
+					++pos;
+				return pos;
+			}
 			if (this->getCount() < 128) {
 				int left = 0;
 				while (left < this->getCount() && keyComp_(this->keys_[left], k) < 0)
@@ -805,6 +896,7 @@ class BPlusTree {
 					values_[pos] = v;
 				}
 				this->setCount(this->getCount() + 1);
+				updatePrefixes(pos);
 				success = true;
 				return v;
 			}
@@ -839,6 +931,7 @@ class BPlusTree {
 					values_[pos] = v;
 				}
 				this->setCount(this->getCount() + 1);
+				updatePrefixes(pos);
 				return true;
 			}
 		}
@@ -865,6 +958,7 @@ class BPlusTree {
 				values_[i + this->getCount()].~ValueType(); // call dtor manually
 			}
 
+			newLeaf->updatePrefixes(0);
 			__get_separate_key_in_split(sep);
 
 			return newLeaf;
@@ -898,16 +992,18 @@ class BPlusTree {
 	 */
 	class BTreeInner : public NodeBase {
 	    public:
-		static constexpr uint64_t maxEntries = (InnerPageSize - sizeof(NodeBase)) / (sizeof(KeyType) + sizeof(NodeBase *));
+		static constexpr uint64_t maxEntries = (InnerPageSize - sizeof(NodeBase)) / (kKeyPrefixSize + sizeof(KeyType) + sizeof(NodeBase *));
 		static_assert(maxEntries >= 3, "maxEntries of BTreeInner must >= 3");
 
-		static constexpr uint64_t childOffset = maxEntries * sizeof(KeyType);
+		static constexpr uint64_t keyOffset = maxEntries * kKeyPrefixSize;
+		static constexpr uint64_t childOffset = keyOffset + maxEntries * sizeof(KeyType);
 
 		/**
 		 * Layout of `data_`:
-		 *  -------------------------------------------------------------------
-		 *  | Key 0 | Key 1 | ... | Key N | Child 0 | Child 1 | ... | Child N |
-		 *  -------------------------------------------------------------------
+		 *  ----------------------------------------------------------------------------------------------
+		 *  | Prefix 0 | ... | Prefix N | Key 0 | Key 1 | ... | Key N | Child 0 | Child 1 | ... | Child N |
+		 *  ----------------------------------------------------------------------------------------------
+		 * the prefixes are only there if the comparator has a key prefix
 		 */
 		char data_[0];
 
@@ -918,7 +1014,21 @@ class BPlusTree {
 
 		KeyType &keyAt(size_t i)
 		{
-			return *reinterpret_cast<KeyType *>(reinterpret_cast<intptr_t>(data_) + i * sizeof(KeyType));
+			return *reinterpret_cast<KeyType *>(reinterpret_cast<intptr_t>(data_) + keyOffset + i * sizeof(KeyType));
+		}
+
+		uint64_t *prefixes()
+		{
+			return reinterpret_cast<uint64_t *>(data_);
+		}
+
+		void updatePrefixes(unsigned from)
+		{
+			if (KeyPrefix::enabled) {
+				for (unsigned i = from; i < this->getCount(); i++) {
+					prefixes()[i] = KeyPrefix::get(keyAt(i));
+				}
+			}
 		}
 
 		NodeBase *&childAt(size_t i)
@@ -949,6 +1059,7 @@ class BPlusTree {
 			__adjust_elements_in_erase(pos);
 
 			this->setCount(this->getCount() - 1);
+			updatePrefixes(pos);
 			return this->getCount() == 0;
 		}
 		/**
@@ -993,10 +1104,12 @@ class BPlusTree {
 
 		void merge(BTreeInner *sibling, const KeyType &subTreeMaxKey)
 		{
+			unsigned oldCount = this->getCount();
 			__adjust_elements_in_merge(sibling, subTreeMaxKey);
 
 			this->setCount(this->getCount() + 1);
 			this->setCount(this->getCount() + sibling->getCount());
+			updatePrefixes(oldCount);
 
 			assert(((uint64_t)sibling) != 0xffffffffffffffffull);
 			EBR<UpdateThreshold, Deallocator>::getLocalThreadData().addRetiredNode(sibling);
@@ -1044,6 +1157,7 @@ class BPlusTree {
 			unsigned pos = lowerBound(oldKey, keyComp_);
 			assert(pos >= 0 && pos < this->getCount());
 			keyAt(pos) = newKey;
+			updatePrefixes(pos);
 		}
 
 		__attribute__((deprecated)) void removeKey(const KeyType &key, const KeyComparator &keyComp_)
@@ -1057,6 +1171,7 @@ class BPlusTree {
 
 			memmove(&childAt(pos + 1), &childAt(pos + 2), sizeof(KeyType) * (this->getCount() - pos + 1));
 			setCount(this->getCount() - 1);
+			updatePrefixes(pos);
 		}
 
 		bool hasEnoughSpace(int need)
@@ -1066,6 +1181,13 @@ class BPlusTree {
 
 		unsigned lowerBound(const KeyType &k, const KeyComparator &keyComp_)
 		{
+			if (KeyPrefix::enabled) {
+				uint64_t prefix = KeyPrefix::get(k);
+				unsigned pos = prefixLowerBound(prefixes(), this->getCount(), prefix);
+				while (pos < this->getCount() && prefixes()[pos] == prefix && keyComp_(keyAt(pos), k) < 0)
+					++pos;
+				return pos;
+			}
 			if (this->getCount() < 128) {
 				int left = 0;
 				while (left < this->getCount() && keyComp_(keyAt(left), k) < 0)
@@ -1118,6 +1240,7 @@ class BPlusTree {
 				newInner->newKey(i, keyAt(this->getCount() + 1 + i));
 				keyAt(this->getCount() + 1 + i).~KeyType(); // call dtor manually
 			}
+			newInner->updatePrefixes(0);
 			memcpy(&newInner->childAt(0), &childAt(this->getCount() + 1), sizeof(NodeBase *) * (newInner->getCount() + 1));
 
 			return newInner;
@@ -1148,6 +1271,7 @@ class BPlusTree {
 
 			std::swap(childAt(pos), childAt(pos + 1));
 			this->setCount(this->getCount() + 1);
+			updatePrefixes(pos);
 		}
 
 		/**
@@ -1430,11 +1554,109 @@ class BPlusTree {
 
 		inner->setCount(1);
 		inner->newKey(0, k);
+		inner->updatePrefixes(0);
 		inner->childAt(0) = leftChild;
 		inner->childAt(1) = rightChild;
 		root_ = inner;
 	}
 
+	/**
+	 * class BulkLoader - builds the tree bottom-up from keys appended in ascending order
+	 * Leaves are filled up to fill_factor of their capacity and linked as the keys arrive, the inner
+	 * levels are built over them by finish(). This avoids the root-to-leaf descent and the splits of
+	 * one insert per key, and leaves room for later inserts if fill_factor < 1.
+	 * The tree must be empty and must not be used by anyone else until finish() returns.
+	 */
+	class BulkLoader {
+	    public:
+		BulkLoader(BPlusTree &tree, double fill_factor)
+			: tree_(tree)
+			, leafCapacity_(nodeCapacity(BTreeLeaf::maxEntries, fill_factor, 1))
+			, innerCapacity_(nodeCapacity(BTreeInner::maxEntries, fill_factor, 3))
+		{
+			NodeBase *root = tree_.root_;
+			CHECK(root->getType() == NodeType::BTreeLeaf && root->getCount() == 0) << "bulk loading requires an empty tree";
+			leaf_ = static_cast<BTreeLeaf *>(root);
+		}
+
+		/** returns false if key is not greater than the last appended key */
+		bool append(const KeyType &key, const ValueType &value)
+		{
+			unsigned count = leaf_->getCount();
+			if (count > 0 && tree_.keyComp_(leaf_->keys_[count - 1], key) >= 0) {
+				return false;
+			}
+			if (count == leafCapacity_) {
+				leaf_->updatePrefixes(0);
+				level_.emplace_back(leaf_, leaf_->keys_[count - 1]);
+				char *base = new char[LeafPageSize];
+				auto newLeaf = new (base) BTreeLeaf(); // Placement new
+				newLeaf->pre_ = leaf_;
+				leaf_->next_ = newLeaf;
+				leaf_ = newLeaf;
+				tree_.stats_.leaf_nodes++;
+				count = 0;
+			}
+			new (&leaf_->keys_[count]) KeyType{ key }; // Placement new
+			new (&leaf_->values_[count]) ValueType{ value };
+			leaf_->setCount(count + 1);
+			tree_.stats_.num_items++;
+			return true;
+		}
+
+		void finish()
+		{
+			leaf_->updatePrefixes(0);
+			if (level_.empty()) {
+				// everything fits in the root leaf
+				return;
+			}
+			level_.emplace_back(leaf_, leaf_->keys_[leaf_->getCount() - 1]);
+
+			// key i of an inner node is the max key of child i
+			while (level_.size() > 1) {
+				std::vector<std::pair<NodeBase *, KeyType> > parents;
+				for (std::size_t i = 0; i < level_.size();) {
+					std::size_t n = std::min<std::size_t>(innerCapacity_, level_.size() - i);
+					// never leave a single child to the last node of the level
+					if (level_.size() - i - n == 1) {
+						n--;
+					}
+					char *base = new char[InnerPageSize];
+					auto inner = new (base) BTreeInner(); // Placement new
+					inner->setCount(n - 1);
+					for (std::size_t j = 0; j < n; j++) {
+						inner->childAt(j) = level_[i + j].first;
+						if (j + 1 < n) {
+							inner->newKey(j, level_[i + j].second);
+						}
+					}
+					inner->updatePrefixes(0);
+					tree_.stats_.inner_nodes++;
+					parents.emplace_back(inner, level_[i + n - 1].second);
+					i += n;
+				}
+				level_.swap(parents);
+			}
+			tree_.root_ = level_[0].first;
+		}
+
+	    private:
+		static unsigned nodeCapacity(uint64_t maxEntries, double fill_factor, unsigned minEntries)
+		{
+			CHECK(fill_factor > 0 && fill_factor <= 1);
+			unsigned n = static_cast<unsigned>(maxEntries * fill_factor);
+			return std::min<unsigned>(maxEntries, std::max(n, minEntries));
+		}
+
+		BPlusTree &tree_;
+		unsigned leafCapacity_;
+		unsigned innerCapacity_;
+		BTreeLeaf *leaf_;
+		/** the finished nodes of the level being built, with their max keys */
+		std::vector<std::pair<NodeBase *, KeyType> > level_;
+	};
+
 	void destroy(NodeBase *node)
 	{
 		if (node == nullptr)
@@ -1551,6 +1773,8 @@ class BPlusTree {
 				b->keys_[b->getCount() - 1].~KeyType(); // call dtor manually
 				b->values_[b->getCount() - 1].~ValueType();
 				b->setCount(b->getCount() - 1);
+				a->updatePrefixes(a->getCount() - 1);
+				b->updatePrefixes(0);
 			} else {
 				/*
 				 * right borrow one from left
@@ -1576,9 +1800,11 @@ class BPlusTree {
 					a->keys_[a->getCount() + i].~KeyType();
 					a->values_[a->getCount() + i].~ValueType();
 				}
+				b->updatePrefixes(0);
 			}
 			// adjust parent: replace the parent key which in the `pos`
 			__adjust_parent_in_reallocNode(p, pos, a->max_key());
+			p->updatePrefixes(pos);
 		} else {
 			auto a = static_cast<BTreeInner *>(left);
 			auto b = static_cast<BTreeInner *>(right);
@@ -1607,6 +1833,9 @@ class BPlusTree {
 				}
 				b->keyAt(b->getCount() - 1).~KeyType(); // call dtor manually
 				b->setCount(b->getCount() - 1);
+				a->updatePrefixes(a->getCount() - 1);
+				b->updatePrefixes(0);
+				p->updatePrefixes(pos);
 			} else {
 				/*
 				 * right borrow one from left
@@ -1633,6 +1862,8 @@ class BPlusTree {
 				// adjust left node
 				a->keyAt(a->getCount() - 1).~KeyType();
 				a->setCount(a->getCount() - 1);
+				b->updatePrefixes(0);
+				p->updatePrefixes(pos);
 			}
 		}
 	}
@@ -3165,6 +3396,18 @@ restart:
 		return _lookup(key, result);
 	}
 
+	/**
+	 * find n keys at once, found[i] is true if keys[i] exists and results[i] is its value
+	 * the keys descend the tree level by level in lockstep, the children of all keys are prefetched
+	 * before any of them is visited, so the cache misses of one level overlap
+	 */
+	void lookup_batch(const KeyType *const *keys, ValueType *results, bool *found, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; i += kLookupBatchSize) {
+			_lookup_batch(keys + i, results + i, found + i, std::min(n - i, kLookupBatchSize));
+		}
+	}
+
 	/**
 	 * find key and all its corresponding values
 	 * return true if key exists
@@ -4161,6 +4404,96 @@ restart:
 			goto restart;
 		return success;
 	}
+
+	/**
+	 * find at most kLookupBatchSize keys at once
+	 * the traversal is optimistic, a key whose traversal has to restart is looked up on its own
+	 */
+	void _lookup_batch(const KeyType *const *keys, ValueType *results, bool *found, std::size_t n)
+	{
+		NodeBase *nodes[kLookupBatchSize];
+		uint64_t versions[kLookupBatchSize];
+		BTreeInner *parents[kLookupBatchSize];
+		uint64_t versionParents[kLookupBatchSize];
+		bool descending[kLookupBatchSize];
+		bool restart[kLookupBatchSize];
+		bool needRestart = false;
+
+		NodeBase *root = root_;
+		uint64_t versionRoot = root->readLockOrRestart(needRestart);
+		if (needRestart || (root != root_)) {
+			for (std::size_t i = 0; i < n; i++) {
+				found[i] = _lookup(*keys[i], results[i]);
+			}
+			return;
+		}
+
+		bool root_is_inner = root->getType() == NodeType::BTreeInner;
+		for (std::size_t i = 0; i < n; i++) {
+			nodes[i] = root;
+			versions[i] = versionRoot;
+			descending[i] = root_is_inner;
+			restart[i] = false;
+		}
+
+		bool more = root_is_inner;
+		while (more) {
+			// pick the child of every key and prefetch it
+			for (std::size_t i = 0; i < n; i++) {
+				if (descending[i] == false) {
+					continue;
+				}
+				auto inner = static_cast<BTreeInner *>(nodes[i]);
+				NodeBase *child = inner->childAt(inner->lowerBound(*keys[i], keyComp_));
+				inner->checkOrRestart(versions[i], needRestart);
+				if (needRestart) {
+					descending[i] = false;
+					restart[i] = true;
+					continue;
+				}
+				__builtin_prefetch(child);
+				parents[i] = inner;
+				versionParents[i] = versions[i];
+				nodes[i] = child;
+			}
+
+			// the children are in flight, validate them
+			more = false;
+			for (std::size_t i = 0; i < n; i++) {
+				if (descending[i] == false) {
+					continue;
+				}
+				versions[i] = nodes[i]->readLockOrRestart(needRestart);
+				if (needRestart == false) {
+					parents[i]->readUnlockOrRestart(versionParents[i], needRestart);
+				}
+				if (needRestart) {
+					descending[i] = false;
+					restart[i] = true;
+					continue;
+				}
+				descending[i] = nodes[i]->getType() == NodeType::BTreeInner;
+				more = more || descending[i];
+			}
+		}
+
+		for (std::size_t i = 0; i < n; i++) {
+			if (restart[i] == false) {
+				auto leaf = static_cast<BTreeLeaf *>(nodes[i]);
+				unsigned pos = leaf->lowerBound(*keys[i], keyComp_);
+				found[i] = false;
+				if ((pos < leaf->getCount()) && keyComp_(leaf->keys_[pos], *keys[i]) == 0) {
+					found[i] = true;
+					results[i] = leaf->values_[pos];
+				}
+				leaf->readUnlockOrRestart(versions[i], needRestart);
+				restart[i] = needRestart;
+			}
+			if (restart[i]) {
+				found[i] = _lookup(*keys[i], results[i]);
+			}
+		}
+	}
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+//
+// Transaction arrival times for open-loop load generation
+//
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "common/Random.h"
+
+namespace star
+{
+
+/*
+ * In open-loop mode a worker does not issue its next transaction as soon as the previous one finishes.
+ * Instead, transactions arrive on a schedule at a target rate, independent of how fast they are served.
+ * If the worker falls behind, the intended arrival times do not move, so the delay a transaction spends
+ * waiting for the worker is counted in its latency (no coordinated omission).
+ *
+ * arrival is one of
+ *   "poisson" - exponentially distributed inter-arrival gaps
+ *   "uniform" - evenly spaced arrivals
+ *   a path    - a trace of inter-arrival gaps in microseconds, one per line, replayed in a loop and
+ *               scaled so that its mean rate matches the target rate
+ */
+class ArrivalSchedule {
+    public:
+	using Clock = std::chrono::steady_clock;
+
+	ArrivalSchedule(uint64_t seed)
+		: random(seed)
+	{
+	}
+
+	void init(double tps, const std::string &arrival)
+	{
+		CHECK(tps > 0);
+		mean_gap_ns = 1e9 / tps;
+
+		if (arrival == "poisson") {
+			poisson = true;
+		} else if (arrival == "uniform") {
+			poisson = false;
+		} else {
+			std::ifstream trace(arrival);
+			CHECK(trace.is_open()) << "cannot open arrival trace " << arrival;
+			double gap, sum = 0;
+			while (trace >> gap) {
+				CHECK(gap >= 0);
+				trace_gaps.push_back(gap);
+				sum += gap;
+			}
+			CHECK(trace_gaps.size() > 0 && sum > 0) << "empty arrival trace " << arrival;
+			// rescale the trace to the target rate
+			double scale = mean_gap_ns * trace_gaps.size() / (sum * 1000);
+			for (auto &g : trace_gaps) {
+				g = g * 1000 * scale;
+			}
+		}
+
+		enabled = true;
+		restart();
+	}
+
+	// arrivals are scheduled from now on
+	void restart()
+	{
+		next_arrival = Clock::now();
+	}
+
+	bool is_enabled() const
+	{
+		return enabled;
+	}
+
+	// intended start time of the next transaction
+	Clock::time_point next()
+	{
+		auto arrival = next_arrival;
+		next_arrival += std::chrono::nanoseconds(static_cast<int64_t>(next_gap_ns()));
+		return arrival;
+	}
+
+    private:
+	double next_gap_ns()
+	{
+		if (!trace_gaps.empty()) {
+			auto gap = trace_gaps[trace_pos];
+			trace_pos = (trace_pos + 1) % trace_gaps.size();
+			return gap;
+		}
+		if (poisson) {
+			// next_double() is in [0, 1), 1 - u is in (0, 1]
+			return -std::log(1.0 - random.next_double()) * mean_gap_ns;
+		}
+		return mean_gap_ns;
+	}
+
+	Random random;
+	bool enabled = false;
+	bool poisson = true;
+	double mean_gap_ns = 0;
+	std::vector<double> trace_gaps;
+	std::size_t trace_pos = 0;
+	Clock::time_point next_arrival;
+};
+
+} // namespace star
@@ -4,6 +4,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "common/CCHashTable.h"
 #include "common/btree_olc_cxl/BTreeOLC_CXL.h"
 
@@ -18,10 +24,43 @@ class CXLTableBase {
 
 	virtual void *search(const void *key) = 0;
 
+	// rows[i] is the row of keys[i], or nullptr if keys[i] does not exist
+	virtual void search_batch(const void *const *keys, void **rows, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; i++) {
+			rows[i] = search(keys[i]);
+		}
+	}
+
         virtual void scan(const void *min_key, std::function<bool(const void *, void *, bool)> scan_processor) = 0;
 
 	virtual bool insert(const void *key, void *row, bool is_placeholder = false) = 0;
 
+	// bulk loading of an empty table, the rows are appended in ascending key order between
+	// bulk_load_begin and bulk_load_end; tables without an ordered index just insert them
+	virtual void bulk_load_begin(double fill_factor)
+	{
+	}
+
+	virtual bool bulk_load_append(const void *key, void *row)
+	{
+		return insert(key, row);
+	}
+
+	virtual void bulk_load_end()
+	{
+	}
+
+	// between collect_begin and collect_end, insert only records the rows, and collect_end bulk loads them
+	// in ascending key order; used when all the rows of a partition are moved into an empty table at once
+	virtual void collect_begin()
+	{
+	}
+
+	virtual void collect_end(double fill_factor)
+	{
+	}
+
         virtual bool remove(const void *key, void *row) = 0;
 
 	virtual std::size_t tableID() = 0;
@@ -80,7 +119,97 @@ template <class KeyType> class CXLTableHashMap : public CXLTableBase {
 	std::size_t partitionID_;
 };
 
-template <class KeyType, class KeyComparator> class CXLTableBTreeOLC : public CXLTableBase {
+/*
+ * An immutable secondary index published in the shared region by the host that owns the partition.
+ * Different keys may share a plain key, so the hash table maps a plain key to a chain of entries
+ * that hold the full key and a copy of the value. Only the owner inserts, before any host reads.
+ */
+template <class KeyType, class ValueType> class CXLTableSharedIndex : public CXLTableBase {
+    public:
+	struct Entry {
+		KeyType key;
+		ValueType value;
+		boost::interprocess::offset_ptr<Entry> next;
+	};
+
+	virtual ~CXLTableSharedIndex() override = default;
+
+        CXLTableSharedIndex(CCHashTable *cxl_hashtable, std::size_t tableID, std::size_t partitionID)
+		: cxl_hashtable_(cxl_hashtable)
+                , tableID_(tableID)
+		, partitionID_(partitionID)
+	{
+	}
+
+	// returns the value of the key in the shared region
+	virtual void *search(const void *key) override
+        {
+                const auto &k = *static_cast<const KeyType *>(key);
+                Entry *entry = reinterpret_cast<Entry *>(cxl_hashtable_->search(k.get_plain_key()));
+                while (entry != nullptr && entry->key != k) {
+                        entry = entry->next.get();
+                }
+                return entry == nullptr ? nullptr : &entry->value;
+        }
+
+        virtual void scan(const void *min_key, std::function<bool(const void *, void *, bool)> scan_processor) override
+        {
+                CHECK(0);
+        }
+
+	// row points to the value to copy
+	virtual bool insert(const void *key, void *row, bool is_placeholder = false) override
+        {
+                CHECK(is_placeholder == false);
+                const auto &k = *static_cast<const KeyType *>(key);
+                CHECK(search(key) == nullptr);
+
+                Entry *entry = reinterpret_cast<Entry *>(cxl_memory.cxlalloc_malloc_wrapper(sizeof(Entry), CXLMemory::INDEX_ALLOCATION));
+                new (entry) Entry();
+                entry->key = k;
+                entry->value = *static_cast<const ValueType *>(row);
+                entry->next = nullptr;
+
+                Entry *head = reinterpret_cast<Entry *>(cxl_hashtable_->search(k.get_plain_key()));
+                if (head == nullptr) {
+                        return cxl_hashtable_->insert(k.get_plain_key(), reinterpret_cast<char *>(entry));
+                }
+                entry->next = head->next;
+                head->next = entry;
+                return true;
+        }
+
+        virtual bool remove(const void *key, void *row) override
+        {
+                CHECK(0);
+        }
+
+	virtual std::size_t tableID() override
+        {
+                return tableID_;
+        }
+
+	virtual std::size_t partitionID() override
+        {
+                return partitionID_;
+        }
+
+    private:
+	CCHashTable *cxl_hashtable_;
+	std::size_t tableID_;
+	std::size_t partitionID_;
+};
+
+/*
+ * Node formats of the CXL B-tree, chosen per table. The index lives in the hardware cache-coherent region,
+ * so a smaller index leaves more of hw_cc_budget to rows.
+ *   Default - 64-bit key prefixes, a row is an offset_ptr plus a validity flag (16 bytes)
+ *   Compact - 32-bit key prefixes (larger ones saturate), a row is a 48-bit heap offset with the validity
+ *             flag in a spare bit (8 bytes)
+ */
+enum class CXLBTreeNodeFormat { Default, Compact };
+
+template <class KeyType, class KeyComparator, CXLBTreeNodeFormat NodeFormat = CXLBTreeNodeFormat::Default> class CXLTableBTreeOLC : public CXLTableBase {
     public:
         static constexpr uint64_t update_threshold = 1024;
         static constexpr uint64_t leaf_page_size = 4096;
@@ -88,37 +217,104 @@ template <class KeyType, class KeyComparator> class CXLTableBTreeOLC : public CX
 
         // std::atomic has implicitly deleted copy-constructor
         // so we need to define a ValueType that supports it
-        struct BTreeOLCValue {
-                BTreeOLCValue() = default;
+        struct OffsetPtrValue {
+                OffsetPtrValue() = default;
 
-                BTreeOLCValue(const BTreeOLCValue &value)
+                OffsetPtrValue(const OffsetPtrValue &value)
                 {
                         this->row = value.row.get();
                         this->is_valid.store(value.is_valid.load());
                 }
 
-                BTreeOLCValue &operator=(const BTreeOLCValue &value)
+                OffsetPtrValue &operator=(const OffsetPtrValue &value)
                 {
                         this->row = value.row.get();
                         this->is_valid.store(value.is_valid.load());
                         return *this;
                 }
 
+                void *get_row() const
+                {
+                        return row.get();
+                }
+
+                bool valid() const
+                {
+                        return is_valid.load();
+                }
+
+                void set(void *row, bool is_valid)
+                {
+                        this->row = row;
+                        this->is_valid.store(is_valid);
+                }
+
                 boost::interprocess::offset_ptr<void> row{ nullptr };
                 std::atomic<bool> is_valid{ false };
         };
 
+        // the offset is relative to the cxlalloc heap rather than to the value itself,
+        // so unlike offset_ptr the value stays correct when it is copied as raw bytes
+        struct PackedValue {
+                static constexpr uint64_t kOffsetMask = (1ull << 48) - 1;
+                static constexpr uint64_t kValidBit = 1ull << 63;
+
+                PackedValue() = default;
+
+                PackedValue(const PackedValue &value)
+                {
+                        this->word.store(value.word.load());
+                }
+
+                PackedValue &operator=(const PackedValue &value)
+                {
+                        this->word.store(value.word.load());
+                        return *this;
+                }
+
+                void *get_row() const
+                {
+                        // offset + 1 is stored, 0 is the null row
+                        uint64_t offset = word.load() & kOffsetMask;
+                        return offset == 0 ? nullptr : cxlalloc_offset_to_pointer(offset - 1);
+                }
+
+                bool valid() const
+                {
+                        return (word.load() & kValidBit) != 0;
+                }
+
+                void set(void *row, bool is_valid)
+                {
+                        uint64_t offset = 0;
+                        if (row != nullptr) {
+                                bool ret = cxlalloc_pointer_to_offset(row, &offset);
+                                CHECK(ret == true);
+                                CHECK(offset < kOffsetMask);
+                                offset++;
+                        }
+                        this->word.store(offset | (is_valid ? kValidBit : 0));
+                }
+
+                std::atomic<uint64_t> word{ 0 };
+        };
+
+        static constexpr bool is_compact = NodeFormat == CXLBTreeNodeFormat::Compact;
+
+        using BTreeOLCValue = typename std::conditional<is_compact, PackedValue, OffsetPtrValue>::type;
+        using KeyPrefixType = typename std::conditional<is_compact, uint32_t, uint64_t>::type;
+
         struct BTreeOLCValueComparator {
                 int operator()(const BTreeOLCValue &a, const BTreeOLCValue &b) const
                 {
-                        if (a.row.get() == b.row.get())
+                        if (a.get_row() == b.get_row())
                                 return 0;
                         else
                                 return 1;
                 }
         };
 
-        using CXLBTree = btreeolc_cxl::BPlusTree<KeyType, BTreeOLCValue, KeyComparator, BTreeOLCValueComparator, update_threshold, leaf_page_size, inner_page_size>;
+        using CXLBTree = btreeolc_cxl::BPlusTree<KeyType, BTreeOLCValue, KeyComparator, BTreeOLCValueComparator, update_threshold, leaf_page_size, inner_page_size, KeyPrefixType>;
 
 	virtual ~CXLTableBTreeOLC() override = default;
 
@@ -137,19 +333,43 @@ template <class KeyType, class KeyComparator> class CXLTableBTreeOLC : public CX
                 bool success = cxl_btree_->lookup(k, value);
 
                 if (success == true) {
-                        CHECK(value.is_valid == true);
-                        return value.row.get();
+                        CHECK(value.valid() == true);
+                        return value.get_row();
                 } else {
                         return nullptr;
                 }
         }
 
+        // the keys descend the index together, see BPlusTree::lookup_batch
+	virtual void search_batch(const void *const *keys, void **rows, std::size_t n) override
+        {
+                const KeyType *k[CXLBTree::kLookupBatchSize];
+                BTreeOLCValue values[CXLBTree::kLookupBatchSize];
+                bool found[CXLBTree::kLookupBatchSize];
+
+                for (std::size_t i = 0; i < n; i += CXLBTree::kLookupBatchSize) {
+                        std::size_t batch_size = std::min(n - i, CXLBTree::kLookupBatchSize);
+                        for (std::size_t j = 0; j < batch_size; j++) {
+                                k[j] = static_cast<const KeyType *>(keys[i + j]);
+                        }
+                        cxl_btree_->lookup_batch(k, values, found, batch_size);
+                        for (std::size_t j = 0; j < batch_size; j++) {
+                                if (found[j] == true) {
+                                        CHECK(values[j].valid() == true);
+                                        rows[i + j] = values[j].get_row();
+                                } else {
+                                        rows[i + j] = nullptr;
+                                }
+                        }
+                }
+        }
+
         virtual void scan(const void *min_key, std::function<bool(const void *, void *, bool)> scan_processor) override
         {
                 const auto &min_k = *static_cast<const KeyType *>(min_key);
 
                 auto processor = [&](const KeyType &key, BTreeOLCValue &value, bool is_last_tuple) -> bool {
-                        bool should_end = scan_processor(&key, value.row.get(), is_last_tuple);
+                        bool should_end = scan_processor(&key, value.get_row(), is_last_tuple);
 
                         if (should_end == false) {
                                 return false;
@@ -165,17 +385,70 @@ template <class KeyType, class KeyComparator> class CXLTableBTreeOLC : public CX
         {
                 const auto &k = *static_cast<const KeyType *>(key);
 
+                if (collecting_ == true) {
+                        CHECK(is_placeholder == false);
+                        collected_rows_.emplace_back(k, row);
+                        return true;
+                }
+
                 BTreeOLCValue value;
-                value.row = row;
-                if (is_placeholder == true)
-                        value.is_valid.store(false);
-                else
-                        value.is_valid.store(true);
+                value.set(row, !is_placeholder);
 
 		bool success = cxl_btree_->insert(k, value);
 		return success;
         }
 
+        // the tree is built bottom-up in CXL memory, see BPlusTree::BulkLoader
+        virtual void bulk_load_begin(double fill_factor) override
+        {
+                CHECK(bulk_loader_ == nullptr);
+                bulk_loader_.reset(new typename CXLBTree::BulkLoader(*cxl_btree_, fill_factor));
+        }
+
+        virtual bool bulk_load_append(const void *key, void *row) override
+        {
+                DCHECK(bulk_loader_ != nullptr);
+                const auto &k = *static_cast<const KeyType *>(key);
+
+                BTreeOLCValue value;
+                value.set(row, true);
+
+                return bulk_loader_->append(k, value);
+        }
+
+        virtual void bulk_load_end() override
+        {
+                CHECK(bulk_loader_ != nullptr);
+                bulk_loader_->finish();
+                bulk_loader_.reset();
+        }
+
+        virtual void collect_begin() override
+        {
+                CHECK(collecting_ == false && bulk_loader_ == nullptr);
+                collecting_ = true;
+        }
+
+        virtual void collect_end(double fill_factor) override
+        {
+                CHECK(collecting_ == true);
+                collecting_ = false;
+                if (collected_rows_.empty()) {
+                        return;
+                }
+
+                std::sort(collected_rows_.begin(), collected_rows_.end(),
+                          [](const std::pair<KeyType, void *> &a, const std::pair<KeyType, void *> &b) { return KeyComparator()(a.first, b.first) < 0; });
+                bulk_load_begin(fill_factor);
+                for (auto &collected_row : collected_rows_) {
+                        bool success = bulk_load_append(&collected_row.first, collected_row.second);
+                        CHECK(success == true);
+                }
+                bulk_load_end();
+
+                std::vector<std::pair<KeyType, void *> >().swap(collected_rows_);
+        }
+
         virtual bool remove(const void *key, void *row) override
         {
                 const auto &k = *static_cast<const KeyType *>(key);
@@ -200,6 +473,9 @@ template <class KeyType, class KeyComparator> class CXLTableBTreeOLC : public CX
 	CXLBTree *cxl_btree_;
 	std::size_t tableID_;
 	std::size_t partitionID_;
+	std::unique_ptr<typename CXLBTree::BulkLoader> bulk_loader_;
+	bool collecting_ = false;
+	std::vector<std::pair<KeyType, void *> > collected_rows_;
 };
 
 } // namespace star
@@ -73,6 +73,7 @@ class Context {
 	bool parallel_locking_and_validation = true;
 
 	bool calvin_same_batch = false;
+	bool calvin_cxl = false;
 
 	bool kiva_read_only_optmization = true;
 	bool kiva_reordering_optmization = true;
@@ -82,6 +83,7 @@ class Context {
 	bool aria_read_only_optmization = true;
 	bool aria_reordering_optmization = false;
 	bool aria_snapshot_isolation = false;
+	bool aria_cxl = false;
 
 	std::vector<std::string> peers;
 	int stragglers_per_batch = 0;
@@ -102,6 +104,8 @@ class Context {
         bool use_output_thread = false;
         uint64_t cxl_trans_entry_struct_size = 8192;
         uint64_t cxl_trans_entry_num = 4096;
+        bool cxl_worker_lanes = false;
+        uint64_t cxl_lane_entry_num = 256;
 
         // Pasha migration policy
         bool enable_migration_optimization = true;
@@ -113,15 +117,36 @@ class Context {
         bool enable_scc = true;
         std::string scc_mechanism;
 
+        // fraction of a B-tree node filled by bulk loading, the rest is left for later inserts
+        double btree_fill_factor = 1.0;
+
         // Pasha ablation study
         bool enable_phantom_detection = true;
         bool model_cxl_search_overhead = false;
 
+        // TwoPLPasha sends the lock requests of remote rows before locking (and prefetching) local rows
+        bool enable_row_prefetch = false;
+
+        // TwoPLPasha lock conflicts: "NoWait" aborts at once, "WaitDie" lets older transactions wait for younger lock holders
+        std::string lock_wait_policy = "NoWait";
+        uint64_t lock_wait_spins = 1000;        // attempts before a waiting transaction gives up and aborts
+
+        // TwoPLPasha reads rows without read locks until a transaction asks for a write, and validates their versions at commit
+        bool enable_optimistic_reads = false;
+
         // general
         int time_to_run = 30;
         int time_to_warmup = 10;
 
         // pre-migrate
         std::string pre_migrate;
+
+        // per-interval metrics export, disabled if empty
+        std::string metrics_path;
+        std::string metrics_format = "csv";
+
+        // open-loop load generation, 0 runs closed-loop
+        uint64_t open_loop_tps = 0;     // target arrival rate per host
+        std::string open_loop_arrival = "poisson";
 };
 } // namespace star
@@ -8,10 +8,16 @@
 #include "common/Message.h"
 #include "common/MessagePiece.h"
 
+#include <utility>
+#include <vector>
+
 namespace star
 {
 
-enum class ControlMessage { STATISTICS, SIGNAL, ACK, STOP, NFIELDS };
+enum class ControlMessage { STATISTICS, SIGNAL, ACK, STOP, LATENCY, METRICS, NFIELDS };
+
+// the histograms a coordinator sends in LATENCY messages, the last two only in open-loop runs
+enum class LatencyHistogram { COMMIT, OPEN_LOOP, QUEUEING_DELAY, NFIELDS };
 
 class ControlMessageFactory {
     public:
@@ -36,6 +42,64 @@ class ControlMessageFactory {
 		return message_size;
 	}
 
+	static std::size_t new_latency_message(Message &message, int coordinator_id, LatencyHistogram histogram, bool last, uint64_t sum, uint64_t min,
+					       uint64_t max, const std::vector<std::pair<uint32_t, uint64_t> > &buckets)
+	{
+		/*
+		 * The structure of a latency message: (coordinator id : int, histogram : uint32_t, last : bool, sum, min, max : uint64_t,
+		 * bucket count : uint32_t, (bucket index : uint32_t, count : uint64_t) ...)
+		 *
+		 * A histogram may not fit into a single message, the coordinator sends it in several messages
+		 * and only the last one carries the summary.
+		 */
+
+		auto message_size = MessagePiece::get_header_size() + sizeof(coordinator_id) + sizeof(uint32_t) + sizeof(last) + sizeof(sum) + sizeof(min) +
+				    sizeof(max) + sizeof(uint32_t) + buckets.size() * (sizeof(uint32_t) + sizeof(uint64_t));
+		auto message_piece_header = MessagePiece::construct_message_piece_header(static_cast<uint32_t>(ControlMessage::LATENCY), message_size, 0, 0);
+
+		Encoder encoder(message.data);
+		encoder << message_piece_header;
+		encoder << coordinator_id << static_cast<uint32_t>(histogram) << last << sum << min << max << static_cast<uint32_t>(buckets.size());
+		for (auto &bucket : buckets) {
+			encoder << bucket.first << bucket.second;
+		}
+		message.flush();
+		message.set_gen_time(Time::now());
+		return message_size;
+	}
+
+	static std::size_t new_metrics_message(Message &message, int coordinator_id, uint32_t interval, bool last, const std::vector<uint64_t> &values,
+					       uint64_t sum, uint64_t min, uint64_t max, const std::vector<std::pair<uint32_t, uint64_t> > &buckets)
+	{
+		/*
+		 * The structure of a metrics message: (coordinator id : int, interval : uint32_t, last : bool,
+		 * value count : uint32_t, value : uint64_t ..., latency sum, min, max : uint64_t,
+		 * bucket count : uint32_t, (bucket index : uint32_t, count : uint64_t) ...)
+		 *
+		 * Like a latency message, the histogram of an interval may span several messages;
+		 * the values and the summary are only meaningful in the last one.
+		 */
+
+		auto message_size = MessagePiece::get_header_size() + sizeof(coordinator_id) + sizeof(interval) + sizeof(last) + sizeof(uint32_t) +
+				    values.size() * sizeof(uint64_t) + sizeof(sum) + sizeof(min) + sizeof(max) + sizeof(uint32_t) +
+				    buckets.size() * (sizeof(uint32_t) + sizeof(uint64_t));
+		auto message_piece_header = MessagePiece::construct_message_piece_header(static_cast<uint32_t>(ControlMessage::METRICS), message_size, 0, 0);
+
+		Encoder encoder(message.data);
+		encoder << message_piece_header;
+		encoder << coordinator_id << interval << last << static_cast<uint32_t>(values.size());
+		for (auto value : values) {
+			encoder << value;
+		}
+		encoder << sum << min << max << static_cast<uint32_t>(buckets.size());
+		for (auto &bucket : buckets) {
+			encoder << bucket.first << bucket.second;
+		}
+		message.flush();
+		message.set_gen_time(Time::now());
+		return message_size;
+	}
+
 	static std::size_t new_signal_message(Message &message, uint32_t value)
 	{
 		/*
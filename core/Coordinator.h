@@ -14,6 +14,7 @@
 #include "core/ControlMessage.h"
 #include "core/Dispatcher.h"
 #include "core/Executor.h"
+#include "core/MetricsSink.h"
 #include "core/Worker.h"
 #include "core/factory/WorkerFactory.h"
 #include <boost/algorithm/string.hpp>
@@ -109,6 +110,24 @@ class Coordinator {
 			inSockets[i].resize(peers.size());
 			outSockets[i].resize(peers.size());
 		}
+
+                // the latency histogram is gathered at shutdown in chunks of transport entries
+                if (context.use_cxl_transport) {
+                        Message empty_message;
+                        ControlMessageFactory::new_latency_message(empty_message, id, LatencyHistogram::COMMIT, true, 0, 0, 0, {});
+                        histogram_buckets_per_message(empty_message.get_message_length());
+                }
+
+                // init metrics export, every host writes its own file
+                if (context.metrics_path != "") {
+                        metrics_sink = std::make_unique<MetricsSink>(context.metrics_path + "." + std::to_string(id), context.metrics_format, id, coordinator_num);
+                        if (context.use_cxl_transport) {
+                                // every interval ships its histogram in METRICS messages next to the values of the record
+                                Message empty_message;
+                                ControlMessageFactory::new_metrics_message(empty_message, id, 0, true, std::vector<uint64_t>(kMaxMetricsValues), 0, 0, 0, {});
+                                histogram_buckets_per_message(empty_message.get_message_length());
+                        }
+                }
 	}
 
 	~Coordinator() = default;
@@ -232,6 +251,7 @@ class Coordinator {
                          total_local_access = 0, total_local_cxl_access = 0, total_remote_access = 0, total_remote_access_with_req = 0,
                          total_data_move_in = 0, total_data_move_out = 0;
 		int count = 0;
+		uint64_t last_scc_cache_hit = 0, last_scc_cache_miss = 0;
 
 		do {
 			std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -321,6 +341,37 @@ class Coordinator {
                                   << ", data_move_in: " << n_data_move_in
                                   << ", data_move_out: " << n_data_move_out;
 			count++;
+
+			if (metrics_sink != nullptr) {
+				uint64_t scc_cache_hit = scc_manager != nullptr ? scc_manager->get_num_cache_hit() : 0;
+				uint64_t scc_cache_miss = scc_manager != nullptr ? scc_manager->get_num_cache_miss() : 0;
+
+				MetricsRecord record;
+				record.add("interval", count, MetricsRecord::Merge::MAX);
+				record.add("time_ms", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count(),
+					   MetricsRecord::Merge::MAX);
+				record.add("commit", n_commit);
+				record.add("abort_no_retry", n_abort_no_retry);
+				record.add("abort_lock", n_abort_lock);
+				record.add("abort_read_validation", n_abort_read_validation);
+				record.add("network_size", n_network_size);
+				record.add("local_access", n_local_access);
+				record.add("local_cxl_access", n_local_cxl_access);
+				record.add("remote_access", n_remote_access);
+				record.add("remote_access_with_req", n_remote_access_with_req);
+				record.add("data_move_in", n_data_move_in);
+				record.add("data_move_out", n_data_move_out);
+				record.add("scc_cache_hit", scc_cache_hit - last_scc_cache_hit);
+				record.add("scc_cache_miss", scc_cache_miss - last_scc_cache_miss);
+				record.add("hw_cc_usage", cxl_memory.get_stats(CXLMemory::TOTAL_HW_CC_USAGE));
+				record.add("transport_queue_depth", context.use_cxl_transport ? cxl_transport->queue_depth(id) : 0);
+				record.add("logger_epoch_lag", context.master_logger != nullptr ? context.master_logger->get_epoch_lag() : 0,
+					   MetricsRecord::Merge::MAX);
+				export_metrics(count, record);
+
+				last_scc_cache_hit = scc_cache_hit;
+				last_scc_cache_miss = scc_cache_miss;
+			}
 			if (count > warmup && count <= timeToRun - cooldown) {
 				warmed_up = true;
 				total_commit += n_commit;
@@ -358,9 +409,12 @@ class Coordinator {
 
 		workerStopFlag.store(true);
 
+		Percentile<int64_t> latency, open_loop_latency, queueing_delay;
 		for (auto i = 0u; i < threads.size(); i++) {
 			workers[i]->onExit();
 			threads[i].join();
+			workers[i]->collect_latency(latency);
+			workers[i]->collect_open_loop_latency(open_loop_latency, queueing_delay);
 		}
 
                 // print CXL memory usage
@@ -377,7 +431,8 @@ class Coordinator {
                                 cxl_memory.get_stats(CXLMemory::DATA_USAGE),
                                 cxl_memory.get_stats(CXLMemory::TRANSPORT_USAGE),
                                 cxl_memory.get_stats(CXLMemory::MISC_USAGE),
-                                cxl_memory.get_stats(CXLMemory::TOTAL_HW_CC_USAGE));
+                                cxl_memory.get_stats(CXLMemory::TOTAL_HW_CC_USAGE),
+                                latency, open_loop_latency, queueing_delay);
 
 		// make sure all messages are sent
 		std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -411,24 +466,45 @@ class Coordinator {
         {
                 int i = 0;
                 void *tmp = NULL;
+                // one receive ring per host and i/o thread, followed by one lane per host and worker if enabled
+                uint64_t lanes_per_node = context.cxl_worker_lanes ? context.worker_num : 0;
+                auto ring_num = coordinator_num * context.io_thread_num;
+                auto lane_num = coordinator_num * lanes_per_node;
+                CXLTransport::Layout *layout = nullptr;
 
                 if (id == 0) {
-                        cxl_ringbuffers = reinterpret_cast<MPSCRingBuffer *>(cxl_memory.cxlalloc_malloc_wrapper(sizeof(MPSCRingBuffer) * coordinator_num, 
+                        layout = reinterpret_cast<CXLTransport::Layout *>(cxl_memory.cxlalloc_malloc_wrapper(sizeof(CXLTransport::Layout) + sizeof(MPSCRingBuffer) * (ring_num + lane_num),
                                 CXLMemory::TRANSPORT_ALLOCATION));
-                        for (i = 0; i < coordinator_num; i++)
+                        layout->node_num = coordinator_num;
+                        layout->rings_per_node = context.io_thread_num;
+                        layout->lanes_per_node = lanes_per_node;
+                        cxl_ringbuffers = layout->get_ringbuffers();
+                        for (i = 0; i < ring_num; i++)
                                 new(&cxl_ringbuffers[i]) MPSCRingBuffer(context.cxl_trans_entry_struct_size, context.cxl_trans_entry_num);
-                        cxl_transport = new CXLTransport(cxl_ringbuffers);
-                        CXLMemory::commit_shared_data_initialization(CXLMemory::cxl_transport_root_index, cxl_ringbuffers);
+                        for (i = ring_num; i < ring_num + lane_num; i++)
+                                new(&cxl_ringbuffers[i]) MPSCRingBuffer(context.cxl_trans_entry_struct_size, context.cxl_lane_entry_num);
+                        CXLMemory::commit_shared_data_initialization(CXLMemory::cxl_transport_root_index, layout);
                         LOG(INFO) << "Coordinator " << id << " initializes CXL transport metadata ("
-                                << coordinator_num << " ringbuffers each with " << cxl_ringbuffers[0].get_entry_num() << " entries (each "
-                                << cxl_ringbuffers[0].get_entry_size() << " Bytes)";
+                                << ring_num << " ringbuffers each with " << cxl_ringbuffers[0].get_entry_num() << " entries (each "
+                                << cxl_ringbuffers[0].get_entry_size() << " Bytes), " << lane_num << " worker lanes)";
                 } else {
                         CXLMemory::wait_and_retrieve_cxl_shared_data(CXLMemory::cxl_transport_root_index, &tmp);
-                        cxl_ringbuffers = reinterpret_cast<MPSCRingBuffer *>(tmp);
-                        cxl_transport = new CXLTransport(cxl_ringbuffers);
+                        layout = reinterpret_cast<CXLTransport::Layout *>(tmp);
+                        // a different layout would make this host index the wrong rings or run past their end
+                        CHECK(layout->node_num == coordinator_num) << "coordinator 0 runs with " << layout->node_num << " coordinators";
+                        CHECK(layout->rings_per_node == context.io_thread_num) << "coordinator 0 runs with io_thread_num = " << layout->rings_per_node;
+                        CHECK(layout->lanes_per_node == lanes_per_node)
+                                << "coordinator 0 runs with " << layout->lanes_per_node << " worker lanes per host, this host needs " << lanes_per_node;
+                        cxl_ringbuffers = layout->get_ringbuffers();
                         LOG(INFO) << "Coordinator " << id << " retrives CXL transport metadata ("
-                                << coordinator_num << " ringbuffers each with " << cxl_ringbuffers[0].get_entry_num() << " entries (each "
-                                << cxl_ringbuffers[0].get_entry_size() << " Bytes)";
+                                << ring_num << " ringbuffers each with " << cxl_ringbuffers[0].get_entry_num() << " entries (each "
+                                << cxl_ringbuffers[0].get_entry_size() << " Bytes), " << lane_num << " worker lanes)";
+                }
+
+                if (lane_num > 0) {
+                        cxl_transport = new CXLTransport(cxl_ringbuffers, context.io_thread_num, cxl_ringbuffers + ring_num, context.worker_num);
+                } else {
+                        cxl_transport = new CXLTransport(cxl_ringbuffers, context.io_thread_num);
                 }
         }
 
@@ -543,7 +619,8 @@ class Coordinator {
 		LOG(INFO) << "Coordinator " << id << " connected to all peers.";
 	}
 
-	void gather_and_print(double commit, uint64_t size_index_usage, uint64_t size_metadata_usage, uint64_t size_data_usage, uint64_t size_transport_usage, uint64_t size_misc_usage, uint64_t size_hwcc_usage)
+	void gather_and_print(double commit, uint64_t size_index_usage, uint64_t size_metadata_usage, uint64_t size_data_usage, uint64_t size_transport_usage, uint64_t size_misc_usage, uint64_t size_hwcc_usage,
+			      Percentile<int64_t> &latency, Percentile<int64_t> &open_loop_latency, Percentile<int64_t> &queueing_delay)
 	{
 		auto init_message = [](Message *message, std::size_t coordinator_id, std::size_t dest_node_id) {
 			message->set_source_node_id(coordinator_id);
@@ -553,9 +630,15 @@ class Coordinator {
 
 		double replica_sum = 0;
 
+		// indexed by LatencyHistogram, the open-loop histograms are only gathered in open-loop runs
+		Percentile<int64_t> *histograms[] = { &latency, &open_loop_latency, &queueing_delay };
+		std::size_t n_histograms = context.open_loop_tps > 0 ? 3 : 1;
+
 		if (id == 0) {
 			auto partitioner = PartitionerFactory::create_partitioner(context.partitioner, id, context.coordinator_num);
-			for (std::size_t i = 0; i < coordinator_num - 1; i++) {
+			// every other coordinator sends one statistics message and each of its latency histograms in one or more messages
+			std::size_t n_statistics = 0, n_latency = 0;
+			while (n_statistics < coordinator_num - 1 || n_latency < (coordinator_num - 1) * n_histograms) {
 				in_queue.wait_till_non_empty();
 				std::unique_ptr<Message> message(in_queue.front());
 				bool ok = in_queue.pop();
@@ -564,7 +647,23 @@ class Coordinator {
 
 				MessagePiece messagePiece = *(message->begin());
 
+				if (messagePiece.get_message_type() == static_cast<uint32_t>(ControlMessage::METRICS)) {
+					// a late per-interval report
+					if (metrics_sink != nullptr) {
+						merge_metrics_message(messagePiece);
+					}
+					continue;
+				}
+
+				if (messagePiece.get_message_type() == static_cast<uint32_t>(ControlMessage::LATENCY)) {
+					if (merge_latency_message(messagePiece, histograms)) {
+						n_latency++;
+					}
+					continue;
+				}
+
 				CHECK(messagePiece.get_message_type() == static_cast<uint32_t>(ControlMessage::STATISTICS));
+				n_statistics++;
 				CHECK(messagePiece.get_message_length() == MessagePiece::get_header_size() + sizeof(int) + sizeof(double) + 6 * sizeof(uint64_t));
 				Decoder dec(messagePiece.toStringPiece());
 				int coordinator_id;
@@ -592,13 +691,14 @@ class Coordinator {
 			auto message = std::make_unique<Message>();
 			init_message(message.get(), id, 0);
 			ControlMessageFactory::new_statistics_message(*message, id, commit, size_index_usage, size_metadata_usage, size_data_usage, size_transport_usage, size_misc_usage, size_hwcc_usage);
-                        if (context.use_output_thread == true) {
-			        out_queue.push(message.release());
-                                // message is reclaimed by the output thread
-                        } else {
-                                cxl_transport->send(message.get());
-                                // must reclaim the message here - otherwise memory leakage would occur
-                                // we do it by not releasing it
+                        send_control_message(std::move(message));
+
+                        for (auto i = 0u; i < n_histograms; i++) {
+                                auto &histogram = *histograms[i];
+                                send_histogram(histogram, [&](Message &message, const std::vector<std::pair<uint32_t, uint64_t> > &buckets, bool last) {
+                                        ControlMessageFactory::new_latency_message(message, id, static_cast<LatencyHistogram>(i), last, histogram.raw_sum(),
+                                                                                   histogram.raw_min(), histogram.raw_max(), buckets);
+                                });
                         }
 		}
 		if (context.partitioner == "hpb") {
@@ -616,9 +716,167 @@ class Coordinator {
                                   << " total_size_misc_usage: " << size_misc_usage
                                   << " total_hw_cc_usage: " << size_hwcc_usage
                                   << " total_usage: " << size_index_usage + size_metadata_usage + size_data_usage + size_transport_usage + size_misc_usage;
+                        LOG(INFO) << "Global Latency:"
+                                  << " committed_txns: " << latency.size()
+                                  << " p50: " << latency.nth(50)
+                                  << " p90: " << latency.nth(90)
+                                  << " p99: " << latency.nth(99)
+                                  << " p99.9: " << latency.nth(99.9)
+                                  << " p99.99: " << latency.nth(99.99)
+                                  << " max: " << latency.max()
+                                  << " avg: " << latency.avg() << " (us)";
+                        if (context.open_loop_tps > 0) {
+                                LOG(INFO) << "Global Open-loop Latency:"
+                                          << " p50: " << open_loop_latency.nth(50)
+                                          << " p90: " << open_loop_latency.nth(90)
+                                          << " p99: " << open_loop_latency.nth(99)
+                                          << " p99.9: " << open_loop_latency.nth(99.9)
+                                          << " max: " << open_loop_latency.max()
+                                          << " avg: " << open_loop_latency.avg() << " (us)"
+                                          << " queueing delay p50: " << queueing_delay.nth(50)
+                                          << " p99: " << queueing_delay.nth(99)
+                                          << " avg: " << queueing_delay.avg() << " (us)";
+                        }
                 }
 	}
 
+        void send_control_message(std::unique_ptr<Message> message)
+        {
+                if (context.use_output_thread == true) {
+                        out_queue.push(message.release());
+                        // message is reclaimed by the output thread
+                } else {
+                        // coordinator messages are handled by the incoming dispatcher of group 0
+                        cxl_transport->send(message.get(), 0);
+                        // must reclaim the message here - otherwise memory leakage would occur
+                        // we do it by not releasing it
+                }
+        }
+
+        static constexpr std::size_t kHistogramBucketSize = sizeof(uint32_t) + sizeof(uint64_t);
+        static constexpr std::size_t kMaxMetricsValues = 64;
+
+        // buckets that fit into a transport entry next to the other fields of a histogram message
+        std::size_t histogram_buckets_per_message(std::size_t empty_message_size) const
+        {
+                auto entry_size = MPSCRingBuffer::entry_data_size_of(context.cxl_trans_entry_struct_size);
+                CHECK(empty_message_size + kHistogramBucketSize <= entry_size)
+                        << "a transport entry of " << context.cxl_trans_entry_struct_size << " bytes cannot hold a latency histogram bucket";
+                return (entry_size - empty_message_size) / kHistogramBucketSize;
+        }
+
+        // the histogram is sparse, send it to coordinator 0 in chunks that fit into a transport entry
+        template <class Func> void send_histogram(const Percentile<int64_t> &latency, Func new_message)
+        {
+                std::vector<std::pair<uint32_t, uint64_t> > buckets;
+                Message empty_message;
+                new_message(empty_message, buckets, true);
+                auto buckets_per_message = histogram_buckets_per_message(empty_message.get_message_length());
+
+                auto flush_buckets = [&](bool last) {
+                        auto message = std::make_unique<Message>();
+                        message->set_source_node_id(id);
+                        message->set_dest_node_id(0);
+                        message->set_worker_id(0);
+                        new_message(*message, buckets, last);
+                        send_control_message(std::move(message));
+                        buckets.clear();
+                };
+                latency.for_each_bucket([&](uint32_t bucket, uint64_t count) {
+                        buckets.emplace_back(bucket, count);
+                        if (buckets.size() == buckets_per_message) {
+                                flush_buckets(false);
+                        }
+                });
+                flush_buckets(true);
+        }
+
+        // writes the record of this host for the interval; coordinator 0 also merges the records of the other hosts
+        void export_metrics(uint32_t interval, const MetricsRecord &record)
+        {
+                CHECK(record.values.size() <= kMaxMetricsValues);
+
+                Percentile<int64_t> latency;
+                for (auto i = 0u; i < workers.size(); i++) {
+                        workers[i]->collect_latency(latency);
+                }
+                auto interval_latency = latency;
+                interval_latency.subtract(last_latency_snapshot);
+                last_latency_snapshot = latency;
+
+                metrics_sink->add_local(interval, record, interval_latency);
+
+                if (id == 0) {
+                        // merge the reports of the other hosts that have arrived so far
+                        while (!in_queue.empty()) {
+                                std::unique_ptr<Message> message(in_queue.front());
+                                MessagePiece messagePiece = *(message->begin());
+                                if (messagePiece.get_message_type() != static_cast<uint32_t>(ControlMessage::METRICS)) {
+                                        message.release();
+                                        break;
+                                }
+                                bool ok = in_queue.pop();
+                                CHECK(ok);
+                                merge_metrics_message(messagePiece);
+                        }
+                } else {
+                        send_histogram(interval_latency, [&](Message &message, const std::vector<std::pair<uint32_t, uint64_t> > &buckets, bool last) {
+                                ControlMessageFactory::new_metrics_message(message, id, interval, last, record.values, interval_latency.raw_sum(),
+                                                                           interval_latency.raw_min(), interval_latency.raw_max(), buckets);
+                        });
+                }
+        }
+
+        void merge_metrics_message(MessagePiece &messagePiece)
+        {
+                Decoder dec(messagePiece.toStringPiece());
+                int coordinator_id;
+                uint32_t interval, n_values, n_buckets;
+                bool last;
+                uint64_t sum, min, max;
+                dec >> coordinator_id >> interval >> last >> n_values;
+                std::vector<uint64_t> values(n_values);
+                for (auto i = 0u; i < n_values; i++) {
+                        dec >> values[i];
+                }
+                dec >> sum >> min >> max >> n_buckets;
+                auto &latency = metrics_sink->remote_latency(interval);
+                for (auto i = 0u; i < n_buckets; i++) {
+                        uint32_t bucket;
+                        uint64_t count;
+                        dec >> bucket >> count;
+                        latency.add_bucket(bucket, count);
+                }
+                if (last) {
+                        latency.add_summary(sum, min, max);
+                        metrics_sink->add_remote(interval, values);
+                }
+        }
+
+        // returns true if this is the last message of a remote histogram
+        bool merge_latency_message(MessagePiece &messagePiece, Percentile<int64_t> *histograms[])
+        {
+                Decoder dec(messagePiece.toStringPiece());
+                int coordinator_id;
+                uint32_t histogram;
+                bool last;
+                uint64_t sum, min, max;
+                uint32_t n_buckets;
+                dec >> coordinator_id >> histogram >> last >> sum >> min >> max >> n_buckets;
+                CHECK(histogram < static_cast<uint32_t>(LatencyHistogram::NFIELDS));
+                auto &latency = *histograms[histogram];
+                for (auto i = 0u; i < n_buckets; i++) {
+                        uint32_t bucket;
+                        uint64_t count;
+                        dec >> bucket >> count;
+                        latency.add_bucket(bucket, count);
+                }
+                if (last) {
+                        latency.add_summary(sum, min, max);
+                }
+                return last;
+        }
+
     private:
 	void close_sockets()
 	{
@@ -667,5 +925,8 @@ class Coordinator {
 	LockfreeQueue<Message *> out_to_in_queue;
 
         MPSCRingBuffer *cxl_ringbuffers;
+
+        std::unique_ptr<MetricsSink> metrics_sink;
+        Percentile<int64_t> last_latency_snapshot;
 };
 } // namespace star
@@ -41,7 +41,7 @@ class IncomingDispatcher {
                         for (auto i = 0u; i < sockets.size(); i++)
                                 buffered_readers.emplace_back(sockets[i]);
                 else
-                        buffered_readers.emplace_back(cxl_ringbuffers[coord_id]);
+                        buffered_readers.emplace_back(CXLTransport::get_ringbuffer(cxl_ringbuffers, io_thread_num, coord_id, group_id));
 	}
 
 	void start()
@@ -161,7 +161,9 @@ class IncomingDispatcher {
 
 	bool is_coordinator_message(Message *message)
 	{
-		return (*(message->begin())).get_message_type() == static_cast<uint32_t>(ControlMessage::STATISTICS);
+		auto type = (*(message->begin())).get_message_type();
+		return type == static_cast<uint32_t>(ControlMessage::STATISTICS) || type == static_cast<uint32_t>(ControlMessage::LATENCY) ||
+		       type == static_cast<uint32_t>(ControlMessage::METRICS);
 	}
 
 	std::unique_ptr<Message> fetchMessageFromCoordinator(uint64_t remote_coordinator_id)
@@ -296,7 +298,8 @@ class OutgoingDispatcher {
                 if (context.use_cxl_transport == false) {
 		        sockets[dest_node_id].write_n_bytes(message->get_raw_ptr(), message_length);
                 } else {
-                        cxl_transport->send(message);
+                        // this dispatcher only carries messages of its own worker group (and coordinator messages in group 0)
+                        cxl_transport->send(message, group_id);
                 }
 
 		if (message->get_message_gen_time())
@@ -307,6 +310,23 @@ class OutgoingDispatcher {
 		sendto_cnt++;
 	}
 
+	void sendMessages(std::size_t dest_node_id, const std::vector<Message *> &messages)
+	{
+		DCHECK(dest_node_id < sockets.size() && dest_node_id != coordinator_id);
+		iovecs.resize(messages.size());
+		std::size_t bytes = 0;
+		for (size_t j = 0; j < messages.size(); ++j) {
+			iovecs[j].iov_base = messages[j]->get_raw_ptr();
+			iovecs[j].iov_len = messages[j]->get_message_length();
+			bytes += iovecs[j].iov_len;
+		}
+		auto bytes_sent = sockets[dest_node_id].writev_n_bytes(iovecs.data(), iovecs.size());
+		CHECK(bytes_sent == static_cast<long>(bytes));
+
+		network_size += bytes;
+		sendto_cnt++;
+	}
+
 	void groupOrDispatchMessages(const std::shared_ptr<Worker> &worker, std::vector<std::vector<Message *> > &messages_by_coordinator)
 	{
 		while (true) {
@@ -348,15 +368,26 @@ class OutgoingDispatcher {
 				continue;
 			}
 
-			std::unique_ptr<GrouppedMessage> gmsg(new GrouppedMessage);
-			gmsg->set_dest_node_id(i);
 			auto ts = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()).time_since_epoch().count();
-			for (size_t j = 0; j < messages_by_coordinator[i].size(); ++j) {
-				messages_by_coordinator[i][j]->set_message_send_time(ts);
-				gmsg->addMessage(messages_by_coordinator[i][j]);
-			}
 			auto t = Time::now();
-			sendMessage(gmsg.get());
+			if (context.use_cxl_transport == false) {
+				// TCP: the messages go out with one gathered write, without copying them into a group first
+				for (size_t j = 0; j < messages_by_coordinator[i].size(); ++j) {
+					messages_by_coordinator[i][j]->set_message_send_time(ts);
+				}
+				t = Time::now();
+				sendMessages(i, messages_by_coordinator[i]);
+			} else {
+				// CXL: a ring entry must hold the whole group
+				std::unique_ptr<GrouppedMessage> gmsg(new GrouppedMessage);
+				gmsg->set_dest_node_id(i);
+				for (size_t j = 0; j < messages_by_coordinator[i].size(); ++j) {
+					messages_by_coordinator[i][j]->set_message_send_time(ts);
+					gmsg->addMessage(messages_by_coordinator[i][j]);
+				}
+				t = Time::now();
+				sendMessage(gmsg.get());
+			}
 			auto ltc = (Time::now() - gen_time) / 1000;
 			gen_to_sent_latency.add(ltc);
 			sent_latency.add((Time::now() - t) / 1000);
@@ -413,6 +444,7 @@ class OutgoingDispatcher {
 	Percentile<std::size_t> network_msg_group_size;
 	std::size_t internal_network_msg_cnt = 0;
 	std::vector<Socket> &sockets;           // network transport
+	std::vector<struct iovec> iovecs;       // gathered write of the messages to one host
 	std::vector<std::shared_ptr<Worker> > workers;
 	LockfreeQueue<Message *> &coordinator_queue;
 	LockfreeQueue<Message *> &out_to_in_queue;
@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include "common/BufferedReader.h"
+#include "common/CXLTransport.h"
 #include "common/Percentile.h"
 #include "common/WALLogger.h"
 #include "common/BufferedFileWriter.h"
 #include "common/CXL_EBR.h"
+#include "core/ArrivalSchedule.h"
 #include "core/ControlMessage.h"
 #include "core/Defs.h"
 #include "core/Delay.h"
@@ -16,6 +19,7 @@
 #include "glog/logging.h"
 
 #include <chrono>
+#include <deque>
 #include <thread>
 
 namespace star
@@ -47,7 +51,12 @@ template <class Workload, class Protocol> class Executor : public Worker {
 		, protocol(db, context, *partitioner)
 		, workload(coordinator_id, db, random, *partitioner)
 		, delay(std::make_unique<SameDelay>(coordinator_id, context.coordinator_num, context.delay_time))
+		, arrival_schedule((static_cast<uint64_t>(coordinator_id) << 32) | id)
 	{
+		if (context.open_loop_tps > 0) {
+			arrival_schedule.init(static_cast<double>(context.open_loop_tps) / context.worker_num, context.open_loop_arrival);
+		}
+
 		for (auto i = 0u; i < context.coordinator_num; i++) {
 			messages.emplace_back(std::make_unique<Message>());
 			init_message(messages[i].get(), i);
@@ -85,6 +94,11 @@ template <class Workload, class Protocol> class Executor : public Worker {
                         global_ebr_meta->thread_init_ebr_meta(context.coordinator_id, id);
                 }
 
+                // requests and responses between workers skip the dispatchers, see CXLTransport
+                if (context.use_cxl_transport && context.cxl_worker_lanes && context.use_output_thread == false) {
+                        lane_reader = std::make_unique<BufferedReader>(cxl_transport->get_worker_lane(coordinator_id, id));
+                }
+
 		uint64_t last_seed = 0;
 
 		ExecutorStatus status;
@@ -95,6 +109,10 @@ template <class Workload, class Protocol> class Executor : public Worker {
 
 		n_started_workers.fetch_add(1);
 
+		if (arrival_schedule.is_enabled()) {
+			arrival_schedule.restart();
+		}
+
                 bool retry_transaction = false;
 
 		// auto startTime = std::chrono::steady_clock::now();
@@ -123,9 +141,22 @@ template <class Workload, class Protocol> class Executor : public Worker {
 				} else {
 					auto partition_id = get_partition_id();
 
+					workload.recycle_transaction(std::move(transaction));
 					transaction = workload.next_transaction(context, partition_id, this->id);
 					// startTime = std::chrono::steady_clock::now();
 					setupHandlers(*transaction);
+
+					if (arrival_schedule.is_enabled()) {
+						// open loop: wait for the arrival of the transaction, serving remote requests meanwhile
+						intended_start = arrival_schedule.next();
+						while (std::chrono::steady_clock::now() < intended_start &&
+						       static_cast<ExecutorStatus>(worker_status.load()) != ExecutorStatus::STOP) {
+							process_request();
+						}
+						transaction->startTime = std::chrono::steady_clock::now();
+						queueing_delay.add(
+							std::chrono::duration_cast<std::chrono::microseconds>(transaction->startTime - intended_start).count());
+					}
 				}
 
                                 global_ebr_meta->enter_critical_section();
@@ -166,6 +197,12 @@ template <class Workload, class Protocol> class Executor : public Worker {
 														     transaction->startTime)
 								       .count();
 						percentile.add(latency);
+						if (arrival_schedule.is_enabled()) {
+							// latency from the intended arrival, including queueing delay and retries
+							open_loop_latency.add(std::chrono::duration_cast<std::chrono::microseconds>(
+										      std::chrono::steady_clock::now() - intended_start)
+										      .count());
+						}
 						if (transaction->is_single_partition() == false) {
 							dist_latency.add(latency);
 						} else {
@@ -221,11 +258,28 @@ template <class Workload, class Protocol> class Executor : public Worker {
 		process_request();
 		n_complete_workers.fetch_add(1);
 
+		// responses to requests served during the cleanup of other hosts may still arrive, the lane is drained
+		// until every host has finished its cleanup, so that a sender never waits on a lane nobody reads
+		while (lane_reader != nullptr && static_cast<ExecutorStatus>(worker_status.load()) != ExecutorStatus::EXIT) {
+			process_request();
+		}
+
                 global_ebr_meta->print_statistics();
 
 		LOG(INFO) << "Executor " << id << " exits.";
 	}
 
+	void collect_latency(Percentile<int64_t> &latency) override
+	{
+		latency.merge(percentile);
+	}
+
+	void collect_open_loop_latency(Percentile<int64_t> &latency, Percentile<int64_t> &delay) override
+	{
+		latency.merge(open_loop_latency);
+		delay.merge(queueing_delay);
+	}
+
 	void onExit() override
 	{
 		LOG(INFO) << "Worker " << id << " latency: " << percentile.nth(50) << " us (50%) " << percentile.nth(75) << " us (75%) " << percentile.nth(95)
@@ -257,6 +311,14 @@ template <class Workload, class Protocol> class Executor : public Worker {
 			  << " commit_replication " << this->dist_txn_commit_replication_time_pct.avg() << " us, "
 			  << " commit_release_lock " << this->dist_txn_commit_unlock_time_pct.avg() << " us \n";
 
+		if (arrival_schedule.is_enabled()) {
+			LOG(INFO) << "Worker " << id << " open-loop at " << context.open_loop_tps / context.worker_num
+				  << " txns/s, latency from arrival: " << open_loop_latency.nth(50) << " us (50%) " << open_loop_latency.nth(95)
+				  << " us (95%) " << open_loop_latency.nth(99) << " us (99%) " << open_loop_latency.nth(99.9) << " us (99.9%) avg "
+				  << open_loop_latency.avg() << " us. queueing delay: " << queueing_delay.nth(50) << " us (50%) "
+				  << queueing_delay.nth(99) << " us (99%) avg " << queueing_delay.avg() << " us.";
+		}
+
 		if (id == 0) {
 			for (auto i = 0u; i < message_stats.size(); i++) {
 				LOG(INFO) << "message stats, type: " << i << " count: " << message_stats[i] << " total size: " << message_sizes[i];
@@ -319,29 +381,62 @@ template <class Workload, class Protocol> class Executor : public Worker {
 		std::size_t size = 0;
 
 		while (!in_queue.empty()) {
-			size++;
 			std::unique_ptr<Message> message(in_queue.front());
 			bool ok = in_queue.pop();
 			CHECK(ok);
 
-			for (auto it = message->begin(); it != message->end(); it++) {
-				MessagePiece messagePiece = *it;
-				auto type = messagePiece.get_message_type();
-				DCHECK(type < messageHandlers.size());
-				ITable *table = db.find_table(messagePiece.get_table_id(), messagePiece.get_partition_id());
-
-				messageHandlers[type](messagePiece, *messages[message->get_source_node_id()], *table, transaction.get());
+			size += handle_message(*message);
+		}
 
-				message_stats[type]++;
-				message_sizes[type] += messagePiece.get_message_length();
+		// the worker serves its lane itself, so requests are handled as soon as it polls,
+		// including while it waits for responses inside a transaction
+		while (lane_reader != nullptr) {
+			std::unique_ptr<Message> message;
+			if (!lane_backlog.empty()) {
+				message = std::move(lane_backlog.front());
+				lane_backlog.pop_front();
+			} else {
+				message = lane_reader->next_message();
+			}
+			if (message == nullptr) {
+				break;
 			}
 
-			size += message->get_message_count();
-			flush_messages();
+			size += handle_message(*message);
 		}
 		return size;
 	}
 
+	std::size_t handle_message(Message &message)
+	{
+		for (auto it = message.begin(); it != message.end(); it++) {
+			MessagePiece messagePiece = *it;
+			auto type = messagePiece.get_message_type();
+			DCHECK(type < messageHandlers.size());
+			ITable *table = db.find_table(messagePiece.get_table_id(), messagePiece.get_partition_id());
+
+			messageHandlers[type](messagePiece, *messages[message.get_source_node_id()], *table, transaction.get());
+
+			message_stats[type]++;
+			message_sizes[type] += messagePiece.get_message_length();
+		}
+
+		flush_messages();
+		return message.get_message_count() + 1;
+	}
+
+	void send_to_lane(Message *message)
+	{
+		// the owner of the lane drains it until every host has finished its cleanup, see Manager
+		auto &lane = cxl_transport->get_worker_lane(message->get_dest_node_id(), id);
+		while (lane.enqueue(message->get_raw_ptr(), message->get_message_length()) == false) {
+			// the peer may be blocked on our lane as well, so keep ours moving while we wait
+			while (auto incoming = lane_reader->next_message()) {
+				lane_backlog.push_back(std::move(incoming));
+			}
+		}
+	}
+
 	virtual void setupHandlers(TransactionType &txn) = 0;
 
 	virtual void flush_messages()
@@ -358,6 +453,8 @@ template <class Workload, class Protocol> class Executor : public Worker {
 			if (context.use_output_thread == true) {
 			        out_queue.push(messages[i].release());
                                 // message is reclaimed by the output thread
+                        } else if (lane_reader != nullptr) {
+                                send_to_lane(messages[i].get());
                         } else {
                                 cxl_transport->send(messages[i].get());
                                 // must reclaim the message here - otherwise memory leakage would occur
@@ -386,7 +483,10 @@ template <class Workload, class Protocol> class Executor : public Worker {
 	ProtocolType protocol;
 	WorkloadType workload;
 	std::unique_ptr<Delay> delay;
+	ArrivalSchedule arrival_schedule;
+	std::chrono::steady_clock::time_point intended_start;
 	Percentile<int64_t> percentile, dist_latency, local_latency, commit_latency;
+	Percentile<int64_t> open_loop_latency, queueing_delay;
 	Percentile<uint64_t> local_txn_stall_time_pct, local_txn_commit_work_time_pct, local_txn_commit_persistence_time_pct, local_txn_commit_prepare_time_pct,
 		local_txn_commit_replication_time_pct, local_txn_commit_write_back_time_pct, local_txn_commit_unlock_time_pct, local_txn_local_work_time_pct,
 		local_txn_remote_work_time_pct;
@@ -401,6 +501,8 @@ template <class Workload, class Protocol> class Executor : public Worker {
 	LockfreeQueue<Message *> in_queue;
 	char pad[64];
 	LockfreeQueue<Message *> out_queue;
+	std::unique_ptr<BufferedReader> lane_reader;
+	std::deque<std::unique_ptr<Message> > lane_backlog;
 
 	WALLogger *logger = nullptr;
 	void record_txn_breakdown_stats(TransactionType &txn)
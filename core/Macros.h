@@ -29,6 +29,7 @@ DEFINE_bool(star_sync, false, "synchronous write in the single-master phase");
 DEFINE_bool(star_dynamic_batch_size, true, "dynamic batch size");
 DEFINE_bool(plv, true, "parallel locking and validation");
 DEFINE_bool(calvin_same_batch, false, "always run the same batch of txns.");
+DEFINE_bool(calvin_cxl, false, "calvin lock managers exchange lock requests and votes through the shared CXL region");
 DEFINE_bool(kiva_read_only, true, "kiva read only optimization");
 DEFINE_bool(kiva_reordering, true, "kiva reordering optimization");
 DEFINE_bool(kiva_si, false, "kiva snapshot isolation");
@@ -48,6 +49,7 @@ DEFINE_int32(wal_group_commit_size, 7, "wal group commit batch size");
 DEFINE_bool(aria_read_only, true, "aria read only optimization");
 DEFINE_bool(aria_reordering, true, "aria reordering optimization");
 DEFINE_bool(aria_si, false, "aria snapshot isolation");
+DEFINE_bool(aria_cxl, false, "aria keeps reservation metadata and epoch barriers in the shared CXL region");
 DEFINE_int32(stragglers_per_batch, 0, "# stragglers in a batch");
 DEFINE_int32(stragglers_num_txn_len, 10, "# straggler transaction length types");
 DEFINE_int32(stragglers_partition, -1, "straggler partition");
@@ -75,6 +77,8 @@ DEFINE_bool(use_cxl_transport, false, "use CXL transport instead of network tran
 DEFINE_bool(use_output_thread, false, "do you want an output thread?");
 DEFINE_uint64(cxl_trans_entry_struct_size, 8192, "size of enrty in a MPSC ringbuffer");
 DEFINE_uint64(cxl_trans_entry_num, 4096, "number of entries per MPSC ringbuffer");
+DEFINE_bool(cxl_worker_lanes, false, "workers exchange requests and responses through their own CXL lanes");
+DEFINE_uint64(cxl_lane_entry_num, 256, "number of entries per worker lane");
 
 DEFINE_bool(enable_migration_optimization, true, "enable data migration optimization");
 DEFINE_string(migration_policy, "Eagerly", "Pasha data migration policy");
@@ -83,15 +87,27 @@ DEFINE_uint64(hw_cc_budget, 1024 * 1024 * 200, "budget for the hardware cache-co
 
 DEFINE_bool(enable_phantom_detection, true, "TwoPLPasha enables phantom detection (next-key locking)");
 DEFINE_bool(model_cxl_search_overhead, false, "Model the overhead of local operations always searching through the CXL indexes");
+DEFINE_bool(enable_row_prefetch, false, "TwoPLPasha sends the lock requests of remote rows before locking and prefetching local rows");
+DEFINE_string(lock_wait_policy, "NoWait", "TwoPLPasha lock conflict policy: NoWait or WaitDie");
+DEFINE_uint64(lock_wait_spins, 1000, "TwoPLPasha WaitDie: lock attempts before a waiting transaction aborts");
+DEFINE_bool(enable_optimistic_reads, false, "TwoPLPasha reads rows without read locks until a transaction asks for a write and validates them at commit");
 
 DEFINE_bool(enable_scc, true, "enable software cache-coherence");
 DEFINE_string(scc_mechanism, "NoOP", "Pasha software cache-coherence mechanism");
 
+DEFINE_double(btree_fill_factor, 1.0, "fraction of a B-tree node filled when a table is bulk loaded, in (0, 1]");
+
 DEFINE_int32(time_to_run, 30, "time to run");
 DEFINE_int32(time_to_warmup, 10, "time to warm up");
 
 DEFINE_string(pre_migrate, "None", "what tuples to pre-migrate?");
 
+DEFINE_string(metrics_path, "", "per-second metrics are written to <metrics_path>.<coordinator id>, empty disables the export");
+DEFINE_string(metrics_format, "csv", "per-second metrics format: csv or jsonl");
+
+DEFINE_uint64(open_loop_tps, 0, "open-loop target arrival rate per host in txns/s, 0 runs closed-loop");
+DEFINE_string(open_loop_arrival, "poisson", "open-loop arrival process: poisson, uniform, or path to a trace of inter-arrival gaps in us");
+
 #define SETUP_CONTEXT(context)                                                                  \
 	boost::algorithm::split(context.peers, FLAGS_servers, boost::is_any_of(";"));           \
 	context.coordinator_num = context.peers.size();                                         \
@@ -115,6 +131,7 @@ DEFINE_string(pre_migrate, "None", "what tuples to pre-migrate?");
 	context.star_dynamic_batch_size = FLAGS_star_dynamic_batch_size;                        \
 	context.parallel_locking_and_validation = FLAGS_plv;                                    \
 	context.calvin_same_batch = FLAGS_calvin_same_batch;                                    \
+	context.calvin_cxl = FLAGS_calvin_cxl;                                                  \
 	context.kiva_read_only_optmization = FLAGS_kiva_read_only;                              \
 	context.kiva_reordering_optmization = FLAGS_kiva_reordering;                            \
 	context.kiva_snapshot_isolation = FLAGS_kiva_si;                                        \
@@ -134,6 +151,7 @@ DEFINE_string(pre_migrate, "None", "what tuples to pre-migrate?");
 	context.aria_read_only_optmization = FLAGS_aria_read_only;                              \
 	context.aria_reordering_optmization = FLAGS_aria_reordering;                            \
 	context.aria_snapshot_isolation = FLAGS_aria_si;                                        \
+	context.aria_cxl = FLAGS_aria_cxl;                                                      \
 	context.stragglers_per_batch = FLAGS_stragglers_per_batch;                              \
 	context.stragglers_partition = FLAGS_stragglers_partition;                              \
 	context.sender_group_nop_count = FLAGS_sender_group_nop_count;                          \
@@ -148,15 +166,26 @@ DEFINE_string(pre_migrate, "None", "what tuples to pre-migrate?");
         context.use_output_thread = FLAGS_use_output_thread;                                    \
         context.cxl_trans_entry_struct_size = FLAGS_cxl_trans_entry_struct_size;                \
         context.cxl_trans_entry_num = FLAGS_cxl_trans_entry_num;                                \
+        context.cxl_worker_lanes = FLAGS_cxl_worker_lanes;                                      \
+        context.cxl_lane_entry_num = FLAGS_cxl_lane_entry_num;                                  \
         context.enable_migration_optimization = FLAGS_enable_migration_optimization;            \
         context.migration_policy = FLAGS_migration_policy;                                      \
         context.when_to_move_out = FLAGS_when_to_move_out;                                      \
         context.hw_cc_budget = FLAGS_hw_cc_budget;                                              \
         context.model_cxl_search_overhead = FLAGS_model_cxl_search_overhead;                    \
         context.enable_phantom_detection = FLAGS_enable_phantom_detection;                      \
+        context.enable_row_prefetch = FLAGS_enable_row_prefetch;                                \
+        context.lock_wait_policy = FLAGS_lock_wait_policy;                                      \
+        context.lock_wait_spins = FLAGS_lock_wait_spins;                                        \
+        context.enable_optimistic_reads = FLAGS_enable_optimistic_reads;                        \
         context.enable_scc = FLAGS_enable_scc;                                                  \
         context.scc_mechanism = FLAGS_scc_mechanism;                                            \
+        context.btree_fill_factor = FLAGS_btree_fill_factor;                                    \
         context.time_to_run = FLAGS_time_to_run;                                                \
         context.time_to_warmup = FLAGS_time_to_warmup;                                          \
         context.pre_migrate = FLAGS_pre_migrate;                                                \
+        context.metrics_path = FLAGS_metrics_path;                                              \
+        context.metrics_format = FLAGS_metrics_format;                                          \
+        context.open_loop_tps = FLAGS_open_loop_tps;                                            \
+        context.open_loop_arrival = FLAGS_open_loop_arrival;                                    \
 	context.set_star_partitioner();
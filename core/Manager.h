@@ -57,6 +57,8 @@ class Manager : public Worker {
 		set_worker_status(ExecutorStatus::CLEANUP);
 		wait_all_workers_finish();
 		wait4_ack();
+		// every host has finished its cleanup, nothing is sent anymore
+		signal_worker(ExecutorStatus::EXIT);
 	}
 
 	virtual void non_coordinator_start()
@@ -80,6 +82,9 @@ class Manager : public Worker {
 		set_worker_status(ExecutorStatus::CLEANUP);
 		wait_all_workers_finish();
 		send_ack();
+		status = wait4_signal();
+		CHECK(status == ExecutorStatus::EXIT);
+		set_worker_status(ExecutorStatus::EXIT);
 	}
 
 	void wait_all_workers_finish()
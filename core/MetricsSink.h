@@ -0,0 +1,171 @@
+//
+// Per-interval metrics export
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "common/Percentile.h"
+
+namespace star
+{
+
+/*
+ * One row of the time series: an ordered list of named counters.
+ * Every host builds its records with the same fields in the same order, so a record can be shipped as a
+ * plain array of values and merged field by field on coordinator 0.
+ */
+class MetricsRecord {
+    public:
+	enum class Merge { SUM, MAX };
+
+	void add(const std::string &name, uint64_t value, Merge merge = Merge::SUM)
+	{
+		names.push_back(name);
+		values.push_back(value);
+		merges.push_back(merge);
+	}
+
+	// latency percentiles are computed from the (merged) histogram and never shipped
+	void add_latency(const Percentile<int64_t> &latency)
+	{
+		add("latency_count", latency.size());
+		add("latency_p50_us", latency.nth(50));
+		add("latency_p90_us", latency.nth(90));
+		add("latency_p99_us", latency.nth(99));
+		add("latency_p999_us", latency.nth(99.9));
+		add("latency_max_us", latency.max());
+	}
+
+	void merge(const std::vector<uint64_t> &remote_values)
+	{
+		CHECK(remote_values.size() == values.size());
+		for (auto i = 0u; i < values.size(); i++) {
+			if (merges[i] == Merge::SUM) {
+				values[i] += remote_values[i];
+			} else {
+				values[i] = std::max(values[i], remote_values[i]);
+			}
+		}
+	}
+
+	std::vector<std::string> names;
+	std::vector<uint64_t> values;
+	std::vector<Merge> merges;
+};
+
+/*
+ * Writes one record per interval per host and, on coordinator 0, one cluster-wide record per interval
+ * once every coordinator has reported that interval.
+ * format is "csv" (a header row followed by one row per record) or "jsonl" (one JSON object per line).
+ */
+class MetricsSink {
+    public:
+	MetricsSink(const std::string &path, const std::string &format, std::size_t coordinator_id, std::size_t coordinator_num)
+		: coordinator_id(coordinator_id)
+		, coordinator_num(coordinator_num)
+	{
+		CHECK(format == "csv" || format == "jsonl") << "unknown metrics format " << format;
+		csv = format == "csv";
+		out.open(path);
+		CHECK(out.is_open()) << "cannot open metrics file " << path;
+	}
+
+	~MetricsSink()
+	{
+		out.close();
+	}
+
+	void add_local(uint32_t interval, const MetricsRecord &scalars, const Percentile<int64_t> &latency)
+	{
+		auto record = scalars;
+		record.add_latency(latency);
+		write(std::to_string(coordinator_id), record);
+
+		if (coordinator_id == 0) {
+			auto &pending = pending_intervals[interval];
+			pending.has_local = true;
+			pending.record = scalars;
+			pending.latency.merge(latency);
+			try_emit(interval);
+		}
+	}
+
+	// only used on coordinator 0, the latency histogram of the remote host is merged into remote_latency(interval)
+	void add_remote(uint32_t interval, const std::vector<uint64_t> &values)
+	{
+		pending_intervals[interval].remote_values.push_back(values);
+		try_emit(interval);
+	}
+
+	Percentile<int64_t> &remote_latency(uint32_t interval)
+	{
+		return pending_intervals[interval].latency;
+	}
+
+    private:
+	struct PendingInterval {
+		bool has_local = false;
+		MetricsRecord record;
+		std::vector<std::vector<uint64_t> > remote_values;
+		Percentile<int64_t> latency;
+	};
+
+	void try_emit(uint32_t interval)
+	{
+		auto it = pending_intervals.find(interval);
+		if (it == pending_intervals.end() || it->second.has_local == false || it->second.remote_values.size() < coordinator_num - 1) {
+			return;
+		}
+		auto record = it->second.record;
+		for (auto &values : it->second.remote_values) {
+			record.merge(values);
+		}
+		record.add_latency(it->second.latency);
+		write("cluster", record);
+		pending_intervals.erase(it);
+	}
+
+	void write(const std::string &host, const MetricsRecord &record)
+	{
+		if (csv) {
+			if (!header_written) {
+				out << "host";
+				for (auto &name : record.names) {
+					out << "," << name;
+				}
+				out << "\n";
+				header_written = true;
+			}
+			out << host;
+			for (auto value : record.values) {
+				out << "," << value;
+			}
+			out << "\n";
+		} else {
+			out << "{\"host\":\"" << host << "\"";
+			for (auto i = 0u; i < record.names.size(); i++) {
+				out << ",\"" << record.names[i] << "\":" << record.values[i];
+			}
+			out << "}\n";
+		}
+		out.flush();
+	}
+
+	std::size_t coordinator_id;
+	std::size_t coordinator_num;
+	bool csv = true;
+	bool header_written = false;
+	std::ofstream out;
+	std::map<uint32_t, PendingInterval> pending_intervals;
+};
+
+} // namespace star
@@ -86,6 +86,11 @@
                                 else                                                                       \
                                         return -1;                                                         \
                         }                                                                                  \
+                        /* keys are ordered by their plain key, see btreeolc::KeyPrefixTraits */        \
+                        static uint64_t key_prefix(const key &k)                                           \
+                        {                                                                                  \
+                                return k.get_plain_key();                                                  \
+                        }                                                                                  \
                 };                                                                                         \
                 struct ValueComparator {                                                                   \
                         int operator()(const value &a, const value &b) const                               \
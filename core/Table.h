@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory>
 #include <thread>
 #include "benchmark/tpcc/Schema.h"
 #include "common/ClassOf.h"
@@ -20,6 +21,8 @@ namespace star
 
 extern void tid_check();
 
+class CXLTableBase;
+
 class ITable {
     public:
         enum { HASHMAP, BTREE };
@@ -47,6 +50,16 @@ class ITable {
                 uint64_t row_size;
         };
 
+	ITable(std::size_t tableID, std::size_t partitionID, std::size_t key_size, std::size_t value_size, std::size_t field_size, int tableType)
+		: tableID_(tableID)
+		, partitionID_(partitionID)
+		, key_size_(key_size)
+		, value_size_(value_size)
+		, field_size_(field_size)
+		, tableType_(tableType)
+	{
+	}
+
 	virtual ~ITable() = default;
 
         virtual uint64_t get_plain_key(const void *key) = 0;
@@ -55,6 +68,14 @@ class ITable {
 
 	virtual std::tuple<MetaDataType *, void *> search(const void *key) = 0;
 
+	// rows[i] is the row of keys[i], or (nullptr, nullptr) if keys[i] does not exist
+	virtual void search_batch(const void *const *keys, std::tuple<MetaDataType *, void *> *rows, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; i++) {
+			rows[i] = search(keys[i]);
+		}
+	}
+
 	virtual bool contains(const void *key)
 	{
 		return true;
@@ -68,6 +89,21 @@ class ITable {
 
 	virtual bool insert(const void *key, const void *value, bool is_placeholder = false) = 0;
 
+	// bulk loading of an empty table, the rows are appended in ascending key order between
+	// bulk_load_begin and bulk_load_end; tables without an ordered index just insert them
+	virtual void bulk_load_begin(double fill_factor)
+	{
+	}
+
+	virtual bool bulk_load_append(const void *key, const void *value)
+	{
+		return insert(key, value);
+	}
+
+	virtual void bulk_load_end()
+	{
+	}
+
         virtual bool insert_lock_next_key(const void *key, const void *value, std::function<bool(const void *, MetaDataType *, void *)> next_key_processor, bool is_placeholder = false) = 0;
 
         virtual bool insert_and_process_adjacent_tuples(const void *key, const void *value,
@@ -89,17 +125,36 @@ class ITable {
 
 	virtual void serialize_value(Encoder &enc, const void *value) = 0;
 
-	virtual std::size_t key_size() = 0;
+	// table properties are fixed at construction, so these accessors, used on every row access, are not virtual
+	std::size_t key_size() const
+	{
+		return key_size_;
+	}
 
-	virtual std::size_t value_size() = 0;
+	std::size_t value_size() const
+	{
+		return value_size_;
+	}
 
-	virtual std::size_t field_size() = 0;
+	std::size_t field_size() const
+	{
+		return field_size_;
+	}
 
-	virtual std::size_t tableID() = 0;
+	std::size_t tableID() const
+	{
+		return tableID_;
+	}
 
-	virtual std::size_t partitionID() = 0;
+	std::size_t partitionID() const
+	{
+		return partitionID_;
+	}
 
-        virtual int tableType() = 0;
+        int tableType() const
+        {
+                return tableType_;
+        }
 
 	virtual void turn_on_cow()
 	{
@@ -123,6 +178,42 @@ class ITable {
         {
                 CHECK(0);
         }
+
+        // a read-only index can be published in the shared region by the owner of the partition,
+        // so that the other hosts resolve it in place instead of asking the owner
+        CXLTableBase *get_shared_index() const
+        {
+                return shared_index_;
+        }
+
+        void set_shared_index(CXLTableBase *shared_index)
+        {
+                shared_index_ = shared_index;
+        }
+
+    private:
+        CXLTableBase *shared_index_ = nullptr;
+	const std::size_t tableID_;
+	const std::size_t partitionID_;
+	const std::size_t key_size_;
+	const std::size_t value_size_;
+	const std::size_t field_size_;
+	const int tableType_;
+};
+
+// compile-time table registry of a workload schema, keyed by the metadata of a protocol;
+// a Database whose tables of that protocol all have one concrete type specializes it,
+// so that a protocol's row lookups call the final table type directly and get inlined
+template <class Database, class MetaInitFunc> class TypedTables {
+    public:
+	using TableType = ITable;
+
+	static constexpr bool typed = false;
+
+	static TableType *find_table(Database &db, std::size_t table_id, std::size_t partition_id)
+	{
+		return db.find_table(table_id, partition_id);
+	}
 };
 
 class MetaInitFuncNothing {
@@ -151,6 +242,15 @@ class MetaInitFuncSundialPasha {
 	}
 };
 
+extern uint64_t SiloPashaMetadataLocalInit(bool is_tuple_valid);
+class MetaInitFuncSiloPasha {
+    public:
+	uint64_t operator()(bool is_tuple_valid = true)
+	{
+		return SiloPashaMetadataLocalInit(is_tuple_valid);
+	}
+};
+
 extern uint64_t TwoPLMetadataInit(bool is_tuple_valid);
 class MetaInitFuncTwoPL {
     public:
@@ -169,15 +269,14 @@ class MetaInitFuncTwoPLPasha {
 	}
 };
 
-template <std::size_t N, class KeyType, class ValueType, class KeyComparator, class ValueComparator, class MetaInitFunc = MetaInitFuncNothing> class TableHashMap : public ITable {
+template <std::size_t N, class KeyType, class ValueType, class KeyComparator, class ValueComparator, class MetaInitFunc = MetaInitFuncNothing> class TableHashMap final : public ITable {
     public:
 	using MetaDataType = std::atomic<uint64_t>;
 
 	virtual ~TableHashMap() override = default;
 
 	TableHashMap(std::size_t tableID, std::size_t partitionID)
-		: tableID_(tableID)
-		, partitionID_(partitionID)
+		: ITable(tableID, partitionID, sizeof(KeyType), sizeof(ValueType), ClassOf<ValueType>::size(), HASHMAP)
 	{
 	}
 
@@ -312,60 +411,234 @@ template <std::size_t N, class KeyType, class ValueType, class KeyComparator, cl
 		DCHECK(enc.size() - size == ClassOf<ValueType>::size());
 	}
 
-	std::size_t key_size() override
+        void move_all_into_cxl(std::function<bool(ITable *, const void *, std::tuple<MetaDataType *, void *> &, bool)> move_in_func) override
+        {
+                auto processor = [&](const KeyType &key, std::tuple<MetaDataType, ValueType> &row) {
+                        MetaDataType *meta_ptr = &std::get<0>(row);
+                        ValueType *data_ptr = &std::get<1>(row);
+                        std::tuple<MetaDataType *, void *> row_tuple(meta_ptr, data_ptr);
+			bool ret = move_in_func(this, &key, row_tuple, false);
+		};
+
+                map_.iterate_non_const(processor, []() {});
+        }
+
+    private:
+	HashMap<N, KeyType, std::tuple<MetaDataType, ValueType> > map_;
+};
+
+// rows are addressed directly by their plain key, for tables whose keys are dense small integers in [min_plain_key, min_plain_key + capacity);
+// rows are only inserted while loading, so like TableHashMap it supports neither next-key locking nor removal
+template <class KeyType, class ValueType, class KeyComparator, class ValueComparator, class MetaInitFunc = MetaInitFuncNothing> class TableArray final : public ITable {
+    public:
+	using MetaDataType = std::atomic<uint64_t>;
+
+        struct Slot {
+                MetaDataType meta;
+                ValueType data;
+                KeyType key;
+                bool is_present{ false };
+        };
+
+	virtual ~TableArray() override = default;
+
+	TableArray(std::size_t tableID, std::size_t partitionID, uint64_t min_plain_key, uint64_t capacity)
+		: ITable(tableID, partitionID, sizeof(KeyType), sizeof(ValueType), ClassOf<ValueType>::size(), HASHMAP)
+                , min_plain_key(min_plain_key)
+                , capacity(capacity)
+	{
+	}
+
+        uint64_t get_plain_key(const void *key) override
+        {
+                tid_check();
+                const auto &k = *static_cast<const KeyType *>(key);
+                return k.get_plain_key();
+        }
+
+        int compare_key(const void *a, const void *b) override
+        {
+                const auto &k_a = *static_cast<const KeyType *>(a);
+                const auto &k_b = *static_cast<const KeyType *>(b);
+                return KeyComparator()(k_a, k_b);
+        }
+
+	std::tuple<MetaDataType *, void *> search(const void *key) override
 	{
 		tid_check();
-		return sizeof(KeyType);
+                Slot *slot = find_slot(key);
+                if (slot == nullptr) {
+                        return std::make_tuple(nullptr, nullptr);
+                }
+		return std::make_tuple(&slot->meta, &slot->data);
 	}
 
-	std::size_t value_size() override
+	void *search_value(const void *key) override
 	{
 		tid_check();
-		return sizeof(ValueType);
+                Slot *slot = find_slot(key);
+                return slot == nullptr ? nullptr : &slot->data;
 	}
 
-	std::size_t field_size() override
+	MetaDataType *search_metadata(const void *key) override
 	{
 		tid_check();
-		return ClassOf<ValueType>::size();
+                Slot *slot = find_slot(key);
+                return slot == nullptr ? nullptr : &slot->meta;
+	}
+
+	bool contains(const void *key) override
+	{
+		return find_slot(key) != nullptr;
 	}
 
-	std::size_t tableID() override
+        void scan(const void *min_key, std::function<bool(const void *key, MetaDataType *meta, void *data, bool)> scan_processor) override
+        {
+                tid_check();
+                const auto &min_k = *static_cast<const KeyType *>(min_key);
+                if (slots == nullptr) {
+                        return;
+                }
+                uint64_t plain_key = min_k.get_plain_key();
+                uint64_t begin = plain_key < min_plain_key ? 0 : plain_key - min_plain_key;
+
+                uint64_t last = capacity;
+                for (uint64_t i = capacity; i > begin; i--) {
+                        if (slots[i - 1].is_present == true) {
+                                last = i - 1;
+                                break;
+                        }
+                }
+
+                for (uint64_t i = begin; i < capacity && last != capacity; i++) {
+                        Slot &slot = slots[i];
+                        if (slot.is_present == false) {
+                                continue;
+                        }
+                        if (scan_processor(&slot.key, &slot.meta, &slot.data, i == last) == true) {
+                                break;
+                        }
+                }
+        }
+
+        bool insert(const void *key, const void *value, bool is_placeholder = false) override
 	{
 		tid_check();
-		return tableID_;
+		const auto &k = *static_cast<const KeyType *>(key);
+		const auto &v = *static_cast<const ValueType *>(value);
+                uint64_t plain_key = k.get_plain_key();
+                CHECK(plain_key >= min_plain_key && plain_key - min_plain_key < capacity);
+
+                // the slots are allocated by the first insert, tables of partitions that are not loaded here stay empty
+                if (slots == nullptr) {
+                        slots.reset(new Slot[capacity]);
+                }
+                Slot &slot = slots[plain_key - min_plain_key];
+                if (slot.is_present == true) {
+                        return false;
+                }
+                slot.meta.store(MetaInitFunc()(!is_placeholder));
+                slot.data = v;
+                slot.key = k;
+                slot.is_present = true;
+
+                return true;
 	}
 
-	std::size_t partitionID() override
+        bool insert_lock_next_key(const void *key, const void *value, std::function<bool(const void *, MetaDataType *, void *)> next_key_processor, bool is_placeholder = false) override
+        {
+                CHECK(0);
+        }
+
+        bool insert_and_process_adjacent_tuples(const void *key, const void *value,
+                std::function<bool(const void *prev_key, MetaDataType *prev_meta, void *prev_data, const void *next_key, MetaDataType *next_meta, void *next_data)> update_processor,
+                bool is_placeholder = false) override
+        {
+                CHECK(0);
+        }
+
+        bool remove(const void *key) override
+        {
+                CHECK(0);
+        }
+
+        bool remove_and_process_adjacent_tuples(const void *key,
+                std::function<bool(const void *prev_key, void *prev_meta, void *prev_data, const void *cur_key, void *cur_meta, void *cur_data, const void *next_key, void *next_meta, void *next_data)> processor) override
+        {
+                CHECK(0);
+        }
+
+	void update(const void *key, const void *value, std::function<void(const void *, const void *)> on_update) override
 	{
 		tid_check();
-		return partitionID_;
+		const auto &v = *static_cast<const ValueType *>(value);
+                Slot *slot = find_slot(key);
+                CHECK(slot != nullptr);
+		on_update(key, &slot->data);
+		slot->data = v;
 	}
 
-        int tableType() override
+        bool search_and_update_next_key_info(const void *key,
+                std::function<void(const void *prev_key, void *prev_meta, void *prev_data, const void *cur_key, void *cur_meta, void *cur_data, const void *next_key, void *next_meta, void *next_data)> update_processor) override
         {
-                return HASHMAP;
+                // no need to maintain next-key information for tables without inserts and removals
+                return true;
         }
 
+	void deserialize_value(const void *key, StringPiece stringPiece) override
+	{
+		tid_check();
+		std::size_t size = stringPiece.size();
+                Slot *slot = find_slot(key);
+                CHECK(slot != nullptr);
+		auto &v = slot->data;
+
+		Decoder dec(stringPiece);
+		dec >> v;
+
+		DCHECK(size - dec.size() == ClassOf<ValueType>::size());
+	}
+
+	void serialize_value(Encoder &enc, const void *value) override
+	{
+		tid_check();
+		std::size_t size = enc.size();
+		const auto &v = *static_cast<const ValueType *>(value);
+		enc << v;
+
+		DCHECK(enc.size() - size == ClassOf<ValueType>::size());
+	}
+
         void move_all_into_cxl(std::function<bool(ITable *, const void *, std::tuple<MetaDataType *, void *> &, bool)> move_in_func) override
         {
-                auto processor = [&](const KeyType &key, std::tuple<MetaDataType, ValueType> &row) {
-                        MetaDataType *meta_ptr = &std::get<0>(row);
-                        ValueType *data_ptr = &std::get<1>(row);
-                        std::tuple<MetaDataType *, void *> row_tuple(meta_ptr, data_ptr);
-			bool ret = move_in_func(this, &key, row_tuple, false);
-		};
-
-                map_.iterate_non_const(processor, []() {});
+                for (uint64_t i = 0; slots != nullptr && i < capacity; i++) {
+                        Slot &slot = slots[i];
+                        if (slot.is_present == false) {
+                                continue;
+                        }
+                        std::tuple<MetaDataType *, void *> row_tuple(&slot.meta, &slot.data);
+			bool ret = move_in_func(this, &slot.key, row_tuple, false);
+                }
         }
 
     private:
-	HashMap<N, KeyType, std::tuple<MetaDataType, ValueType> > map_;
-	std::size_t tableID_;
-	std::size_t partitionID_;
+        Slot *find_slot(const void *key)
+        {
+		const auto &k = *static_cast<const KeyType *>(key);
+                uint64_t plain_key = k.get_plain_key();
+                if (slots == nullptr || plain_key < min_plain_key || plain_key - min_plain_key >= capacity) {
+                        return nullptr;
+                }
+                Slot *slot = &slots[plain_key - min_plain_key];
+                return slot->is_present ? slot : nullptr;
+        }
+
+        const uint64_t min_plain_key;
+        const uint64_t capacity;
+        std::unique_ptr<Slot[]> slots;
 };
 
-template <class KeyType, class ValueType, class KeyComparator, class ValueComparator, class MetaInitFunc = MetaInitFuncNothing> class TableBTreeOLC : public ITable {
+template <class KeyType, class ValueType, class KeyComparator, class ValueComparator, class MetaInitFunc = MetaInitFuncNothing> class TableBTreeOLC final : public ITable {
     public:
         using MetaDataType = std::atomic<uint64_t>;
 
@@ -412,8 +685,7 @@ template <class KeyType, class ValueType, class KeyComparator, class ValueCompar
 	virtual ~TableBTreeOLC() override = default;
 
 	TableBTreeOLC(std::size_t tableID, std::size_t partitionID)
-		: tableID_(tableID)
-		, partitionID_(partitionID)
+		: ITable(tableID, partitionID, sizeof(KeyType), sizeof(ValueType), ClassOf<ValueType>::size(), BTREE)
 	{
 	}
 
@@ -447,6 +719,32 @@ template <class KeyType, class ValueType, class KeyComparator, class ValueCompar
                 }
 	}
 
+
+        // the keys descend the index together, see BPlusTree::lookup_batch
+	void search_batch(const void *const *keys, std::tuple<MetaDataType *, void *> *rows, std::size_t n) override
+	{
+                tid_check();
+                const KeyType *k[BTree::kLookupBatchSize];
+                BTreeOLCValue values[BTree::kLookupBatchSize];
+                bool found[BTree::kLookupBatchSize];
+
+                for (std::size_t i = 0; i < n; i += BTree::kLookupBatchSize) {
+                        std::size_t batch_size = std::min(n - i, BTree::kLookupBatchSize);
+                        for (std::size_t j = 0; j < batch_size; j++) {
+                                k[j] = static_cast<const KeyType *>(keys[i + j]);
+                        }
+                        btree.lookup_batch(k, values, found, batch_size);
+                        for (std::size_t j = 0; j < batch_size; j++) {
+                                if (found[j] == true) {
+                                        MetaDataType *meta_ptr = reinterpret_cast<MetaDataType *>(&values[j].row->meta);
+                                        rows[i + j] = std::make_tuple(meta_ptr, &values[j].row->data);
+                                } else {
+                                        rows[i + j] = std::make_tuple(nullptr, nullptr);
+                                }
+                        }
+                }
+	}
+
 	void *search_value(const void *key) override
 	{
                 tid_check();
@@ -538,6 +836,44 @@ template <class KeyType, class ValueType, class KeyComparator, class ValueCompar
 		return success;
 	}
 
+        // the tree is built bottom-up, see BPlusTree::BulkLoader
+        void bulk_load_begin(double fill_factor) override
+        {
+                tid_check();
+                CHECK(bulk_loader == nullptr);
+                bulk_loader.reset(new typename BTree::BulkLoader(btree, fill_factor));
+        }
+
+        bool bulk_load_append(const void *key, const void *value) override
+        {
+                tid_check();
+                DCHECK(bulk_loader != nullptr);
+                const auto &k = *static_cast<const KeyType *>(key);
+                const auto &v = *static_cast<const ValueType *>(value);
+
+                ValueStruct *row = new ValueStruct;
+                CHECK(row != nullptr);
+                row->meta = MetaInitFunc()(true);
+                row->data = v;
+
+                BTreeOLCValue btree_value;
+                btree_value.row = row;
+
+                bool success = bulk_loader->append(k, btree_value);
+                if (success == false) {
+                        delete row;
+                }
+                return success;
+        }
+
+        void bulk_load_end() override
+        {
+                tid_check();
+                CHECK(bulk_loader != nullptr);
+                bulk_loader->finish();
+                bulk_loader.reset();
+        }
+
         // used by TwoPL
         bool insert_lock_next_key(const void *key, const void *value, std::function<bool(const void *, MetaDataType *, void *)> next_key_processor, bool is_placeholder = false) override
 	{
@@ -727,41 +1063,6 @@ template <class KeyType, class ValueType, class KeyComparator, class ValueCompar
 		DCHECK(enc.size() - size == ClassOf<ValueType>::size());
 	}
 
-	std::size_t key_size() override
-	{
-		tid_check();
-		return sizeof(KeyType);
-	}
-
-	std::size_t value_size() override
-	{
-		tid_check();
-		return sizeof(ValueType);
-	}
-
-	std::size_t field_size() override
-	{
-		tid_check();
-		return ClassOf<ValueType>::size();
-	}
-
-	std::size_t tableID() override
-	{
-		tid_check();
-		return tableID_;
-	}
-
-	std::size_t partitionID() override
-	{
-		tid_check();
-		return partitionID_;
-	}
-
-        int tableType() override
-        {
-                return BTREE;
-        }
-
         void move_all_into_cxl(std::function<bool(ITable *, const void *, std::tuple<MetaDataType *, void *> &, bool)> move_in_func) override
         {
                 auto processor = [&](const KeyType &key, BTreeOLCValue &value, bool) -> bool {
@@ -780,19 +1081,17 @@ template <class KeyType, class ValueType, class KeyComparator, class ValueCompar
 
     private:
 	BTree btree;
-	std::size_t tableID_;
-	std::size_t partitionID_;
+        std::unique_ptr<typename BTree::BulkLoader> bulk_loader;
 };
 
-template <class KeyType, class ValueType, class KeyComparator, class ValueComparator> class HStoreTable : public ITable {
+template <class KeyType, class ValueType, class KeyComparator, class ValueComparator> class HStoreTable final : public ITable {
     public:
 	using MetaDataType = std::atomic<uint64_t>;
 
 	virtual ~HStoreTable() override = default;
 
 	HStoreTable(std::size_t tableID, std::size_t partitionID)
-		: tableID_(tableID)
-		, partitionID_(partitionID)
+		: ITable(tableID, partitionID, sizeof(KeyType), sizeof(ValueType), ClassOf<ValueType>::size(), HASHMAP)
 	{
 	}
 
@@ -916,51 +1215,18 @@ template <class KeyType, class ValueType, class KeyComparator, class ValueCompar
 		DCHECK(enc.size() - size == ClassOf<ValueType>::size());
 	}
 
-	std::size_t key_size() override
-	{
-		return sizeof(KeyType);
-	}
-
-	std::size_t value_size() override
-	{
-		return sizeof(ValueType);
-	}
-
-	std::size_t field_size() override
-	{
-		return ClassOf<ValueType>::size();
-	}
-
-	std::size_t tableID() override
-	{
-		return tableID_;
-	}
-
-	std::size_t partitionID() override
-	{
-		return partitionID_;
-	}
-
-        int tableType() override
-        {
-                return HASHMAP;
-        }
-
     private:
 	UnsafeHashMap<KeyType, ValueType> map_;
-	std::size_t tableID_;
-	std::size_t partitionID_;
 };
 
-template <std::size_t N, class KeyType, class ValueType, class KeyComparator, class ValueComparator> class HStoreCOWTable : public ITable {
+template <std::size_t N, class KeyType, class ValueType, class KeyComparator, class ValueComparator> class HStoreCOWTable final : public ITable {
     public:
 	using MetaDataType = std::atomic<uint64_t>;
 
 	virtual ~HStoreCOWTable() override = default;
 
 	HStoreCOWTable(std::size_t tableID, std::size_t partitionID)
-		: tableID_(tableID)
-		, partitionID_(partitionID)
+		: ITable(tableID, partitionID, sizeof(KeyType), sizeof(ValueType), ClassOf<ValueType>::size(), HASHMAP)
 	{
 	}
 
@@ -1095,36 +1361,6 @@ template <std::size_t N, class KeyType, class ValueType, class KeyComparator, cl
 		DCHECK(enc.size() - size == ClassOf<ValueType>::size());
 	}
 
-	std::size_t key_size() override
-	{
-		return sizeof(KeyType);
-	}
-
-	std::size_t value_size() override
-	{
-		return sizeof(ValueType);
-	}
-
-	std::size_t field_size() override
-	{
-		return ClassOf<ValueType>::size();
-	}
-
-	std::size_t tableID() override
-	{
-		return tableID_;
-	}
-
-	std::size_t partitionID() override
-	{
-		return partitionID_;
-	}
-
-        int tableType() override
-        {
-                return HASHMAP;
-        }
-
 	virtual void turn_on_cow() override
 	{
 		CHECK(cow == false);
@@ -1171,8 +1407,6 @@ template <std::size_t N, class KeyType, class ValueType, class KeyComparator, cl
     private:
 	HashMap<N, KeyType, std::tuple<MetaDataType, ValueType> > map_;
 	HashMap<N, KeyType, std::tuple<MetaDataType, ValueType> > *shadow_map_ = nullptr;
-	std::size_t tableID_;
-	std::size_t partitionID_;
 	std::atomic<bool> dump_finished{ true };
 	std::atomic<bool> cow{ false };
 };
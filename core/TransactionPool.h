@@ -0,0 +1,57 @@
+//
+// Per-worker free lists of transaction objects
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <glog/logging.h>
+
+namespace star
+{
+
+/*
+ * A workload tags every transaction it creates with a pool slot (one slot per transaction class).
+ * When the executor is done with a transaction, it hands the object back and the workload
+ * re-initializes it in place for the next query instead of allocating and constructing a new one.
+ * Read/write sets and the attached Storage are kept, so their vectors retain their capacity.
+ *
+ * A pool is owned by a single worker and is not thread-safe.
+ */
+template <class Transaction> class TransactionPool {
+    public:
+	explicit TransactionPool(std::size_t slot_num)
+		: free_lists(slot_num)
+	{
+	}
+
+	// returns a recycled transaction of the given slot or nullptr if there is none
+	template <class T> T *get(std::size_t slot)
+	{
+		DCHECK(slot < free_lists.size());
+		auto &free_list = free_lists[slot];
+		if (free_list.empty()) {
+			return nullptr;
+		}
+		T *txn = static_cast<T *>(free_list.back().release());
+		free_list.pop_back();
+		return txn;
+	}
+
+	void put(std::unique_ptr<Transaction> txn)
+	{
+		// transactions that are not created by the pool are simply destroyed
+		if (txn == nullptr || txn->pool_slot < 0) {
+			return;
+		}
+		DCHECK(static_cast<std::size_t>(txn->pool_slot) < free_lists.size());
+		free_lists[txn->pool_slot].push_back(std::move(txn));
+	}
+
+    private:
+	std::vector<std::vector<std::unique_ptr<Transaction> > > free_lists;
+};
+
+} // namespace star
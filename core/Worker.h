@@ -5,6 +5,7 @@
 #pragma once
 
 #include "common/LockfreeQueue.h"
+#include "common/Percentile.h"
 #include "common/Message.h"
 #include <atomic>
 #include <glog/logging.h>
@@ -36,6 +37,16 @@ class Worker {
 	{
 	}
 
+	// merges the latency of committed transactions into a coordinator-wide histogram
+	virtual void collect_latency(Percentile<int64_t> &latency)
+	{
+	}
+
+	// merges the latency from the intended arrival and the queueing delay of open-loop transactions
+	virtual void collect_open_loop_latency(Percentile<int64_t> &latency, Percentile<int64_t> &delay)
+	{
+	}
+
 	virtual void start_hstore_master()
 	{
 	}
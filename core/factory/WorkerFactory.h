@@ -48,6 +48,8 @@
 #include "protocol/TwoPLPasha/TwoPLPashaExecutor.h"
 #include "protocol/SundialPasha/SundialPasha.h"
 #include "protocol/SundialPasha/SundialPashaExecutor.h"
+#include "protocol/SiloPasha/SiloPasha.h"
+#include "protocol/SiloPasha/SiloPashaExecutor.h"
 
 #include <unordered_set>
 
@@ -83,9 +85,18 @@ class WorkerFactory {
 	static std::vector<std::shared_ptr<Worker> > create_workers(std::size_t coordinator_id, Database &db, const Context &context,
 								    std::atomic<bool> &stop_flag)
 	{
-		std::unordered_set<std::string> protocols = { "Silo", "SiloGC", "Star", "Sundial", "TwoPL", "TwoPLGC", "Calvin", "HStore", "Aria", "TwoPLPasha", "SundialPasha" };
+		std::unordered_set<std::string> protocols = { "Silo", "SiloGC", "Star", "Sundial", "TwoPL", "TwoPLGC", "Calvin", "HStore", "Aria", "TwoPLPasha", "SundialPasha", "SiloPasha" };
 		CHECK(protocols.count(context.protocol) == 1);
 
+		// open-loop arrivals are generated by the transaction loop of core/Executor.h, protocols with their own loop run closed-loop
+		std::unordered_set<std::string> open_loop_protocols = { "Silo", "Sundial", "TwoPL", "TwoPLPasha", "SundialPasha", "SiloPasha" };
+		CHECK(context.open_loop_tps == 0 || open_loop_protocols.count(context.protocol) == 1)
+			<< "open-loop arrivals are not supported by " << context.protocol;
+
+		// transaction ids pack the coordinator id and the worker id into 16 bits each, see Workload::next_transaction_id
+		CHECK(context.coordinator_num <= (1ull << 16)) << "too many coordinators for the transaction id layout";
+		CHECK(context.worker_num <= (1ull << 16)) << "too many workers for the transaction id layout";
+
 		std::vector<std::shared_ptr<Worker> > workers;
 
 		if (context.protocol == "Silo") {
@@ -124,6 +135,18 @@ class WorkerFactory {
 												   manager->n_completed_workers, manager->n_started_workers));
 			}
 
+			workers.push_back(manager);
+                } else if (context.protocol == "SiloPasha") {
+			using TransactionType = star::SiloPashaTransaction;
+			using WorkloadType = typename InferType<Context>::template WorkloadType<TransactionType>;
+
+			auto manager = std::make_shared<Manager>(coordinator_id, context.worker_num, context, stop_flag);
+
+			for (auto i = 0u; i < context.worker_num; i++) {
+				workers.push_back(std::make_shared<SiloPashaExecutor<WorkloadType> >(coordinator_id, i, db, context, manager->worker_status,
+												   manager->n_completed_workers, manager->n_started_workers));
+			}
+
 			workers.push_back(manager);
 		} else if (context.protocol == "SiloGC") {
 			using TransactionType = star::SiloTransaction;
@@ -204,6 +227,10 @@ class WorkerFactory {
 			using TransactionType = star::CalvinTransaction;
 			using WorkloadType = typename InferType<Context>::template WorkloadType<TransactionType>;
 
+			// Calvin transaction ids only have 8 bits each for the coordinator id and the worker id
+			CHECK(context.coordinator_num <= (1ull << 8)) << "too many coordinators for Calvin transaction ids";
+			CHECK(context.worker_num <= (1ull << 8)) << "too many workers for Calvin transaction ids";
+
 			// create manager
 
 			auto manager = std::make_shared<CalvinManager<WorkloadType> >(coordinator_id, context.worker_num, db, context, stop_flag);
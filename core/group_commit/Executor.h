@@ -86,6 +86,7 @@ template <class Workload, class Protocol> class Executor : public Worker {
 				auto &ptr = q.front();
 				auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - ptr->startTime).count();
 				commit_latency.add(latency);
+				workload.recycle_transaction(std::move(ptr));
 				q.pop();
 			}
 
@@ -107,6 +108,7 @@ template <class Workload, class Protocol> class Executor : public Worker {
 					} else {
 						auto partition_id = get_partition_id();
 
+						workload.recycle_transaction(std::move(transaction));
 						transaction = workload.next_transaction(context, partition_id, this->id);
 						setupHandlers(*transaction);
 					}
@@ -178,6 +180,11 @@ template <class Workload, class Protocol> class Executor : public Worker {
 		}
 	}
 
+	void collect_latency(Percentile<int64_t> &latency) override
+	{
+		latency.merge(write_latency);
+	}
+
 	void onExit() override
 	{
 		LOG(INFO) << "Worker " << id << " latency: " << commit_latency.nth(50) << " us (50%) " << commit_latency.nth(75) << " us (75%) "
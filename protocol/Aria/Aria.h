@@ -6,6 +6,7 @@
 
 #include "core/Partitioner.h"
 #include "core/Table.h"
+#include "protocol/Aria/AriaCXLHelper.h"
 #include "protocol/Aria/AriaHelper.h"
 #include "protocol/Aria/AriaMessage.h"
 #include "protocol/Aria/AriaTransaction.h"
@@ -51,6 +52,9 @@ template <class Database> class Aria {
 				table->update(key, value);
 			} else {
 				auto coordinatorID = partitioner.master_coordinator(partitionId);
+				if (context.aria_cxl) {
+					aria_cxl_helper->add_pending_write(coordinatorID);
+				}
 				txn.network_size +=
 					MessageFactoryType::new_write_message(*messages[coordinatorID], *table, writeKey.get_key(), writeKey.get_value());
 			}
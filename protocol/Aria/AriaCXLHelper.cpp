@@ -0,0 +1,7 @@
+#include "protocol/Aria/AriaCXLHelper.h"
+
+namespace star {
+
+AriaCXLHelper *aria_cxl_helper = nullptr;
+
+}
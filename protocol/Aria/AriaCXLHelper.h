@@ -0,0 +1,180 @@
+//
+// Reservation metadata and epoch barriers of Aria in the shared CXL region
+//
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "common/CXLMemory.h"
+#include "core/CXLTable.h"
+#include "core/Table.h"
+
+#include <glog/logging.h>
+
+namespace star
+{
+
+/*
+ * Shared by all hosts, allocated by host 0.
+ * The barrier is generation-based: the last host to arrive resets the arrival counter and starts the next generation.
+ * The coordinator publishes a new executor status by storing it and then bumping signal_seq.
+ * It is followed by coordinator_num pending write counters, the i-th one counts the write requests
+ * sent to host i that host i has not applied yet.
+ */
+struct AriaCXLSharedState {
+	std::atomic<uint64_t> barrier_arrived;
+	std::atomic<uint64_t> barrier_generation;
+	std::atomic<uint64_t> signal_seq;
+	std::atomic<uint32_t> signal_status;
+};
+
+class AriaCXLHelper {
+    public:
+	using MetaDataType = std::atomic<uint64_t>;
+
+	static constexpr std::size_t reservation_words_per_chunk = 4096;
+
+	AriaCXLHelper(std::size_t coordinator_id, std::size_t coordinator_num, std::vector<std::vector<CXLTableBase *> > &cxl_tbl_vecs)
+		: coordinator_id(coordinator_id)
+		, coordinator_num(coordinator_num)
+		, cxl_tbl_vecs(cxl_tbl_vecs)
+	{
+		if (coordinator_id == 0) {
+			auto size = sizeof(AriaCXLSharedState) + sizeof(std::atomic<int64_t>) * coordinator_num;
+			shared_state = reinterpret_cast<AriaCXLSharedState *>(cxl_memory.cxlalloc_malloc_wrapper(size, CXLMemory::MISC_ALLOCATION));
+			shared_state->barrier_arrived.store(0);
+			shared_state->barrier_generation.store(0);
+			shared_state->signal_seq.store(0);
+			shared_state->signal_status.store(0);
+			for (auto i = 0u; i < coordinator_num; i++) {
+				new (&reinterpret_cast<std::atomic<int64_t> *>(shared_state + 1)[i]) std::atomic<int64_t>(0);
+			}
+			CXLMemory::commit_shared_data_initialization(CXLMemory::cxl_aria_root_index, shared_state);
+		} else {
+			void *tmp = NULL;
+			CXLMemory::wait_and_retrieve_cxl_shared_data(CXLMemory::cxl_aria_root_index, &tmp);
+			shared_state = reinterpret_cast<AriaCXLSharedState *>(tmp);
+		}
+		pending_writes = reinterpret_cast<std::atomic<int64_t> *>(shared_state + 1);
+	}
+
+	// each row owned by this host gets a reservation word in CXL;
+	// the DRAM metadata of the row points to it and the CXL index maps the key to it
+	void publish_reservation_words(ITable *table, double fill_factor)
+	{
+		CXLTableBase *cxl_table = cxl_tbl_vecs[table->tableID()][table->partitionID()];
+		bool bulk_load = table->tableType() == ITable::BTREE;
+
+		if (bulk_load == true) {
+			cxl_table->bulk_load_begin(fill_factor);
+		}
+		auto publish = [&](ITable *table, const void *key, std::tuple<MetaDataType *, void *> &row, bool) -> bool {
+			MetaDataType *word = create_reservation_word();
+			std::get<0>(row)->store(reinterpret_cast<uint64_t>(word));
+			bool ret = bulk_load ? cxl_table->bulk_load_append(key, word) : cxl_table->insert(key, word);
+			CHECK(ret == true);
+			return true;
+		};
+		table->move_all_into_cxl(publish);
+		if (bulk_load == true) {
+			cxl_table->bulk_load_end();
+		}
+	}
+
+	static MetaDataType &get_local_reservation_word(MetaDataType *meta)
+	{
+		auto word = reinterpret_cast<MetaDataType *>(meta->load());
+		CHECK(word != nullptr);
+		return *word;
+	}
+
+	MetaDataType &get_remote_reservation_word(std::size_t table_id, std::size_t partition_id, const void *key)
+	{
+		auto word = reinterpret_cast<MetaDataType *>(cxl_tbl_vecs[table_id][partition_id]->search(key));
+		CHECK(word != nullptr);
+		return *word;
+	}
+
+	// every host calls barrier() once per generation
+	void barrier()
+	{
+		uint64_t generation = shared_state->barrier_generation.load();
+		if (shared_state->barrier_arrived.fetch_add(1) + 1 == coordinator_num) {
+			shared_state->barrier_arrived.store(0);
+			shared_state->barrier_generation.store(generation + 1);
+		} else {
+			while (shared_state->barrier_generation.load() == generation) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	// only the coordinator calls this function
+	void signal(uint32_t status)
+	{
+		DCHECK(coordinator_id == 0);
+		shared_state->signal_status.store(status);
+		shared_state->signal_seq.fetch_add(1);
+	}
+
+	// only non-coordinators call this function
+	uint32_t wait4_signal()
+	{
+		DCHECK(coordinator_id != 0);
+		while (shared_state->signal_seq.load() == last_signal_seq) {
+			std::this_thread::yield();
+		}
+		last_signal_seq++;
+		return shared_state->signal_status.load();
+	}
+
+	void add_pending_write(std::size_t dest_coordinator_id)
+	{
+		pending_writes[dest_coordinator_id].fetch_add(1);
+	}
+
+	void finish_pending_write()
+	{
+		pending_writes[coordinator_id].fetch_sub(1);
+	}
+
+	// after a barrier, no host sends more writes to this host, so it only has to wait for the ones in flight
+	void wait_for_pending_writes()
+	{
+		while (pending_writes[coordinator_id].load() > 0) {
+			std::this_thread::yield();
+		}
+	}
+
+    private:
+	MetaDataType *create_reservation_word()
+	{
+		if (next_word == reservation_words_per_chunk) {
+			auto size = sizeof(MetaDataType) * reservation_words_per_chunk;
+			word_chunk = reinterpret_cast<MetaDataType *>(cxl_memory.cxlalloc_malloc_wrapper(size, CXLMemory::METADATA_ALLOCATION));
+			for (auto i = 0u; i < reservation_words_per_chunk; i++) {
+				new (&word_chunk[i]) MetaDataType(0);
+			}
+			next_word = 0;
+		}
+		return &word_chunk[next_word++];
+	}
+
+	std::size_t coordinator_id;
+	std::size_t coordinator_num;
+	std::vector<std::vector<CXLTableBase *> > &cxl_tbl_vecs;
+	AriaCXLSharedState *shared_state = nullptr;
+	std::atomic<int64_t> *pending_writes = nullptr;
+	uint64_t last_signal_seq = 0;
+
+	MetaDataType *word_chunk = nullptr;
+	std::size_t next_word = reservation_words_per_chunk;
+};
+
+extern AriaCXLHelper *aria_cxl_helper;
+
+} // namespace star
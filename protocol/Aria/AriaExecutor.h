@@ -12,6 +12,7 @@
 #include "glog/logging.h"
 
 #include "protocol/Aria/Aria.h"
+#include "protocol/Aria/AriaCXLHelper.h"
 #include "protocol/Aria/AriaHelper.h"
 #include "protocol/Aria/AriaMessage.h"
 
@@ -184,7 +185,7 @@ template <class Workload> class AriaExecutor : public Worker {
 					}
 				}
 				if (context.straggler_zipf_factor > 0) {
-					int length_type = star::Zipf::globalZipfForStraggler().value(random.next_double());
+					int length_type = star::Zipf::globalZipfForStraggler().value(random);
 					transactions[i]->straggler_wait_time = transaction_lengths[length_type];
 					transaction_lengths_count[length_type]++;
 				}
@@ -273,8 +274,8 @@ template <class Workload> class AriaExecutor : public Worker {
 			auto tableId = readKey.get_table_id();
 			auto partitionId = readKey.get_partition_id();
 			auto table = db.find_table(tableId, partitionId);
-			if (partitioner->has_master_partition(partitionId)) {
-				std::atomic<uint64_t> &tid = AriaHelper::get_metadata(table, readKey);
+			if (partitioner->has_master_partition(partitionId) || context.aria_cxl) {
+				std::atomic<uint64_t> &tid = get_reservation_word(table, readKey);
 				readKey.set_tid(&tid);
 				AriaHelper::reserve_read(tid, txn.epoch, txn.id);
 			} else {
@@ -290,8 +291,8 @@ template <class Workload> class AriaExecutor : public Worker {
 			auto tableId = writeKey.get_table_id();
 			auto partitionId = writeKey.get_partition_id();
 			auto table = db.find_table(tableId, partitionId);
-			if (partitioner->has_master_partition(partitionId)) {
-				std::atomic<uint64_t> &tid = AriaHelper::get_metadata(table, writeKey);
+			if (partitioner->has_master_partition(partitionId) || context.aria_cxl) {
+				std::atomic<uint64_t> &tid = get_reservation_word(table, writeKey);
 				writeKey.set_tid(&tid);
 				AriaHelper::reserve_write(tid, txn.epoch, txn.id);
 			} else {
@@ -323,8 +324,8 @@ template <class Workload> class AriaExecutor : public Worker {
 			auto partitionId = readKey.get_partition_id();
 			auto table = db.find_table(tableId, partitionId);
 
-			if (partitioner->has_master_partition(partitionId)) {
-				uint64_t tid = AriaHelper::get_metadata(table, readKey).load();
+			if (partitioner->has_master_partition(partitionId) || context.aria_cxl) {
+				uint64_t tid = get_reservation_word(table, readKey).load();
 				uint64_t epoch = AriaHelper::get_epoch(tid);
 				uint64_t wts = AriaHelper::get_wts(tid);
 				DCHECK(epoch == txn.epoch);
@@ -349,8 +350,8 @@ template <class Workload> class AriaExecutor : public Worker {
 			auto partitionId = writeKey.get_partition_id();
 			auto table = db.find_table(tableId, partitionId);
 
-			if (partitioner->has_master_partition(partitionId)) {
-				uint64_t tid = AriaHelper::get_metadata(table, writeKey).load();
+			if (partitioner->has_master_partition(partitionId) || context.aria_cxl) {
+				uint64_t tid = get_reservation_word(table, writeKey).load();
 				uint64_t epoch = AriaHelper::get_epoch(tid);
 				uint64_t rts = AriaHelper::get_rts(tid);
 				uint64_t wts = AriaHelper::get_wts(tid);
@@ -370,6 +371,23 @@ template <class Workload> class AriaExecutor : public Worker {
 		}
 	}
 
+	// with aria_cxl, the reservation word of every row is in CXL and is reserved and checked in place,
+	// the DRAM metadata of a local row points to it and remote rows are found through the CXL index
+	std::atomic<uint64_t> &get_reservation_word(ITable *table, const AriaRWKey &key)
+	{
+		if (context.aria_cxl == false) {
+			return AriaHelper::get_metadata(table, key);
+		}
+		auto tid = key.get_tid();
+		if (tid) {
+			return *tid;
+		}
+		if (partitioner->has_master_partition(key.get_partition_id())) {
+			return AriaCXLHelper::get_local_reservation_word(table->search_metadata(key.get_key()));
+		}
+		return aria_cxl_helper->get_remote_reservation_word(key.get_table_id(), key.get_partition_id(), key.get_key());
+	}
+
 	void commit_transactions()
 	{
 		std::size_t count = 0;
@@ -503,7 +521,11 @@ template <class Workload> class AriaExecutor : public Worker {
 			if (local_read || local_index_read) {
 				// set tid meta_data
 				auto row = table->search(key);
-				AriaHelper::set_key_tid(readKey, row);
+				if (context.aria_cxl) {
+					readKey.set_tid(&AriaCXLHelper::get_local_reservation_word(std::get<0>(row)));
+				} else {
+					AriaHelper::set_key_tid(readKey, row);
+				}
 				AriaHelper::read(row, value, table->value_size());
 			} else {
 				auto coordinatorID = this->partitioner->master_coordinator(partition_id);
@@ -518,6 +540,11 @@ template <class Workload> class AriaExecutor : public Worker {
 		txn.message_flusher = [this]() { this->flush_messages(); };
 	}
 
+	void collect_latency(Percentile<int64_t> &latency) override
+	{
+		latency.merge(percentile);
+	}
+
 	void onExit() override
 	{
 		std::string transaction_len_str;
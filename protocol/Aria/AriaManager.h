@@ -7,6 +7,7 @@
 #include "core/Manager.h"
 #include "core/Partitioner.h"
 #include "protocol/Aria/Aria.h"
+#include "protocol/Aria/AriaCXLHelper.h"
 #include "protocol/Aria/AriaExecutor.h"
 #include "protocol/Aria/AriaHelper.h"
 #include "protocol/Aria/AriaTransaction.h"
@@ -58,6 +59,27 @@ template <class Workload> class AriaManager : public star::Manager {
                                 logger = context.master_logger;
                         }
                 }
+
+		if (context.aria_cxl) {
+			// every host places the reservation words of the rows it owns in CXL
+			auto &cxl_tbl_vecs = db.create_or_retrieve_cxl_tables(context);
+			aria_cxl_helper = new AriaCXLHelper(coordinator_id, context.coordinator_num, cxl_tbl_vecs);
+			// a row without a CXL index has no reservation word, so every table of the workload needs one
+			CHECK(cxl_tbl_vecs.size() == db.get_table_num_per_partition());
+			for (auto i = 0u; i < cxl_tbl_vecs.size(); i++) {
+				CHECK(cxl_tbl_vecs[i].size() == context.partition_num)
+					<< "aria_cxl requires a CXL index for every table, table " << i << " has none in this workload";
+			}
+			for (auto i = 0u; i < cxl_tbl_vecs.size(); i++) {
+				for (auto j = 0u; j < cxl_tbl_vecs[i].size(); j++) {
+					if (partitioner->has_master_partition(j)) {
+						aria_cxl_helper->publish_reservation_words(db.find_table(i, j), context.btree_fill_factor);
+					}
+				}
+			}
+			aria_cxl_helper->barrier();
+			LOG(INFO) << "Aria publishes reservation words in CXL";
+		}
 	}
 
 	std::size_t get_partition_id()
@@ -108,16 +130,15 @@ template <class Workload> class AriaManager : public star::Manager {
 
 			n_started_workers.store(0);
 			n_completed_workers.store(0);
-			signal_worker(ExecutorStatus::Aria_COLLECT_XACT);
+			signal_phase(ExecutorStatus::Aria_COLLECT_XACT);
 			wait_all_workers_start();
 			wait_all_workers_finish();
-			broadcast_stop();
-			wait4_stop(n_coordinators - 1);
+			wait4_phase_stop();
 			n_completed_workers.store(0);
 			set_worker_status(ExecutorStatus::STOP);
 			wait_all_workers_finish();
 			// wait for all machines until they finish the Aria_COLLECT_XACT phase.
-			wait4_ack();
+			phase_ack();
 
 			// Log the transactions generated by these transactions
 			log_transactions();
@@ -125,33 +146,31 @@ template <class Workload> class AriaManager : public star::Manager {
 			// LOG(INFO) << "Seed: " << random.get_seed();
 			n_started_workers.store(0);
 			n_completed_workers.store(0);
-			signal_worker(ExecutorStatus::Aria_READ);
+			signal_phase(ExecutorStatus::Aria_READ);
 			wait_all_workers_start();
 			wait_all_workers_finish();
-			broadcast_stop();
-			wait4_stop(n_coordinators - 1);
+			wait4_phase_stop();
 			n_completed_workers.store(0);
 			set_worker_status(ExecutorStatus::STOP);
 			wait_all_workers_finish();
 			// wait for all machines until they finish the Aria_READ phase.
-			wait4_ack();
+			phase_ack();
 
 			// Allow each worker to commit transactions
 			n_started_workers.store(0);
 			n_completed_workers.store(0);
-			signal_worker(ExecutorStatus::Aria_COMMIT);
+			signal_phase(ExecutorStatus::Aria_COMMIT);
 			wait_all_workers_start();
 			wait_all_workers_finish();
-			broadcast_stop();
-			wait4_stop(n_coordinators - 1);
+			wait4_phase_stop();
 			n_completed_workers.store(0);
 			set_worker_status(ExecutorStatus::STOP);
 			wait_all_workers_finish();
 			// wait for all machines until they finish the Aria_COMMIT phase.
-			wait4_ack();
+			phase_ack();
 		}
 
-		signal_worker(ExecutorStatus::EXIT);
+		signal_phase(ExecutorStatus::EXIT);
 	}
 
 	void non_coordinator_start() override
@@ -161,7 +180,7 @@ template <class Workload> class AriaManager : public star::Manager {
 
 		for (;;) {
 			// LOG(INFO) << "Seed: " << random.get_seed();
-			ExecutorStatus status = wait4_signal();
+			ExecutorStatus status = wait4_phase_signal();
 			if (status == ExecutorStatus::EXIT) {
 				set_worker_status(ExecutorStatus::EXIT);
 				break;
@@ -180,14 +199,13 @@ template <class Workload> class AriaManager : public star::Manager {
 			set_worker_status(ExecutorStatus::Aria_COLLECT_XACT);
 			wait_all_workers_start();
 			wait_all_workers_finish();
-			broadcast_stop();
-			wait4_stop(n_coordinators - 1);
+			wait4_phase_stop();
 			n_completed_workers.store(0);
 			set_worker_status(ExecutorStatus::STOP);
 			wait_all_workers_finish();
-			send_ack();
+			phase_ack();
 
-			status = wait4_signal();
+			status = wait4_phase_signal();
 
 			// Log the transactions generated by these transactions
 			log_transactions();
@@ -198,25 +216,67 @@ template <class Workload> class AriaManager : public star::Manager {
 			set_worker_status(ExecutorStatus::Aria_READ);
 			wait_all_workers_start();
 			wait_all_workers_finish();
-			broadcast_stop();
-			wait4_stop(n_coordinators - 1);
+			wait4_phase_stop();
 			n_completed_workers.store(0);
 			set_worker_status(ExecutorStatus::STOP);
 			wait_all_workers_finish();
-			send_ack();
+			phase_ack();
 
-			status = wait4_signal();
+			status = wait4_phase_signal();
 			DCHECK(status == ExecutorStatus::Aria_COMMIT);
 			n_started_workers.store(0);
 			n_completed_workers.store(0);
 			set_worker_status(ExecutorStatus::Aria_COMMIT);
 			wait_all_workers_start();
 			wait_all_workers_finish();
-			broadcast_stop();
-			wait4_stop(n_coordinators - 1);
+			wait4_phase_stop();
 			n_completed_workers.store(0);
 			set_worker_status(ExecutorStatus::STOP);
 			wait_all_workers_finish();
+			phase_ack();
+		}
+	}
+
+	// with aria_cxl, the phases are coordinated through the shared CXL region instead of control messages
+
+	void signal_phase(ExecutorStatus status)
+	{
+		if (context.aria_cxl) {
+			set_worker_status(status);
+			aria_cxl_helper->signal(static_cast<uint32_t>(status));
+		} else {
+			signal_worker(status);
+		}
+	}
+
+	ExecutorStatus wait4_phase_signal()
+	{
+		if (context.aria_cxl) {
+			return static_cast<ExecutorStatus>(aria_cxl_helper->wait4_signal());
+		} else {
+			return wait4_signal();
+		}
+	}
+
+	void wait4_phase_stop()
+	{
+		if (context.aria_cxl) {
+			// all hosts have sent their writes once they pass the barrier
+			aria_cxl_helper->barrier();
+			aria_cxl_helper->wait_for_pending_writes();
+		} else {
+			broadcast_stop();
+			wait4_stop(context.coordinator_num - 1);
+		}
+	}
+
+	void phase_ack()
+	{
+		if (context.aria_cxl) {
+			aria_cxl_helper->barrier();
+		} else if (coordinator_id == 0) {
+			wait4_ack();
+		} else {
 			send_ack();
 		}
 	}
@@ -9,6 +9,7 @@
 #include "common/MessagePiece.h"
 #include "core/ControlMessage.h"
 #include "core/Table.h"
+#include "protocol/Aria/AriaCXLHelper.h"
 #include "protocol/Aria/AriaRWKey.h"
 #include "protocol/Aria/AriaTransaction.h"
 
@@ -376,6 +377,11 @@ class AriaMessageHandler {
 		stringPiece.remove_prefix(field_size);
 
 		table.deserialize_value(key, valueStringPiece);
+
+		// with aria_cxl, the end of a phase waits for the writes in flight through this counter
+		if (aria_cxl_helper != nullptr) {
+			aria_cxl_helper->finish_pending_write();
+		}
 	}
 
 	static std::vector<std::function<void(MessagePiece, Message &, ITable &, std::vector<std::unique_ptr<Transaction> > &)> > get_message_handlers()
@@ -0,0 +1,7 @@
+#include "protocol/Calvin/CalvinCXLHelper.h"
+
+namespace star {
+
+CalvinCXLHelper *calvin_cxl_helper = nullptr;
+
+}
@@ -0,0 +1,137 @@
+//
+// Lock request logs of Calvin in the shared CXL region
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+
+#include "common/CXLMemory.h"
+
+#include <boost/interprocess/offset_ptr.hpp>
+#include <glog/logging.h>
+
+namespace star
+{
+
+/*
+ * In every batch, the lock manager of each host publishes one log with the lock requests of its transactions.
+ * The log starts with coordinator_num section ends; section i holds the requests for the partitions of host i,
+ * so the lock manager of host i reads them in place and writes its vote back into each request.
+ *
+ * A request is followed by n_keys keys, each one a CalvinCXLLockKey followed by the key bytes.
+ */
+struct CalvinCXLLockRequest {
+	enum { VOTE_PENDING = 0, VOTE_NO, VOTE_YES };
+
+	int64_t tid;
+	int32_t source_coordinator;
+	uint32_t n_keys;
+	uint32_t size; // bytes of the request and its keys, 8-byte aligned
+	std::atomic<uint32_t> vote;
+};
+
+struct CalvinCXLLockKey {
+	uint32_t table_id;
+	uint32_t partition_id;
+	uint32_t key_size;
+	uint32_t read_or_write;
+};
+
+class CalvinCXLHelper {
+    public:
+	struct LogSlot {
+		boost::interprocess::offset_ptr<char> log;
+		uint64_t capacity;
+	};
+
+	CalvinCXLHelper(std::size_t coordinator_id, std::size_t coordinator_num)
+		: coordinator_id(coordinator_id)
+		, coordinator_num(coordinator_num)
+	{
+		if (coordinator_id == 0) {
+			slots = reinterpret_cast<LogSlot *>(cxl_memory.cxlalloc_malloc_wrapper(sizeof(LogSlot) * coordinator_num, CXLMemory::MISC_ALLOCATION));
+			for (auto i = 0u; i < coordinator_num; i++) {
+				new (&slots[i]) LogSlot();
+				slots[i].log = nullptr;
+				slots[i].capacity = 0;
+			}
+			CXLMemory::commit_shared_data_initialization(CXLMemory::cxl_calvin_root_index, slots);
+		} else {
+			void *tmp = NULL;
+			CXLMemory::wait_and_retrieve_cxl_shared_data(CXLMemory::cxl_calvin_root_index, &tmp);
+			slots = reinterpret_cast<LogSlot *>(tmp);
+		}
+	}
+
+	// appends a request to a log built in DRAM and returns its offset in the log
+	static std::size_t append_lock_request(std::string &log, int64_t tid, int32_t source_coordinator, uint32_t n_keys)
+	{
+		auto offset = log.size();
+		log.append(sizeof(CalvinCXLLockRequest), 0);
+		auto req = reinterpret_cast<CalvinCXLLockRequest *>(&log[offset]);
+		req->tid = tid;
+		req->source_coordinator = source_coordinator;
+		req->n_keys = n_keys;
+		return offset;
+	}
+
+	static void append_lock_key(std::string &log, uint32_t table_id, uint32_t partition_id, bool read_or_write, const void *key, uint32_t key_size)
+	{
+		CalvinCXLLockKey lock_key = { table_id, partition_id, key_size, read_or_write };
+		log.append(reinterpret_cast<const char *>(&lock_key), sizeof(lock_key));
+		log.append(reinterpret_cast<const char *>(key), key_size);
+	}
+
+	static void finish_lock_request(std::string &log, std::size_t offset)
+	{
+		log.append((8 - log.size() % 8) % 8, 0);
+		reinterpret_cast<CalvinCXLLockRequest *>(&log[offset])->size = log.size() - offset;
+	}
+
+	// copies the log of this host into CXL, the previous log is no longer read by anyone once a new batch starts
+	char *publish_log(const std::string &log)
+	{
+		LogSlot &slot = slots[coordinator_id];
+		if (slot.capacity < log.size()) {
+			if (slot.log != nullptr) {
+				// the wrapper only updates the statistics, the memory goes back to cxlalloc like EBR reclaims it
+				cxl_memory.cxlalloc_free_wrapper(slot.log.get(), slot.capacity, CXLMemory::MISC_FREE);
+				cxlalloc_free(slot.log.get());
+			}
+			auto capacity = std::max<uint64_t>(log.size(), slot.capacity * 2);
+			slot.log = reinterpret_cast<char *>(cxl_memory.cxlalloc_malloc_wrapper(capacity, CXLMemory::MISC_ALLOCATION));
+			slot.capacity = capacity;
+		}
+		std::memcpy(slot.log.get(), log.data(), log.size());
+		std::atomic_thread_fence(std::memory_order_release);
+		return slot.log.get();
+	}
+
+	char *get_log(std::size_t source_coordinator)
+	{
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return slots[source_coordinator].log.get();
+	}
+
+	// the section of a log with the requests for the partitions of host target_coordinator
+	void get_section(char *log, std::size_t target_coordinator, char *&begin, char *&end)
+	{
+		auto section_ends = reinterpret_cast<uint64_t *>(log);
+		auto section_begin = target_coordinator == 0 ? sizeof(uint64_t) * coordinator_num : section_ends[target_coordinator - 1];
+		begin = log + section_begin;
+		end = log + section_ends[target_coordinator];
+	}
+
+    private:
+	std::size_t coordinator_id;
+	std::size_t coordinator_num;
+	LogSlot *slots = nullptr;
+};
+
+extern CalvinCXLHelper *calvin_cxl_helper;
+
+} // namespace star
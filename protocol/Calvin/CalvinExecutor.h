@@ -12,6 +12,7 @@
 #include "glog/logging.h"
 
 #include "protocol/Calvin/Calvin.h"
+#include "protocol/Calvin/CalvinCXLHelper.h"
 #include "protocol/Calvin/CalvinHelper.h"
 #include "protocol/Calvin/CalvinMessage.h"
 
@@ -108,7 +109,8 @@ template <class Workload> class CalvinExecutor : public Worker {
 	{
 		for (std::size_t i = 0; i < lock_requests_current_batch.size(); ++i) {
 			for (std::size_t j = 0; j < lock_requests_current_batch[i].keys.size(); ++j) {
-				if (lock_requests_current_batch[i].source_coordinator != (int)coordinator_id) {
+				// with calvin_cxl, the keys of remote requests point into their logs in CXL
+				if (lock_requests_current_batch[i].source_coordinator != (int)coordinator_id && context.calvin_cxl == false) {
 					delete[]((char *)lock_requests_current_batch[i].keys[j].get_key());
 				}
 			}
@@ -116,19 +118,20 @@ template <class Workload> class CalvinExecutor : public Worker {
 		lock_requests_current_batch.clear();
 	}
 
-	static int64_t next_transaction_id(std::size_t epoch, uint64_t coordinator_id)
+	int64_t next_transaction_id(std::size_t epoch, uint64_t coordinator_id)
 	{
-		// tid format : epoch id (24bits) | coordinator id(8 bits) | counter (32 bits)
+		// tid format : epoch id (24bits) | coordinator id(8 bits) | worker id (8 bits) | per-worker counter (24 bits)
+		// the counter is private to this executor and only has to be unique within an epoch, so it wraps around
 		CHECK(epoch < (1ull << 24));
 		CHECK(coordinator_id < (1ull << 8));
 		constexpr int epoch_id_offset = 40;
 		constexpr int coordinator_id_offset = epoch_id_offset - 8;
-		static std::atomic<int64_t> tid_static{ 1 };
-		auto tid = tid_static.fetch_add(1);
-		CHECK(tid < (1ll << 32));
-		return (epoch << epoch_id_offset) | ((int64_t)coordinator_id << coordinator_id_offset) | tid;
+		constexpr int worker_id_offset = coordinator_id_offset - 8;
+		auto tid = ++tid_counter & ((1ull << worker_id_offset) - 1);
+		return (epoch << epoch_id_offset) | ((int64_t)coordinator_id << coordinator_id_offset) | ((int64_t)id << worker_id_offset) | tid;
 	}
 
+	uint64_t tid_counter = 0;
 	std::size_t epoch = 0;
 	void start() override
 	{
@@ -179,11 +182,16 @@ template <class Workload> class CalvinExecutor : public Worker {
 					// send lock requests to remote node
 					// LOG(INFO) << "LockRequest active transactions " << active_transactions.load();
 					dtxn_lock_requests = 0;
-					send_lock_requests();
-					// Wait until we have recevied all the lock requests from all coordinators
-					// which is signaled by the CalvinMessage::LOCK_REQUEST_DONE message
-					while (lock_request_done_received < partitioner.total_coordinators()) {
-						process_request();
+					if (context.calvin_cxl) {
+						// the other hosts read the published log once all of them reach LockResponse
+						publish_cxl_lock_requests();
+					} else {
+						send_lock_requests();
+						// Wait until we have recevied all the lock requests from all coordinators
+						// which is signaled by the CalvinMessage::LOCK_REQUEST_DONE message
+						while (lock_request_done_received < partitioner.total_coordinators()) {
+							process_request();
+						}
 					}
 				}
 				n_complete_workers.fetch_add(1);
@@ -197,6 +205,9 @@ template <class Workload> class CalvinExecutor : public Worker {
 				// This stage is for lock manager thread only
 				if (id < n_lock_manager) {
 					// grant locks to transactions
+					if (context.calvin_cxl) {
+						read_cxl_lock_requests();
+					}
 					DCHECK(lock_requests_current_batch.size());
 					grant_locks_and_reply();
 					wait_for_all_lock_requests_processed();
@@ -239,6 +250,11 @@ template <class Workload> class CalvinExecutor : public Worker {
 		}
 	}
 
+	void collect_latency(Percentile<int64_t> &latency) override
+	{
+		latency.merge(percentile);
+	}
+
 	void onExit() override
 	{
 		LOG(INFO) << "Worker " << this->id << " latency: " << this->percentile.nth(50) << " us (50%) " << this->percentile.nth(75) << " us (75%) "
@@ -377,7 +393,7 @@ template <class Workload> class CalvinExecutor : public Worker {
 				}
 			}
 			if (context.straggler_zipf_factor > 0) {
-				int length_type = star::Zipf::globalZipfForStraggler().value(random.next_double());
+				int length_type = star::Zipf::globalZipfForStraggler().value(random);
 				transactions[i]->straggler_wait_time = transaction_lengths[length_type];
 				transaction_lengths_count[length_type]++;
 			}
@@ -548,6 +564,88 @@ template <class Workload> class CalvinExecutor : public Worker {
 		remote_lock_requests_sent.add(dtxn_lock_requests);
 	}
 
+	void publish_cxl_lock_requests()
+	{
+		// the log is built in DRAM and copied into CXL at once, sections are ordered by the target coordinator
+		std::string log(sizeof(uint64_t) * context.coordinator_num, 0);
+		std::vector<std::size_t> remote_requests;
+		for (auto i = 0u; i < transactions.size(); i++) {
+			tid_to_txn_idx[transactions[i]->transaction_id] = i;
+		}
+		for (std::size_t j = 0; j < this->context.coordinator_num; ++j) {
+			for (auto i = 0u; i < transactions.size(); i++) {
+				// do not grant locks to abort no retry transaction
+				if (transactions[i]->abort_no_retry)
+					continue;
+				if (transactions[i]->processed)
+					continue;
+				auto &txn = transactions[i];
+				auto &req = txn->lock_request_for_coordinators[j];
+				if (req.empty())
+					continue;
+				sent_lock_requests++;
+				if (j == coordinator_id) {
+					lock_requests_current_batch.push_back(req);
+					continue;
+				}
+				auto offset = CalvinCXLHelper::append_lock_request(log, req.tid, req.source_coordinator, req.keys.size());
+				for (size_t k = 0; k < req.keys.size(); ++k) {
+					ITable *table = this->db.find_table(req.table_ids[k], req.partition_ids[k]);
+					CalvinCXLHelper::append_lock_key(log, req.table_ids[k], req.partition_ids[k], req.read_writes[k], req.keys[k].get_key(),
+									 table->key_size());
+				}
+				CalvinCXLHelper::finish_lock_request(log, offset);
+				remote_requests.push_back(offset);
+				txn->distributed_transaction = true;
+				dtxn_lock_requests++;
+			}
+			reinterpret_cast<uint64_t *>(&log[0])[j] = log.size();
+		}
+
+		char *cxl_log = calvin_cxl_helper->publish_log(log);
+		published_cxl_lock_requests.clear();
+		for (auto offset : remote_requests) {
+			published_cxl_lock_requests.push_back(reinterpret_cast<CalvinCXLLockRequest *>(cxl_log + offset));
+		}
+		remote_lock_requests_sent.add(dtxn_lock_requests);
+	}
+
+	void read_cxl_lock_requests()
+	{
+		for (std::size_t i = 0; i < this->context.coordinator_num; ++i) {
+			if (i == coordinator_id) {
+				continue;
+			}
+			char *begin, *end;
+			calvin_cxl_helper->get_section(calvin_cxl_helper->get_log(i), coordinator_id, begin, end);
+			while (begin < end) {
+				auto cxl_req = reinterpret_cast<CalvinCXLLockRequest *>(begin);
+				CalvinTransaction::TransactionLockRequest req;
+				req.tid = cxl_req->tid;
+				req.source_coordinator = cxl_req->source_coordinator;
+				req.cxl_vote = &cxl_req->vote;
+				char *cur = begin + sizeof(CalvinCXLLockRequest);
+				for (uint32_t k = 0; k < cxl_req->n_keys; ++k) {
+					auto lock_key = reinterpret_cast<CalvinCXLLockKey *>(cur);
+					CalvinRWKey readKey;
+					readKey.set_table_id(lock_key->table_id);
+					readKey.set_partition_id(lock_key->partition_id);
+					readKey.set_key(cur + sizeof(CalvinCXLLockKey));
+					readKey.set_value(nullptr);
+					if (lock_key->read_or_write == false)
+						readKey.set_read_lock_bit();
+					else
+						readKey.set_write_lock_bit();
+					DCHECK(this->db.find_table(lock_key->table_id, lock_key->partition_id)->key_size() == lock_key->key_size);
+					req.add_key(readKey);
+					cur += sizeof(CalvinCXLLockKey) + lock_key->key_size;
+				}
+				lock_requests_current_batch.push_back(req);
+				begin += cxl_req->size;
+			}
+		}
+	}
+
 	void collect_vote_for_txn(int64_t tid, bool success)
 	{
 		DCHECK(id == 0); // Only lock manager is allowed to call this.
@@ -565,6 +663,8 @@ template <class Workload> class CalvinExecutor : public Worker {
 			auto &req = lock_requests_current_batch[i];
 			if (req.source_coordinator == (int)coordinator_id) {
 				collect_vote_for_txn(req.tid, all_locks_obtained[i]);
+			} else if (req.cxl_vote != nullptr) {
+				req.cxl_vote->store(all_locks_obtained[i] ? CalvinCXLLockRequest::VOTE_YES : CalvinCXLLockRequest::VOTE_NO);
 			} else {
 				auto sz = new_lock_response_message(*messages[req.source_coordinator], req.tid, all_locks_obtained[i]);
 				flush_messages();
@@ -671,6 +771,16 @@ template <class Workload> class CalvinExecutor : public Worker {
 
 	void wait_for_all_lock_requests_processed()
 	{
+		if (context.calvin_cxl) {
+			// the lock managers of other hosts vote in place on the requests this host published
+			for (auto cxl_req : published_cxl_lock_requests) {
+				uint32_t vote;
+				while ((vote = cxl_req->vote.load()) == CalvinCXLLockRequest::VOTE_PENDING) {
+					std::this_thread::yield();
+				}
+				collect_vote_for_txn(cxl_req->tid, vote == CalvinCXLLockRequest::VOTE_YES);
+			}
+		}
 		while (received_lock_responses < sent_lock_requests) {
 			process_request();
 		}
@@ -954,6 +1064,7 @@ template <class Workload> class CalvinExecutor : public Worker {
 	LockfreeQueue<TransactionType *> transaction_queue;
 	std::vector<CalvinExecutor *> all_executors;
 	std::unordered_map<long long, TransactionType *> active_txns;
+	std::vector<CalvinCXLLockRequest *> published_cxl_lock_requests;
 	Percentile<int64_t> percentile, dist_latency, local_latency, commit_latency;
 	Percentile<int64_t> effective_round_concurrency;
 	Percentile<int64_t> round_concurrency;
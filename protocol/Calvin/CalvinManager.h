@@ -7,6 +7,7 @@
 #include "core/Manager.h"
 #include "core/Partitioner.h"
 #include "protocol/Calvin/Calvin.h"
+#include "protocol/Calvin/CalvinCXLHelper.h"
 #include "protocol/Calvin/CalvinExecutor.h"
 #include "protocol/Calvin/CalvinHelper.h"
 #include "protocol/Calvin/CalvinTransaction.h"
@@ -37,6 +38,10 @@ template <class Workload> class CalvinManager : public star::Manager {
 	{
 		storages.resize(context.batch_size);
 		transactions.resize(context.batch_size);
+
+		if (context.calvin_cxl) {
+			calvin_cxl_helper = new CalvinCXLHelper(coordinator_id, context.coordinator_num);
+		}
 	}
 
 	void coordinator_start() override
@@ -4270,7 +4270,7 @@ class HStoreExecutor : public Executor<Workload, HStore<typename Workload::Datab
 				}
 			}
 			if (this->context.straggler_zipf_factor > 0) {
-				int length_type = star::Zipf::globalZipfForStraggler().value(this->random.next_double());
+				int length_type = star::Zipf::globalZipfForStraggler().value(this->random);
 				txn->straggler_wait_time = transaction_lengths[length_type];
 				transaction_lengths_count[length_type]++;
 			}
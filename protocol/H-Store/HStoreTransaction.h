@@ -238,6 +238,28 @@ class HStoreTransaction {
 		return stall_time_us;
 	}
 
+	// re-initialize a pooled transaction object for a new query
+	// read/write sets are cleared but keep their capacity
+	void reinit(std::size_t partition_id)
+	{
+		this->partition_id = partition_id;
+		startTime = std::chrono::steady_clock::now();
+		commit_unlock_time_us = 0;
+		commit_work_time_us = 0;
+		commit_write_back_time_us = 0;
+		remote_work_time_us = 0;
+		local_work_time_us = 0;
+		stall_time_us = 0;
+		commit_prepare_time_us = 0;
+		commit_persistence_time_us = 0;
+		commit_replication_time_us = 0;
+		txn_random_seed_start = 0;
+		transaction_id = 0;
+		straggler_wait_time = 0;
+		tries = 0;
+		reset();
+	}
+
 	void reset()
 	{
 		abort_lock_local_read = false;
@@ -717,6 +739,7 @@ class HStoreTransaction {
 	int abort_lock_queue_len_sum = 0;
 	// int no_in_group = 0;
 	uint64_t straggler_wait_time = 0;
+	int32_t pool_slot = -1; // TransactionPool free list this object returns to, -1 if not pooled
 	bool command_written = false;
 	int granules_left_to_lock = 0;
 	int64_t position_in_log;
@@ -14,6 +14,7 @@
 #include "protocol/Pasha/PolicyClock.h"
 
 #include "protocol/SundialPasha/SundialPashaHelper.h"
+#include "protocol/SiloPasha/SiloPashaHelper.h"
 
 namespace star
 {
@@ -66,6 +67,47 @@ class MigrationManagerFactory {
                         } else {
                                 CHECK(0);
                         }
+                } else if (protocol == "SiloPasha") {
+                        if (migration_policy == "FIFO") {
+                                migration_manager = new PolicyFIFO(
+                                        std::bind(&SiloPashaHelper::move_from_partition_to_shared_region, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        std::bind(&SiloPashaHelper::move_from_shared_region_to_partition, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+                                        std::bind(&SiloPashaHelper::delete_and_update_next_key_info, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        when_to_move_out,
+                                        hw_cc_budget);
+                        } else if (migration_policy == "Eagerly") {
+                                migration_manager = new PolicyEagerly(
+                                        std::bind(&SiloPashaHelper::move_from_partition_to_shared_region, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        std::bind(&SiloPashaHelper::move_from_shared_region_to_partition, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+                                        std::bind(&SiloPashaHelper::delete_and_update_next_key_info, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        when_to_move_out);
+                        } else if (migration_policy == "NoMoveOut") {
+                                migration_manager = new PolicyNoMoveOut(
+                                        std::bind(&SiloPashaHelper::move_from_partition_to_shared_region, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        std::bind(&SiloPashaHelper::move_from_shared_region_to_partition, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+                                        std::bind(&SiloPashaHelper::delete_and_update_next_key_info, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        when_to_move_out);
+                        } else if (migration_policy == "LRU") {
+                                migration_manager = new PolicyLRU(
+                                        std::bind(&SiloPashaHelper::move_from_partition_to_shared_region, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        std::bind(&SiloPashaHelper::move_from_shared_region_to_partition, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+                                        std::bind(&SiloPashaHelper::delete_and_update_next_key_info, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        coordinator_id,
+                                        partition_num,
+                                        when_to_move_out,
+                                        hw_cc_budget);
+                        } else if (migration_policy == "Clock") {
+                                migration_manager = new PolicyClock(
+                                        std::bind(&SiloPashaHelper::move_from_partition_to_shared_region, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        std::bind(&SiloPashaHelper::move_from_shared_region_to_partition, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+                                        std::bind(&SiloPashaHelper::delete_and_update_next_key_info, silo_pasha_global_helper, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5),
+                                        coordinator_id,
+                                        partition_num,
+                                        when_to_move_out,
+                                        hw_cc_budget);
+                        } else {
+                                CHECK(0);
+                        }
                 } else if (protocol == "TwoPLPasha") {
                         if (migration_policy == "FIFO") {
                                 migration_manager = new PolicyFIFO(
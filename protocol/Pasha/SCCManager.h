@@ -45,6 +45,16 @@ class SCCManager {
                           << " cache hit rate: " << 100.0 * num_cache_hit / (num_cache_hit + num_cache_miss) << "%";
         }
 
+        uint64_t get_num_cache_hit() const
+        {
+                return num_cache_hit.load();
+        }
+
+        uint64_t get_num_cache_miss() const
+        {
+                return num_cache_miss.load();
+        }
+
     protected:
         static constexpr uint64_t cacheline_size = 64;
 
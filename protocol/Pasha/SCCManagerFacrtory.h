@@ -33,6 +33,15 @@ class SCCManagerFactory {
                         } else {
                                 CHECK(0);
                         }
+                } else if (protocol == "SiloPasha") {
+                        // reads must not write to the shared region, so WriteThrough is not supported
+                        if (scc_mechanism == "NonTemporal") {
+                                scc_manager = new SCCNonTemporal();
+                        } else if (scc_mechanism == "NoOP") {
+                                scc_manager = new SCCNoOP();
+                        } else {
+                                CHECK(0);
+                        }
                 } else if (protocol == "TwoPLPasha") {
                         if (scc_mechanism == "NonTemporal") {
                                 scc_manager = new TwoPLPashaSCCNonTemporal();
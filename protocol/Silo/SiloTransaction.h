@@ -169,6 +169,27 @@ class SiloTransaction {
 		return get_table(tableId, partitionId);
 	}
 
+	// re-initialize a pooled transaction object for a new query
+	// read/write sets are cleared but keep their capacity
+	void reinit(std::size_t partition_id)
+	{
+		this->partition_id = partition_id;
+		startTime = std::chrono::steady_clock::now();
+		commit_unlock_time_us = 0;
+		commit_work_time_us = 0;
+		commit_write_back_time_us = 0;
+		remote_work_time_us = 0;
+		local_work_time_us = 0;
+		stall_time_us = 0;
+		commit_prepare_time_us = 0;
+		commit_persistence_time_us = 0;
+		commit_replication_time_us = 0;
+		txn_random_seed_start = 0;
+		transaction_id = 0;
+		straggler_wait_time = 0;
+		reset();
+	}
+
 	void reset()
 	{
 		pendingResponses = 0;
@@ -379,6 +400,7 @@ class SiloTransaction {
 	uint64_t txn_random_seed_start = 0;
 	uint64_t transaction_id = 0;
 	uint64_t straggler_wait_time = 0;
+	int32_t pool_slot = -1; // TransactionPool free list this object returns to, -1 if not pooled
 };
 
 } // namespace star
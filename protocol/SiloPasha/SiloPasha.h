@@ -0,0 +1,510 @@
+//
+// Silo over the shared CXL region
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <sstream>
+
+#include "core/Partitioner.h"
+#include "core/Table.h"
+#include "protocol/Silo/SiloHelper.h"
+#include "protocol/SiloPasha/SiloPashaHelper.h"
+#include "protocol/SiloPasha/SiloPashaMessage.h"
+#include "protocol/SiloPasha/SiloPashaTransaction.h"
+#include <glog/logging.h>
+
+namespace star
+{
+
+/*
+ * Reads are optimistic on every host: a migrated row is read from the shared region without touching its metadata.
+ * At commit, the write set is locked with a CAS on the TID (local rows through the local metadata, migrated rows
+ * directly in the shared region) and the read set is validated by re-reading the TIDs, so no messages are needed
+ * after the execution phase.
+ */
+template <class Database> class SiloPasha {
+    public:
+	using DatabaseType = Database;
+	using MetaDataType = std::atomic<uint64_t>;
+	using ContextType = typename DatabaseType::ContextType;
+	using MessageType = SiloPashaMessage;
+	using TransactionType = SiloPashaTransaction;
+
+	using MessageFactoryType = SiloPashaMessageFactory;
+	using MessageHandlerType = SiloPashaMessageHandler;
+
+	SiloPasha(DatabaseType &db, const ContextType &context, Partitioner &partitioner)
+		: db(db)
+		, context(context)
+		, partitioner(partitioner)
+	{
+	}
+
+	void abort(TransactionType &txn, std::vector<std::unique_ptr<Message> > &messages)
+	{
+		auto &writeSet = txn.writeSet;
+		auto &readSet = txn.readSet;
+                auto &insertSet = txn.insertSet;
+                auto &deleteSet = txn.deleteSet;
+
+                // rollback inserts
+                for (auto i = 0u; i < insertSet.size(); i++) {
+			auto &insertKey = insertSet[i];
+
+			if (insertKey.get_processed() == false)
+				continue;
+
+			auto tableId = insertKey.get_table_id();
+			auto partitionId = insertKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+			if (partitioner.has_master_partition(partitionId)) {
+				auto key = insertKey.get_key();
+                                bool success = table->remove(key);
+                                CHECK(success == true);
+			} else {
+                                // does not support remote insert & delete
+                                CHECK(0);
+			}
+		}
+
+                // rollback deletes - just release the locks
+                for (auto i = 0u; i < deleteSet.size(); i++) {
+			auto &deleteKey = deleteSet[i];
+
+			if (deleteKey.get_processed() == false)
+				continue;
+
+			auto tableId = deleteKey.get_table_id();
+			auto partitionId = deleteKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+			if (partitioner.has_master_partition(partitionId)) {
+				auto key = deleteKey.get_key();
+                                auto row = table->search(key);
+                                SiloPashaHelper::unlock(row);
+			} else {
+                                // does not support remote insert & delete
+                                CHECK(0);
+			}
+		}
+
+		// unlock locked records
+		for (auto i = 0u; i < writeSet.size(); i++) {
+			auto &writeKey = writeSet[i];
+			// only unlock locked records
+			if (!writeKey.get_write_lock_bit())
+				continue;
+			auto tableId = writeKey.get_table_id();
+			auto partitionId = writeKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+			if (partitioner.has_master_partition(partitionId)) {
+				auto key = writeKey.get_key();
+				auto row = table->search(key);
+				SiloPashaHelper::unlock(row);
+			} else {
+                                auto &readKey = readSet[writeKey.get_read_set_pos()];
+                                SiloPashaHelper::remote_unlock(readKey.get_migrated_row());
+			}
+		}
+
+                // release migrated rows
+                release_migrated_rows(txn);
+
+                // reactively move out data
+                if (migration_manager->when_to_move_out == MigrationManager::Reactive) {
+                        // send out data move out hints
+                        for (auto remote_host_id : txn.remote_hosts_involved) {
+                                txn.network_size += MessageFactoryType::new_data_move_out_hint_message(*messages[remote_host_id]);
+                        }
+                }
+	}
+
+	bool commit(TransactionType &txn, std::vector<std::unique_ptr<Message> > &messages)
+	{
+		{
+			ScopedTimer t([&, this](uint64_t us) { txn.record_commit_prepare_time(us); });
+			// lock write set
+			if (txn.abort_lock || lock_write_set(txn)) {
+				abort(txn, messages);
+				return false;
+			}
+
+			// read validation
+			if (!validate_read_set(txn)) {
+				abort(txn, messages);
+				return false;
+			}
+
+			// redo logging
+			if (txn.get_logger()) {
+				write_redo_logs(txn);
+			}
+		}
+
+		// generate tid
+		uint64_t commit_tid;
+		{
+			ScopedTimer t([&, this](uint64_t us) { txn.record_local_work_time(us); });
+			commit_tid = generate_tid(txn);
+		}
+
+		{
+                        // don't write commit log record for read-only transactions
+                        if (txn.writeSet.size() != 0 || txn.insertSet.size() != 0 || txn.deleteSet.size() != 0) {
+                                ScopedTimer t([&, this](uint64_t us) { txn.record_commit_persistence_time(us); });
+                                // Passed validation, persist commit record
+                                if (txn.get_logger()) {
+                                        std::ostringstream ss;
+                                        ss << commit_tid << true;
+                                        auto output = ss.str();
+                                        auto lsn = txn.get_logger()->write(output.c_str(), output.size(), true, txn.startTime);
+                                }
+                        }
+		}
+
+                // commit inserts
+                auto &insertSet = txn.insertSet;
+                for (auto i = 0u; i < insertSet.size(); i++) {
+			auto &insertKey = insertSet[i];
+			CHECK(insertKey.get_processed() == true);
+
+			auto tableId = insertKey.get_table_id();
+			auto partitionId = insertKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+			if (partitioner.has_master_partition(partitionId)) {
+				auto key = insertKey.get_key();
+                                auto row = table->search(key);
+                                SiloPashaHelper::mark_tuple_as_valid(row);
+			} else {
+                                // does not support remote insert & delete
+                                CHECK(0);
+			}
+		}
+
+                // commit deletes
+                auto &deleteSet = txn.deleteSet;
+                for (auto i = 0u; i < deleteSet.size(); i++) {
+			auto &deleteKey = deleteSet[i];
+			CHECK(deleteKey.get_processed() == true);
+
+			auto tableId = deleteKey.get_table_id();
+			auto partitionId = deleteKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+			if (partitioner.has_master_partition(partitionId)) {
+				auto key = deleteKey.get_key();
+                                bool success = table->remove(key);
+                                CHECK(success == true);
+			} else {
+                                // does not support remote insert & delete
+                                CHECK(0);
+			}
+		}
+
+		// write
+		{
+			ScopedTimer t([&, this](uint64_t us) { txn.record_commit_write_back_time(us); });
+			write(txn);
+		}
+
+		// release locks
+		{
+			ScopedTimer t([&, this](uint64_t us) { txn.record_commit_unlock_time(us); });
+			release_lock(txn, commit_tid);
+		}
+
+                // release migrated rows
+                release_migrated_rows(txn);
+
+                // reactively move out data
+                if (migration_manager->when_to_move_out == MigrationManager::Reactive) {
+                        // send out data move out hints
+                        for (auto remote_host_id : txn.remote_hosts_involved) {
+                                txn.network_size += MessageFactoryType::new_data_move_out_hint_message(*messages[remote_host_id]);
+                        }
+                }
+
+		return true;
+	}
+
+    private:
+	bool lock_write_set(TransactionType &txn)
+	{
+		auto &readSet = txn.readSet;
+		auto &writeSet = txn.writeSet;
+
+		for (auto i = 0u; i < writeSet.size(); i++) {
+			auto &writeKey = writeSet[i];
+			auto tableId = writeKey.get_table_id();
+			auto partitionId = writeKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+
+			// assume no blind write
+			DCHECK(writeKey.get_read_set_pos() != -1);
+			auto &readKey = readSet[writeKey.get_read_set_pos()];
+
+			bool success = false;
+			uint64_t latestTid = 0;
+			if (partitioner.has_master_partition(partitionId)) {
+                                // I am the owner of the data
+				auto key = writeKey.get_key();
+				auto row = table->search(key);
+				latestTid = SiloPashaHelper::lock(row, success);
+			} else {
+                                // I am not the owner of the data, lock the row I have read
+                                char *migrated_row = readKey.get_migrated_row();
+                                CHECK(migrated_row != nullptr);
+				latestTid = SiloPashaHelper::remote_lock(migrated_row, success);
+			}
+
+			if (!success) {
+				txn.abort_lock = true;
+				break;
+			}
+
+			writeKey.set_write_lock_bit();
+			writeKey.set_tid(latestTid);
+
+			if (latestTid != readKey.get_tid()) {
+				txn.abort_lock = true;
+				break;
+			}
+		}
+
+		return txn.abort_lock;
+	}
+
+	bool validate_read_set(TransactionType &txn)
+	{
+		auto &readSet = txn.readSet;
+		auto &writeSet = txn.writeSet;
+
+		auto isKeyInWriteSet = [](const std::vector<SiloPashaRWKey> &writeSet, const void *key) {
+			for (auto &writeKey : writeSet) {
+				if (writeKey.get_key() == key) {
+					return true;
+				}
+			}
+			return false;
+		};
+
+		for (auto i = 0u; i < readSet.size(); i++) {
+			auto &readKey = readSet[i];
+
+			if (readKey.get_local_index_read_bit()) {
+				continue; // read only index does not need to validate
+			}
+
+			bool in_write_set = isKeyInWriteSet(writeSet, readKey.get_key());
+			if (in_write_set) {
+				continue; // already validated in lock write set
+			}
+
+			auto tableId = readKey.get_table_id();
+			auto partitionId = readKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+			auto key = readKey.get_key();
+			auto tid = readKey.get_tid();
+
+			uint64_t latest_tid = 0;
+			if (partitioner.has_master_partition(partitionId)) {
+				auto row = table->search(key);
+				latest_tid = SiloPashaHelper::read_tid(row);
+			} else {
+                                // a row moved out since it was read keeps its lock bit, so validation fails
+				latest_tid = SiloPashaHelper::remote_read_tid(readKey.get_migrated_row());
+			}
+
+			if (SiloHelper::remove_lock_bit(latest_tid) != tid) {
+				txn.abort_read_validation = true;
+				break;
+			}
+
+			if (SiloHelper::is_locked(latest_tid)) { // must be locked by others
+				txn.abort_read_validation = true;
+				break;
+			}
+		}
+
+		return !txn.abort_read_validation;
+	}
+
+	void write_redo_logs(TransactionType &txn)
+	{
+		DCHECK(txn.get_logger());
+
+		// Redo logging for writes
+		auto &writeSet = txn.writeSet;
+		for (size_t i = 0; i < writeSet.size(); ++i) {
+			auto &writeKey = writeSet[i];
+			auto tableId = writeKey.get_table_id();
+			auto partitionId = writeKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+			auto key_size = table->key_size();
+			auto value_size = table->value_size();
+			auto key = writeKey.get_key();
+			auto value = writeKey.get_value();
+
+			std::ostringstream ss;
+                        int log_type = 0;       // 0 stands for write
+			ss << log_type << tableId << partitionId << std::string((char *)key, key_size) << std::string((char *)value, value_size);
+			auto output = ss.str();
+			txn.get_logger()->write(output.c_str(), output.size(), false, txn.startTime);
+		}
+
+                // Redo logging for inserts
+                auto &insertSet = txn.insertSet;
+                for (size_t i = 0; i < insertSet.size(); ++i) {
+                        auto &insertKey = insertSet[i];
+                        auto tableId = insertKey.get_table_id();
+                        auto partitionId = insertKey.get_partition_id();
+                        auto table = db.find_table(tableId, partitionId);
+                        auto key_size = table->key_size();
+                        auto value_size = table->value_size();
+                        auto key = insertKey.get_key();
+                        auto value = insertKey.get_value();
+                        DCHECK(key);
+                        DCHECK(value);
+                        std::ostringstream ss;
+
+                        int log_type = 1;       // 1 stands for insert
+                        ss << log_type << tableId << partitionId << std::string((char *)key, key_size) << std::string((char *)value, value_size);
+                        auto output = ss.str();
+                        txn.get_logger()->write(output.c_str(), output.size(), false, txn.startTime);
+                }
+
+                // Redo logging for deletes
+                auto &deleteSet = txn.deleteSet;
+                for (size_t i = 0; i < deleteSet.size(); ++i) {
+                        auto &deleteKey = deleteSet[i];
+                        auto tableId = deleteKey.get_table_id();
+                        auto partitionId = deleteKey.get_partition_id();
+                        auto table = db.find_table(tableId, partitionId);
+                        auto key_size = table->key_size();
+                        auto key = deleteKey.get_key();
+                        DCHECK(key);
+                        std::ostringstream ss;
+
+                        int log_type = 2;       // 2 stands for delete
+                        ss << log_type << tableId << partitionId << std::string((char *)key, key_size);     // do not need to log value for deletes
+                        auto output = ss.str();
+                        txn.get_logger()->write(output.c_str(), output.size(), false, txn.startTime);
+                }
+	}
+
+	uint64_t generate_tid(TransactionType &txn)
+	{
+		auto &readSet = txn.readSet;
+		auto &writeSet = txn.writeSet;
+
+		uint64_t next_tid = 0;
+
+		/*
+		 *  A timestamp is a 64-bit word.
+		 *  The most significant bit is the lock bit.
+		 *  The lower 63 bits are for transaction sequence id.
+		 *  [  lock bit (1)  |  id (63) ]
+		 */
+
+		// larger than the TID of any record read or written by the transaction
+
+		for (std::size_t i = 0; i < readSet.size(); i++) {
+			next_tid = std::max(next_tid, readSet[i].get_tid());
+		}
+
+		for (std::size_t i = 0; i < writeSet.size(); i++) {
+			next_tid = std::max(next_tid, writeSet[i].get_tid());
+		}
+
+		// larger than the worker's most recent chosen TID
+
+		next_tid = std::max(next_tid, max_tid);
+
+		// increment
+
+		next_tid++;
+
+		// update worker's most recent chosen TID
+
+		max_tid = next_tid;
+
+		return next_tid;
+	}
+
+	void write(TransactionType &txn)
+	{
+		auto &readSet = txn.readSet;
+		auto &writeSet = txn.writeSet;
+
+		for (auto i = 0u; i < writeSet.size(); i++) {
+			auto &writeKey = writeSet[i];
+			auto tableId = writeKey.get_table_id();
+			auto partitionId = writeKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+			auto value = writeKey.get_value();
+			auto value_size = table->value_size();
+			DCHECK(writeKey.get_write_lock_bit());
+
+			if (partitioner.has_master_partition(partitionId)) {
+                                // I am the owner of the data
+				auto key = writeKey.get_key();
+				auto row = table->search(key);
+				silo_pasha_global_helper->update(row, value, value_size);
+			} else {
+                                // I am not the owner of the data, the locked row cannot be moved out
+                                auto &readKey = readSet[writeKey.get_read_set_pos()];
+                                silo_pasha_global_helper->remote_update(readKey.get_migrated_row(), value, value_size);
+			}
+		}
+	}
+
+	void release_lock(TransactionType &txn, uint64_t commit_tid)
+	{
+		auto &readSet = txn.readSet;
+		auto &writeSet = txn.writeSet;
+
+		for (auto i = 0u; i < writeSet.size(); i++) {
+			auto &writeKey = writeSet[i];
+			auto tableId = writeKey.get_table_id();
+			auto partitionId = writeKey.get_partition_id();
+			auto table = db.find_table(tableId, partitionId);
+			DCHECK(writeKey.get_write_lock_bit());
+
+			if (partitioner.has_master_partition(partitionId)) {
+                                // I am the owner of the data
+				auto key = writeKey.get_key();
+				auto row = table->search(key);
+				SiloPashaHelper::unlock(row, commit_tid);
+			} else {
+                                // I am not the owner of the data
+                                auto &readKey = readSet[writeKey.get_read_set_pos()];
+                                SiloPashaHelper::remote_unlock(readKey.get_migrated_row(), commit_tid);
+			}
+		}
+	}
+
+        void release_migrated_rows(TransactionType &txn)
+        {
+                auto &readSet = txn.readSet;
+
+                // only the rows moved in on behalf of this transaction are pinned
+		for (auto i = 0u; i < readSet.size(); ++i) {
+			auto &readKey = readSet[i];
+
+			if (readKey.get_reference_counted() == true) {
+                                DCHECK(partitioner.has_master_partition(readKey.get_partition_id()) == false);
+                                SiloPashaHelper::release_migrated_row(readKey.get_migrated_row());
+                        }
+		}
+        }
+
+    private:
+	DatabaseType &db;
+	const ContextType &context;
+	Partitioner &partitioner;
+	uint64_t max_tid = 0;
+};
+
+} // namespace star
@@ -0,0 +1,261 @@
+//
+// Executor of SiloPasha
+//
+
+#pragma once
+
+#include "common/CCSet.h"
+#include "common/CCHashTable.h"
+#include "core/Executor.h"
+#include "protocol/SiloPasha/SiloPasha.h"
+#include "protocol/SiloPasha/SiloPashaHelper.h"
+#include "protocol/Pasha/MigrationManager.h"
+#include "protocol/Pasha/MigrationManagerFactory.h"
+#include "protocol/Pasha/SCCManager.h"
+#include "protocol/Pasha/SCCManagerFacrtory.h"
+
+namespace star
+{
+template <class Workload>
+class SiloPashaExecutor : public Executor<Workload, SiloPasha<typename Workload::DatabaseType> >
+
+{
+    public:
+	using base_type = Executor<Workload, SiloPasha<typename Workload::DatabaseType> >;
+
+	using WorkloadType = Workload;
+	using ProtocolType = SiloPasha<typename Workload::DatabaseType>;
+	using DatabaseType = typename WorkloadType::DatabaseType;
+	using TransactionType = typename WorkloadType::TransactionType;
+	using ContextType = typename DatabaseType::ContextType;
+	using RandomType = typename DatabaseType::RandomType;
+	using MessageType = typename ProtocolType::MessageType;
+	using MessageFactoryType = typename ProtocolType::MessageFactoryType;
+	using MessageHandlerType = typename ProtocolType::MessageHandlerType;
+
+	using StorageType = typename WorkloadType::StorageType;
+
+	SiloPashaExecutor(std::size_t coordinator_id, std::size_t id, DatabaseType &db, const ContextType &context, std::atomic<uint32_t> &worker_status,
+			std::atomic<uint32_t> &n_complete_workers, std::atomic<uint32_t> &n_started_workers)
+		: base_type(coordinator_id, id, db, context, worker_status, n_complete_workers, n_started_workers)
+	{
+                if (id == 0) {
+                        // create or retrieve the CXL tables
+                        std::vector<std::vector<CXLTableBase *> > &cxl_tbl_vecs = db.create_or_retrieve_cxl_tables(context);
+
+                        // init helper
+                        silo_pasha_global_helper = new SiloPashaHelper(coordinator_id, cxl_tbl_vecs);
+                        CHECK(silo_pasha_global_helper != nullptr);
+
+                        // init migration manager
+                        uint64_t hw_cc_budget_per_host = (context.hw_cc_budget - CXL_EBR::max_ebr_retiring_memory) / context.coordinator_num;
+                        LOG(INFO) << "total hardware budget = " << context.hw_cc_budget << " per host = " << hw_cc_budget_per_host;
+                        migration_manager = MigrationManagerFactory::create_migration_manager(context.protocol, context.migration_policy, context.coordinator_id,
+                                context.partition_num, context.when_to_move_out, hw_cc_budget_per_host);
+
+                        // init software cache-coherence manager
+                        scc_manager = SCCManagerFactory::create_scc_manager(context.protocol, context.scc_mechanism);
+
+                        // handle pre-migration
+                        if (context.pre_migrate == "None") {
+                                // do nothing
+                        } else if (context.pre_migrate == "All") {
+                                db.move_all_tables_into_cxl(std::bind(&MigrationManager::move_row_in, migration_manager, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
+                        } else if (context.pre_migrate == "NonPart") {
+                                db.move_non_part_tables_into_cxl(std::bind(&MigrationManager::move_row_in, migration_manager, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
+                        } else {
+                                CHECK(0);
+                        }
+
+                        // commit metadata init
+                        silo_pasha_global_helper->commit_pasha_metadata_init();
+                } else {
+                        silo_pasha_global_helper->wait_for_pasha_metadata_init();
+                }
+	}
+
+	~SiloPashaExecutor() = default;
+
+	void setupHandlers(TransactionType &txn)
+
+		override
+	{
+		txn.readRequestHandler = [this, &txn](std::size_t table_id, std::size_t partition_id, uint32_t key_offset, const void *key, void *value,
+						      bool local_index_read, bool write_lock) -> bool  {
+			ITable *table = this->db.find_table(table_id, partition_id);
+                        auto value_size = table->value_size();
+                        bool local_read = false;
+                        bool ret = true;
+
+			if (this->partitioner->has_master_partition(partition_id) ||
+			    (this->partitioner->is_partition_replicated_on(partition_id, this->coordinator_id) && this->context.read_on_replica)) {
+				local_read = true;
+			}
+
+			if (local_index_read && !local_read && table->get_shared_index() != nullptr) {
+                                // the index of another host's partition is read in place from the shared region
+                                void *src = table->get_shared_index()->search(key);
+                                CHECK(src != nullptr);
+                                std::memcpy(value, src, value_size);
+				txn.readSet[key_offset].set_tid(0);
+			} else if (local_index_read || local_read) {
+                                // statistics
+                                this->n_local_access.fetch_add(1);
+
+                                // I am the owner of the data
+				auto row = table->search(key);
+                                CHECK(std::get<0>(row) != nullptr && std::get<1>(row) != nullptr);
+
+                                // writes are locked at commit time
+				auto tid = silo_pasha_global_helper->read(row, value, value_size, this->n_local_cxl_access);
+				txn.readSet[key_offset].set_tid(tid);
+			} else {
+                                // statistics
+                                this->n_remote_access.fetch_add(1);
+
+                                // I am not the owner of the data
+                                char *migrated_row = silo_pasha_global_helper->get_migrated_row(table_id, partition_id, key, true);
+                                if (migrated_row != nullptr) {
+                                        // data is in the shared region, read it without pinning it
+                                        // a concurrent move out makes the transaction fail validation
+                                        auto tid = silo_pasha_global_helper->remote_read(migrated_row, value, value_size);
+                                        txn.readSet[key_offset].set_tid(tid);
+                                        txn.readSet[key_offset].set_migrated_row(migrated_row);
+                                } else {
+                                        // statistics
+                                        this->n_remote_access_with_req.fetch_add(1);
+
+                                        // data is not in the shared region
+                                        // ask the remote host to do the data migration
+                                        auto coordinatorID = this->partitioner->master_coordinator(partition_id);
+                                        txn.network_size += MessageFactoryType::new_data_migration_message(*(this->messages[coordinatorID]), *table, key, txn.transaction_id, key_offset);
+                                        txn.pendingResponses++;
+                                }
+                                // multi-host transaction
+                                txn.distributed_transaction = true;
+
+                                if (migration_manager->when_to_move_out == MigrationManager::Reactive) {
+                                        // update remote hosts involved
+                                        auto coordinatorID = this->partitioner->master_coordinator(partition_id);
+                                        txn.remote_hosts_involved.insert(coordinatorID);
+                                }
+			}
+
+                        return ret;
+		};
+
+                txn.scanRequestHandler = [this, &txn](std::size_t table_id, std::size_t partition_id, uint32_t key_offset, const void *min_key, const void *max_key,
+                                                uint64_t limit, void *results) -> bool {
+			ITable *table = this->db.find_table(table_id, partition_id);
+                        std::vector<ITable::row_entity> &scan_results = *reinterpret_cast<std::vector<ITable::row_entity> *>(results);
+                        auto value_size = table->value_size();
+                        bool local_scan = false;
+
+			if (this->partitioner->has_master_partition(partition_id) ||
+			    (this->partitioner->is_partition_replicated_on(partition_id, this->coordinator_id) && this->context.read_on_replica)) {
+				local_scan = true;
+			}
+
+			if (local_scan) {
+                                auto local_scan_processor = [&](const void *key, std::atomic<uint64_t> *meta_ptr, void *data_ptr, bool is_last_tuple) -> bool {
+                                        CHECK(key != nullptr);
+                                        CHECK(meta_ptr != nullptr);
+                                        CHECK(data_ptr != nullptr);
+
+                                        if (limit != 0 && scan_results.size() == limit) {
+                                                return true;
+                                        }
+
+                                        if (table->compare_key(key, max_key) > 0) {
+                                                return true;
+                                        }
+
+                                        if (table->compare_key(key, min_key) >= 0) {
+                                                if (scan_results.size() > 0) {
+                                                        if (table->compare_key(key, scan_results[scan_results.size() - 1].key) <= 0) {
+                                                                return false;
+                                                        }
+                                                }
+                                        } else {
+                                                return false;
+                                        }
+
+                                        ITable::row_entity cur_row(key, table->key_size(), meta_ptr, data_ptr, table->value_size());
+                                        scan_results.push_back(cur_row);
+
+                                        // continue scan
+                                        return false;
+                                };
+
+				table->scan(min_key, local_scan_processor);
+			} else {
+                                CHECK(0);      // right now we only support local scan
+			}
+
+                        return true;
+		};
+
+                txn.insertRequestHandler = [this, &txn](std::size_t table_id, std::size_t partition_id, uint32_t key_offset, const void *key, void *value) -> bool {
+			ITable *table = this->db.find_table(table_id, partition_id);
+                        auto value_size = table->value_size();
+                        bool local_insert = false;
+                        bool ret = true;
+
+			if (this->partitioner->has_master_partition(partition_id) ||
+			    (this->partitioner->is_partition_replicated_on(partition_id, this->coordinator_id) && this->context.read_on_replica)) {
+				local_insert = true;
+			}
+
+			if (local_insert) {
+				bool success = table->insert(key, value, true);
+                                if (success == false) {
+                                        txn.abort_insert = true;
+                                        ret = false;
+                                }
+			} else {
+                                CHECK(0);      // right now we only support local insert
+			}
+
+                        return ret;
+		};
+
+                txn.deleteRequestHandler = [this, &txn](std::size_t table_id, std::size_t partition_id, uint32_t key_offset, const void *key) -> bool {
+			ITable *table = this->db.find_table(table_id, partition_id);
+                        auto value_size = table->value_size();
+                        bool local_delete = false;
+
+			if (this->partitioner->has_master_partition(partition_id) ||
+			    (this->partitioner->is_partition_replicated_on(partition_id, this->coordinator_id) && this->context.read_on_replica)) {
+				local_delete = true;
+			}
+
+			if (local_delete) {
+				auto row = table->search(key);
+                                if (std::get<0>(row) == nullptr && std::get<1>(row) == nullptr) {
+                                        // someone else has deleted the row, so we abort
+                                        txn.abort_delete = true;
+                                        return false;
+                                }
+
+                                bool success = false;
+                                SiloPashaHelper::lock(row, success);
+                                if (success) {
+                                        // do nothing
+                                } else {
+                                        txn.abort_delete = true;
+                                        return false;
+                                }
+			} else {
+                                CHECK(0);      // right now we only support local delete
+			}
+
+                        return true;
+		};
+
+		txn.remote_request_handler = [this](std::size_t) { return this->process_request(); };
+		txn.message_flusher = [this]() { this->flush_messages(); };
+		txn.get_table = [this](std::size_t tableId, std::size_t partitionId) { return this->db.find_table(tableId, partitionId); };
+		txn.set_logger(this->logger);
+	};
+};
+} // namespace star
@@ -0,0 +1,14 @@
+#include "protocol/SiloPasha/SiloPashaHelper.h"
+
+namespace star {
+
+uint64_t SiloPashaMetadataLocalInit(bool is_tuple_valid = true)
+{
+	auto lmeta = new SiloPashaMetadataLocal();
+        lmeta->is_valid = is_tuple_valid;
+        return reinterpret_cast<uint64_t>(lmeta);
+}
+
+SiloPashaHelper *silo_pasha_global_helper = nullptr;
+
+}
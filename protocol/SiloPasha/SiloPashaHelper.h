@@ -0,0 +1,672 @@
+//
+// Silo over the shared CXL region
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <tuple>
+#include <memory>
+
+#include "common/CXL_EBR.h"
+#include "core/CXLTable.h"
+#include "core/Table.h"
+#include "glog/logging.h"
+
+#include "protocol/Silo/SiloHelper.h"
+#include "protocol/Pasha/MigrationManager.h"
+#include "protocol/Pasha/SCCManager.h"
+
+namespace star
+{
+
+/*
+ * A TID is a 64-bit word, [ lock bit (1) | id (63) ], as in Silo.
+ * The TID travels with the row: it is copied into the shared metadata when the row is moved in
+ * and copied back when the row is moved out.
+ */
+struct SiloPashaMetadataLocal {
+        SiloPashaMetadataLocal()
+                : tid(0)
+                , is_migrated(false)
+                , migrated_row(nullptr)
+                , is_valid(false)
+        {
+                // this spinlock will only be shared within a single process
+                pthread_spin_init(&latch, PTHREAD_PROCESS_PRIVATE);
+        }
+
+	void lock()
+	{
+                pthread_spin_lock(&latch);
+	}
+
+	void unlock()
+	{
+		pthread_spin_unlock(&latch);
+	}
+
+        // protects the location of the row (is_migrated and migrated_row) against data movement
+        pthread_spinlock_t latch;
+
+        std::atomic<uint64_t> tid{ 0 };
+
+        bool is_migrated{ false };
+        char *migrated_row{ nullptr };
+
+        bool is_valid{ false };
+};
+
+/*
+ * There is no latch in the shared metadata, every access to a migrated row goes through the TID.
+ * Readers never write to the shared region; writers set the lock bit with a CAS at commit.
+ * A row that is moved out keeps its lock bit forever, so concurrent readers fail validation.
+ */
+struct SiloPashaMetadataShared {
+	SiloPashaMetadataShared()
+                : tid(0)
+                , ref_cnt(0)
+                , is_valid(false)
+                , scc_meta(0)
+                , is_next_key_real(false)
+        {
+        }
+
+        std::atomic<uint64_t> tid{ 0 };
+
+        // a row moved in on behalf of a remote transaction is pinned until that transaction finishes
+        // a migrated row can only be moved out if its ref_cnt == 0
+        std::atomic<uint64_t> ref_cnt{ 0 };
+
+        // a migrated tuple can be invalid if it is deleted or migrated out
+        std::atomic<bool> is_valid{ false };
+
+        // migration policy metadata
+        char migration_policy_meta[MigrationManager::migration_policy_meta_size];         // directly embed it here to avoid extra cxlalloc_malloc
+
+        // software cache-coherence metadata
+        uint64_t scc_meta{ 0 };         // directly embed it here to avoid extra cxlalloc_malloc
+
+        // next-key information
+        bool is_next_key_real{ false };
+};
+
+uint64_t SiloPashaMetadataLocalInit(bool is_tuple_valid);
+
+/*
+ * lmeta means local metadata stored in local DRAM
+ * smeta means shared metadata stored in the shared region
+ */
+class SiloPashaHelper {
+    public:
+        using MetaDataType = std::atomic<uint64_t>;
+
+        SiloPashaHelper(std::size_t coordinator_id, std::vector<std::vector<CXLTableBase *> > &cxl_tbl_vecs)
+                : coordinator_id(coordinator_id)
+                , cxl_tbl_vecs(cxl_tbl_vecs)
+        {
+        }
+
+	// Returns the tid of the tuple.
+	uint64_t read(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, std::atomic<uint64_t> &local_cxl_access)
+	{
+		MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+                uint64_t tid = 0;
+
+		lmeta->lock();
+                if (lmeta->is_migrated == false) {
+                        void *src = std::get<1>(row);
+                        tid = SiloHelper::remove_lock_bit(lmeta->tid.load());
+                        std::memcpy(dest, src, size);
+                } else {
+                        // statistics
+                        local_cxl_access.fetch_add(1);
+
+                        tid = remote_read(lmeta->migrated_row, dest, size);
+                }
+		lmeta->unlock();
+
+		return tid;
+	}
+
+        // Returns the tid of the tuple.
+        // Reads from a consistent view without writing to the shared region.
+        // The value is read even if it is locked by others, the transaction aborts in read validation.
+	uint64_t remote_read(char *row, void *dest, std::size_t size)
+	{
+		SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(row);
+                void *src = row + sizeof(SiloPashaMetadataShared);
+                uint64_t tid = 0;
+
+                do {
+                        tid = smeta->tid.load(std::memory_order_acquire);
+                        scc_manager->do_read(&smeta->scc_meta, coordinator_id, dest, src, size);
+                } while (tid != smeta->tid.load(std::memory_order_acquire));
+
+		return SiloHelper::remove_lock_bit(tid);
+	}
+
+        // Returns the current tid of the tuple, including the lock bit.
+        static uint64_t read_tid(const std::tuple<MetaDataType *, void *> &row)
+	{
+		MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+                uint64_t tid = 0;
+
+		lmeta->lock();
+                if (lmeta->is_migrated == false) {
+                        tid = lmeta->tid.load();
+                } else {
+                        tid = remote_read_tid(lmeta->migrated_row);
+                }
+		lmeta->unlock();
+
+		return tid;
+	}
+
+        static uint64_t remote_read_tid(char *row)
+	{
+		SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(row);
+                return smeta->tid.load(std::memory_order_acquire);
+	}
+
+	// Returns the tid of the tuple before it is locked.
+	static uint64_t lock(const std::tuple<MetaDataType *, void *> &row, bool &success)
+	{
+		MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+                uint64_t tid = 0;
+
+                success = false;
+		lmeta->lock();
+                if (lmeta->is_valid == true) {
+                        if (lmeta->is_migrated == false) {
+                                tid = SiloHelper::lock(lmeta->tid, success);
+                        } else {
+                                tid = remote_lock(lmeta->migrated_row, success);
+                        }
+                }
+		lmeta->unlock();
+
+		return tid;
+	}
+
+        // Returns the tid of the tuple before it is locked.
+        // Fails on a moved-out row because its lock bit is never cleared.
+	static uint64_t remote_lock(char *row, bool &success)
+	{
+		SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(row);
+                uint64_t tid = SiloHelper::lock(smeta->tid, success);
+                DCHECK(success == false || smeta->is_valid.load() == true);
+		return tid;
+	}
+
+	void update(const std::tuple<MetaDataType *, void *> &row, const void *value, std::size_t value_size)
+	{
+		MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+
+		lmeta->lock();
+                CHECK(lmeta->is_valid == true);
+                if (lmeta->is_migrated == false) {
+                        void *data_ptr = std::get<1>(row);
+                        DCHECK(SiloHelper::is_locked(lmeta->tid.load()));
+                        std::memcpy(data_ptr, value, value_size);
+                } else {
+                        remote_update(lmeta->migrated_row, value, value_size);
+                }
+		lmeta->unlock();
+	}
+
+        void remote_update(char *row, const void *value, std::size_t value_size)
+	{
+		SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(row);
+                void *data_ptr = row + sizeof(SiloPashaMetadataShared);
+
+                DCHECK(smeta->is_valid.load() == true);
+                DCHECK(SiloHelper::is_locked(smeta->tid.load()));
+                scc_manager->do_write(&smeta->scc_meta, coordinator_id, data_ptr, value, value_size);
+	}
+
+        // releases the lock without changing the tid (abort)
+	static void unlock(const std::tuple<MetaDataType *, void *> &row)
+	{
+		MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+
+		lmeta->lock();
+                if (lmeta->is_migrated == false) {
+                        SiloHelper::unlock(lmeta->tid);
+                } else {
+                        remote_unlock(lmeta->migrated_row);
+                }
+		lmeta->unlock();
+	}
+
+        static void remote_unlock(char *row)
+	{
+		SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(row);
+                SiloHelper::unlock(smeta->tid);
+	}
+
+        // releases the lock and installs the tid of the committing transaction
+	static void unlock(const std::tuple<MetaDataType *, void *> &row, uint64_t commit_tid)
+	{
+		MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+
+		lmeta->lock();
+                if (lmeta->is_migrated == false) {
+                        SiloHelper::unlock(lmeta->tid, commit_tid);
+                } else {
+                        remote_unlock(lmeta->migrated_row, commit_tid);
+                }
+		lmeta->unlock();
+	}
+
+        static void remote_unlock(char *row, uint64_t commit_tid)
+	{
+		SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(row);
+                SiloHelper::unlock(smeta->tid, commit_tid);
+	}
+
+        static void mark_tuple_as_valid(const std::tuple<MetaDataType *, void *> &row)
+        {
+                MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+
+                lmeta->lock();
+                CHECK(lmeta->is_valid == false);
+                if (lmeta->is_migrated == false) {
+                        lmeta->is_valid = true;
+                } else {
+                        CHECK(0);
+                }
+                lmeta->unlock();
+        }
+
+        void commit_pasha_metadata_init()
+        {
+                init_finished.store(1, std::memory_order_release);
+        }
+
+        void wait_for_pasha_metadata_init()
+        {
+                while (init_finished.load(std::memory_order_acquire) == 0);
+        }
+
+        // does not pin the row; if it is moved out before commit, the transaction fails validation
+        // the row itself stays readable until the end of the transaction thanks to EBR
+        char *get_migrated_row(std::size_t table_id, std::size_t partition_id, const void *key, bool update_migration_policy)
+        {
+                CXLTableBase *target_cxl_table = cxl_tbl_vecs[table_id][partition_id];
+                char *migrated_row = reinterpret_cast<char *>(target_cxl_table->search(key));
+
+                if (migrated_row != nullptr) {
+                        SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(migrated_row);
+                        if (smeta->is_valid.load(std::memory_order_acquire) == false) {
+                                return nullptr;
+                        }
+                        if (update_migration_policy == true) {
+                                migration_manager->access_row(&smeta->migration_policy_meta, partition_id);
+                        }
+                }
+
+                return migrated_row;
+        }
+
+        // unpins a row moved in on behalf of this host
+        static void release_migrated_row(char *row)
+        {
+                SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(row);
+                uint64_t prev_ref_cnt = smeta->ref_cnt.fetch_sub(1);
+                CHECK(prev_ref_cnt > 0);
+        }
+
+        char *create_shared_row(ITable *table, const void *key, const std::tuple<MetaDataType *, void *> &row, SiloPashaMetadataLocal *lmeta, bool inc_ref_cnt, void *&migration_policy_meta)
+        {
+                void *local_data = std::get<1>(row);
+
+                // allocate the CXL row
+                std::size_t row_total_size = sizeof(SiloPashaMetadataShared) + table->value_size();
+                char *migrated_row_ptr = reinterpret_cast<char *>(cxl_memory.cxlalloc_malloc_wrapper(row_total_size,
+                        CXLMemory::DATA_ALLOCATION, sizeof(SiloPashaMetadataShared), table->value_size()));
+                char *migrated_row_value_ptr = migrated_row_ptr + sizeof(SiloPashaMetadataShared);
+                SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(migrated_row_ptr);
+                new(smeta) SiloPashaMetadataShared();
+
+                // init migration policy metadata
+                migration_manager->init_migration_policy_metadata(&smeta->migration_policy_meta, table, key, row, sizeof(SiloPashaMetadataShared));
+                migration_policy_meta = smeta->migration_policy_meta;
+
+                // init software cache-coherence metadata
+                scc_manager->init_scc_metadata(&smeta->scc_meta, coordinator_id);
+
+                // copy metadata, a local transaction holding the lock keeps holding it in the shared region
+                smeta->tid.store(lmeta->tid.load());
+
+                // copy data
+                scc_manager->do_write(&smeta->scc_meta, coordinator_id, migrated_row_value_ptr, local_data, table->value_size());
+
+                // increase the reference count for the requesting host
+                if (inc_ref_cnt == true) {
+                        smeta->ref_cnt.store(1);
+                }
+
+                return migrated_row_ptr;
+        }
+
+        // Returns false if the row is locked or pinned.
+        // On success the lock bit of the shared row stays set and the row is handed over to EBR.
+        bool retire_shared_row(ITable *table, const std::tuple<MetaDataType *, void *> &row, SiloPashaMetadataLocal *lmeta)
+        {
+                SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(lmeta->migrated_row);
+                char *migrated_row_value = lmeta->migrated_row + sizeof(SiloPashaMetadataShared);
+                void *local_data = std::get<1>(row);
+
+                // the tuple must be valid
+                CHECK(smeta->is_valid.load() == true);
+
+                // a transaction is committing the tuple, cannot move out the tuple
+                bool success = false;
+                uint64_t tid = SiloHelper::lock(smeta->tid, success);
+                if (success == false) {
+                        return false;
+                }
+
+                // reference count > 0, cannot move out the tuple
+                if (smeta->ref_cnt.load() > 0) {
+                        SiloHelper::unlock(smeta->tid);
+                        return false;
+                }
+
+                // copy data back
+                scc_manager->do_read(&smeta->scc_meta, coordinator_id, local_data, migrated_row_value, table->value_size());
+
+                // copy metadata back
+                lmeta->tid.store(tid);
+
+                // set the migrated row as invalid
+                smeta->is_valid.store(false, std::memory_order_release);
+
+                // free the CXL row once no transaction can be reading it
+                std::size_t row_total_size = sizeof(SiloPashaMetadataShared) + table->value_size();
+                cxl_memory.cxlalloc_free_wrapper(smeta, row_total_size,
+                        CXLMemory::DATA_FREE, sizeof(SiloPashaMetadataShared), table->value_size());
+                global_ebr_meta->add_retired_object(smeta, row_total_size, CXLMemory::DATA_FREE);
+
+                return true;
+        }
+
+        migration_result move_from_hashmap_to_shared_region(ITable *table, const void *key, const std::tuple<MetaDataType *, void *> &row, bool inc_ref_cnt, void *&migration_policy_meta)
+	{
+                MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+                bool insert_ret = false;
+                migration_result res = migration_result::FAIL_OOM;
+
+		lmeta->lock();
+                CHECK(lmeta->is_valid == true);
+                if (lmeta->is_migrated == false) {
+                        char *migrated_row_ptr = create_shared_row(table, key, row, lmeta, inc_ref_cnt, migration_policy_meta);
+                        SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(migrated_row_ptr);
+
+                        // set the migrated row as valid
+                        smeta->is_valid.store(true, std::memory_order_release);
+
+                        // insert into the corresponding CXL table
+                        CXLTableBase *target_cxl_table = cxl_tbl_vecs[table->tableID()][table->partitionID()];
+                        insert_ret = target_cxl_table->insert(key, migrated_row_ptr);
+                        CHECK(insert_ret == true);
+
+                        // mark the local row as migrated
+                        lmeta->migrated_row = migrated_row_ptr;
+                        lmeta->is_migrated = true;
+
+                        res = migration_result::SUCCESS;
+                } else {
+                        if (inc_ref_cnt == true) {
+                                // increase the reference count for the requesting host, even if it is already migrated
+                                SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(lmeta->migrated_row);
+                                CHECK(smeta->is_valid.load() == true);
+                                smeta->ref_cnt.fetch_add(1);
+                        }
+                        res = migration_result::FAIL_ALREADY_IN_CXL;
+                }
+		lmeta->unlock();
+
+		return res;
+	}
+
+        migration_result move_from_btree_to_shared_region(ITable *table, const void *key, const std::tuple<MetaDataType *, void *> &row, bool inc_ref_cnt, void *&migration_policy_meta)
+	{
+                MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+                bool insert_ret = false;
+                bool update_next_key_ret = false;
+                migration_result res = migration_result::FAIL_OOM;
+
+                auto move_in_processor = [&](const void *prev_key, void *prev_meta, void *prev_data, const void *cur_key, void *cur_meta, void *cur_data, const void *next_key, void *next_meta, void *next_data) {
+                        auto prev_lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(prev_meta);
+                        auto cur_lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(cur_meta);
+                        auto next_lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(next_meta);
+
+                        CHECK(lmeta != nullptr && cur_lmeta == lmeta);
+
+                        bool is_next_key_migrated = false;
+
+                        // check if the next tuple is migrated
+                        if (next_lmeta != nullptr) {
+                                next_lmeta->lock();
+                                if (next_lmeta->is_migrated == true) {
+                                        is_next_key_migrated = true;
+                                }
+                                next_lmeta->unlock();
+                        } else {
+                                is_next_key_migrated = true;
+                        }
+
+                        // check if the current tuple is migrated
+                        // if not, do the migration and update the next-key information
+                        lmeta->lock();
+                        CHECK(lmeta->is_valid == true);
+                        if (lmeta->is_migrated == false) {
+                                char *migrated_row_ptr = create_shared_row(table, key, row, lmeta, inc_ref_cnt, migration_policy_meta);
+                                SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(migrated_row_ptr);
+
+                                // update the next-key information
+                                smeta->is_next_key_real = is_next_key_migrated;
+
+                                // set the migrated row as valid
+                                smeta->is_valid.store(true, std::memory_order_release);
+
+                                // insert into the corresponding CXL table
+                                CXLTableBase *target_cxl_table = cxl_tbl_vecs[table->tableID()][table->partitionID()];
+                                insert_ret = target_cxl_table->insert(key, migrated_row_ptr);
+                                CHECK(insert_ret == true);
+
+                                // mark the local row as migrated
+                                lmeta->migrated_row = migrated_row_ptr;
+                                lmeta->is_migrated = true;
+
+                                res = migration_result::SUCCESS;
+                        } else {
+                                if (inc_ref_cnt == true) {
+                                        // increase the reference count for the requesting host, even if it is already migrated
+                                        SiloPashaMetadataShared *smeta = reinterpret_cast<SiloPashaMetadataShared *>(lmeta->migrated_row);
+                                        CHECK(smeta->is_valid.load() == true);
+                                        smeta->ref_cnt.fetch_add(1);
+                                }
+                                res = migration_result::FAIL_ALREADY_IN_CXL;
+                        }
+                        lmeta->unlock();
+
+                        if (res == migration_result::SUCCESS) {
+                                // update the next-key information for the previous tuple
+                                // only the owner host writes it, so the local latch is enough
+                                if (prev_lmeta != nullptr) {
+                                        prev_lmeta->lock();
+                                        if (prev_lmeta->is_migrated == true) {
+                                                auto prev_smeta = reinterpret_cast<SiloPashaMetadataShared *>(prev_lmeta->migrated_row);
+                                                prev_smeta->is_next_key_real = true;
+                                        }
+                                        prev_lmeta->unlock();
+                                }
+                        }
+		};
+
+                // update next-key information
+                update_next_key_ret = table->search_and_update_next_key_info(key, move_in_processor);
+                CHECK(update_next_key_ret == true);
+
+		return res;
+	}
+
+        migration_result move_from_partition_to_shared_region(ITable *table, const void *key, const std::tuple<MetaDataType *, void *> &row, bool inc_ref_cnt, void *&migration_policy_meta)
+	{
+                migration_result res = migration_result::FAIL_OOM;
+
+                if (table->tableType() == ITable::HASHMAP) {
+                        res = move_from_hashmap_to_shared_region(table, key, row, inc_ref_cnt, migration_policy_meta);
+                } else if (table->tableType() == ITable::BTREE) {
+                        res = move_from_btree_to_shared_region(table, key, row, inc_ref_cnt, migration_policy_meta);
+                } else {
+                        CHECK(0);
+                }
+
+                // statistics
+                if (res == migration_result::SUCCESS) {
+                        num_data_move_in.fetch_add(1);
+                }
+
+		return res;
+	}
+
+        bool move_from_hashmap_to_partition(ITable *table, const void *key, const std::tuple<MetaDataType *, void *> &row)
+	{
+                MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+                bool ret = false;
+
+                lmeta->lock();
+                CHECK(lmeta->is_valid == true);
+                if (lmeta->is_migrated == true) {
+                        char *migrated_row = lmeta->migrated_row;
+
+                        if (retire_shared_row(table, row, lmeta) == false) {
+                                lmeta->unlock();
+                                return false;
+                        }
+
+                        // remove from CXL index
+                        CXLTableBase *target_cxl_table = cxl_tbl_vecs[table->tableID()][table->partitionID()];
+                        ret = target_cxl_table->remove(key, migrated_row);
+                        CHECK(ret == true);
+
+                        // mark the local row as not migrated
+                        lmeta->migrated_row = nullptr;
+                        lmeta->is_migrated = false;
+                } else {
+                        CHECK(0);
+                }
+                lmeta->unlock();
+
+                return true;
+	}
+
+        bool move_from_btree_to_partition(ITable *table, const void *key, const std::tuple<MetaDataType *, void *> &row)
+	{
+                MetaDataType &meta = *std::get<0>(row);
+		SiloPashaMetadataLocal *lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(meta.load());
+                bool move_out_success = false;
+                bool ret = false;
+
+                auto move_out_processor = [&](const void *prev_key, void *prev_meta, void *prev_data, const void *cur_key, void *cur_meta, void *cur_data, const void *next_key, void *next_meta, void *next_data) {
+                        auto prev_lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(prev_meta);
+                        auto cur_lmeta = reinterpret_cast<SiloPashaMetadataLocal *>(cur_meta);
+
+                        CHECK(lmeta != nullptr && cur_lmeta == lmeta);
+
+                        // move the current tuple out
+                        lmeta->lock();
+                        CHECK(lmeta->is_valid == true);
+                        if (lmeta->is_migrated == true) {
+                                // locked or pinned, cannot move out the tuple -> early return
+                                if (retire_shared_row(table, row, lmeta) == false) {
+                                        lmeta->unlock();
+                                        move_out_success = false;
+                                        return;
+                                }
+
+                                // remove the current-key from the CXL index
+                                // it is safe to do so because there is no concurrent data move in/out
+                                CXLTableBase *target_cxl_table = cxl_tbl_vecs[table->tableID()][table->partitionID()];
+                                ret = target_cxl_table->remove(key, nullptr);
+                                CHECK(ret == true);
+
+                                // mark the local row as not migrated
+                                lmeta->migrated_row = nullptr;
+                                lmeta->is_migrated = false;
+                        } else {
+                                CHECK(0);
+                        }
+                        lmeta->unlock();
+
+                        // update the next-key information for the previous tuple
+                        if (prev_lmeta != nullptr) {
+                                prev_lmeta->lock();
+                                if (prev_lmeta->is_migrated == true) {
+                                        auto prev_smeta = reinterpret_cast<SiloPashaMetadataShared *>(prev_lmeta->migrated_row);
+                                        prev_smeta->is_next_key_real = false;
+                                }
+                                prev_lmeta->unlock();
+                        }
+
+                        move_out_success = true;
+		};
+
+                // update next-key information
+                ret = table->search_and_update_next_key_info(key, move_out_processor);
+                CHECK(ret == true);
+
+		return move_out_success;
+	}
+
+        bool move_from_shared_region_to_partition(ITable *table, const void *key, const std::tuple<MetaDataType *, void *> &row)
+	{
+                bool move_out_success = false;
+
+                if (table->tableType() == ITable::HASHMAP) {
+                        move_out_success = move_from_hashmap_to_partition(table, key, row);
+                } else if (table->tableType() == ITable::BTREE) {
+                        move_out_success = move_from_btree_to_partition(table, key, row);
+                } else {
+                        CHECK(0);
+                }
+
+                // statistics
+                if (move_out_success == true) {
+                        num_data_move_out.fetch_add(1);
+                }
+
+		return move_out_success;
+	}
+
+        bool delete_and_update_next_key_info(ITable *table, const void *key, bool is_local_delete, bool &need_move_out_from_migration_tracker, void *&migration_policy_meta)
+	{
+                CHECK(0);
+	}
+
+    private:
+        std::size_t coordinator_id;
+
+        std::vector<std::vector<CXLTableBase *> > &cxl_tbl_vecs;
+
+        std::atomic<uint64_t> init_finished;
+};
+
+extern SiloPashaHelper *silo_pasha_global_helper;
+
+} // namespace star
@@ -237,6 +237,11 @@ template <class Workload> class StarExecutor : public Worker {
 		flush_async_messages();
 	}
 
+	void collect_latency(Percentile<int64_t> &latency) override
+	{
+		latency.merge(percentile);
+	}
+
 	void onExit() override
 	{
 		LOG(INFO) << "Worker " << id << " latency: " << percentile.nth(50) << " us (50%) " << percentile.nth(75) << " us (75%) " << percentile.nth(95)
@@ -92,7 +92,14 @@ class SundialPashaExecutor : public Executor<Workload, SundialPasha<typename Wor
 				local_read = true;
 			}
 
-			if (local_index_read || local_read) {
+			if (local_index_read && !local_read && table->get_shared_index() != nullptr) {
+                                // the index of another host's partition is read in place from the shared region
+                                void *src = table->get_shared_index()->search(key);
+                                CHECK(src != nullptr);
+                                std::memcpy(value, src, value_size);
+				txn.readSet[key_offset].set_wts(0);
+				txn.readSet[key_offset].set_rts(0);
+			} else if (local_index_read || local_read) {
                                 // statistics
                                 this->n_local_access.fetch_add(1);
 
@@ -345,6 +345,12 @@ template <class Database> class TwoPLPasha {
 			return false;
 		}
 
+                // all locks are held, the rows read without read locks must not have changed since
+                if (validate_optimistic_reads(txn) == false) {
+                        abort(txn, messages);
+                        return false;
+                }
+
                 uint64_t cur_global_epoch = txn.get_logger()->get_global_epoch();
 
                 {
@@ -952,6 +958,54 @@ template <class Database> class TwoPLPasha {
                 }
 	}
 
+        bool validate_optimistic_reads(TransactionType &txn)
+        {
+                auto &readSet = txn.readSet;
+                for (auto i = 0u; i < readSet.size(); i++) {
+                        auto &readKey = readSet[i];
+                        if (readKey.get_optimistic_read_bit() == false) {
+                                continue;
+                        }
+
+                        auto tableId = readKey.get_table_id();
+                        auto partitionId = readKey.get_partition_id();
+                        auto table = db.find_table(tableId, partitionId);
+                        bool valid = false;
+                        if (partitioner.has_master_partition(partitionId)) {
+                                auto cached_row = readKey.get_cached_local_row();
+                                DCHECK(std::get<0>(cached_row) != nullptr && std::get<1>(cached_row) != nullptr);
+                                bool write_locked_by_self = holds_write_lock(txn, [&](TwoPLPashaRWKey &key) {
+                                        return std::get<0>(key.get_cached_local_row()) == std::get<0>(cached_row);
+                                });
+                                valid = twopl_pasha_global_helper->validate_optimistic_read(cached_row, readKey.get_tid(), table->value_size(), write_locked_by_self);
+                        } else {
+                                char *migrated_row = readKey.get_cached_migrated_row();
+                                DCHECK(migrated_row != nullptr);
+                                bool write_locked_by_self = holds_write_lock(txn, [&](TwoPLPashaRWKey &key) { return key.get_cached_migrated_row() == migrated_row; });
+                                valid = twopl_pasha_global_helper->remote_validate_optimistic_read(migrated_row, readKey.get_tid(), table->value_size(),
+                                                                                                   write_locked_by_self);
+                        }
+
+                        if (valid == false) {
+                                txn.abort_read_validation = true;
+                                return false;
+                        }
+                }
+                return true;
+        }
+
+        // a row read optimistically may be write-locked later by the same transaction, e.g., by search_for_update in a later batch
+        template <class SameRowFunc> bool holds_write_lock(TransactionType &txn, SameRowFunc same_row)
+        {
+                auto &readSet = txn.readSet;
+                for (auto i = 0u; i < readSet.size(); i++) {
+                        if (readSet[i].get_write_lock_bit() && same_row(readSet[i])) {
+                                return true;
+                        }
+                }
+                return false;
+        }
+
         void release_migrated_rows(TransactionType &txn)
         {
                 // release rows in the read set
@@ -35,6 +35,8 @@ class TwoPLPashaExecutor : public Executor<Workload, TwoPLPasha<typename Workloa
 
 	using StorageType = typename WorkloadType::StorageType;
 
+	using TypedTablesType = TypedTables<DatabaseType, MetaInitFuncTwoPLPasha>;
+
 	TwoPLPashaExecutor(std::size_t coordinator_id, std::size_t id, DatabaseType &db, const ContextType &context, std::atomic<uint32_t> &worker_status,
 		      std::atomic<uint32_t> &n_complete_workers, std::atomic<uint32_t> &n_started_workers)
 		: base_type(coordinator_id, id, db, context, worker_status, n_complete_workers, n_started_workers)
@@ -78,101 +80,31 @@ class TwoPLPashaExecutor : public Executor<Workload, TwoPLPasha<typename Workloa
 
 	void setupHandlers(TransactionType &txn) override
 	{
+                // called from the worker thread, which serves its requests while it waits for a lock
+                if (!TwoPLPashaHelper::lock_wait_poller()) {
+                        TwoPLPashaHelper::lock_wait_poller() = [this]() { this->process_request(); };
+                }
+
 		txn.lock_request_handler = [this, &txn](std::size_t table_id, std::size_t partition_id, uint32_t key_offset, const void *key, void *value,
 							bool local_index_read, bool write_lock, std::tuple<star::ITable::MetaDataType *, void *> &cached_local_row,
                                                         char *&cached_migrated_row, bool &success, bool &remote) -> uint64_t {
-                        ITable *table = this->db.find_table(table_id, partition_id);
-
-			if (local_index_read) {
-				success = true;
-				remote = false;
-                                auto value_bytes = table->value_size();
-                                auto row = table->search(key);
-				return twopl_pasha_global_helper->read(row, value, value_bytes, this->n_local_cxl_access);
-			}
-
-			if (this->partitioner->has_master_partition(partition_id)) {
-                                // statistics
-                                this->n_local_access.fetch_add(1);
-
-				remote = false;
-
-				auto row = table->search(key);
-                                DCHECK(std::get<0>(row) != nullptr && std::get<1>(row) != nullptr);
-
-                                if (this->context.model_cxl_search_overhead == true) {
-                                        twopl_pasha_global_helper->model_cxl_search_overhead(row, table_id, partition_id, key);
-                                }
-
-                                cached_local_row = row;
-
-                                uint64_t tid = 0;
-
-				if (write_lock) {
-					tid = twopl_pasha_global_helper->take_write_lock_and_read(row, value, table->value_size(), success, this->n_local_cxl_access);
-				} else {
-					tid = twopl_pasha_global_helper->take_read_lock_and_read(row, value, table->value_size(), success, this->n_local_cxl_access);
-				}
-
-				if (success == true) {
-					return tid;
-				} else {
-					return 0;
-				}
-			} else {
-                                // statistics
-                                this->n_remote_access.fetch_add(1);
-
-                                // multi-host transaction
-                                txn.distributed_transaction = true;
-
-                                if (migration_manager->when_to_move_out == MigrationManager::Reactive) {
-                                        // update remote hosts involved
-                                        auto coordinatorID = this->partitioner->master_coordinator(partition_id);
-                                        txn.remote_hosts_involved.insert(coordinatorID);
-                                }
-
-                                // I am not the owner of the data
-                                char *migrated_row = twopl_pasha_global_helper->get_migrated_row(table_id, partition_id, key, true);
-                                if (migrated_row != nullptr) {
-                                        remote = false;
-
-                                        // cache migrated row pointer
-                                        cached_migrated_row = migrated_row;
-
-                                        uint64_t tid = 0;
-
-                                        // mark it as reference counted so that we know if we need to release it upon commit/abort
-                                        txn.readSet[key_offset].set_reference_counted();
-
-                                        if (write_lock) {
-                                                tid = twopl_pasha_global_helper->remote_take_write_lock_and_read(migrated_row, value, table->value_size(), false, success);
-                                        } else {
-                                                tid = twopl_pasha_global_helper->remote_take_read_lock_and_read(migrated_row, value, table->value_size(), false, success);
-                                        }
-
-                                        if (success == true) {
-                                                return tid;
-                                        } else {
-                                                return 0;
-                                        }
-                                } else {
-                                        // statistics
-                                        this->n_remote_access_with_req.fetch_add(1);
-
-                                        remote = true;
-
-                                        // data is not in the shared region
-                                        // ask the remote host to do the data migration
-                                        auto coordinatorID = this->partitioner->master_coordinator(partition_id);
-                                        txn.network_size += MessageFactoryType::new_data_migration_message(*(this->messages[coordinatorID]), *table, key, txn.transaction_id, key_offset);
-                                        txn.pendingResponses++;
-
-                                        return 0;
-                                }
-			}
+                        return this->lock_request(this->db.find_table(table_id, partition_id), txn, table_id, partition_id, key_offset, key, value,
+                                                  local_index_read, write_lock, cached_local_row, cached_migrated_row, success, remote);
 		};
 
+                if (TypedTablesType::typed == true) {
+                        // the lookup and lock path below is instantiated for the concrete table type and inlined into the loop over the rows
+                        txn.read_requests_handler = [this, &txn]() -> bool {
+                                auto lock_request = [this, &txn](std::size_t table_id, std::size_t partition_id, uint32_t key_offset, const void *key, void *value,
+                                                                 bool local_index_read, bool write_lock, std::tuple<star::ITable::MetaDataType *, void *> &cached_local_row,
+                                                                 char *&cached_migrated_row, bool &success, bool &remote) -> uint64_t {
+                                        return this->lock_request(TypedTablesType::find_table(this->db, table_id, partition_id), txn, table_id, partition_id, key_offset,
+                                                                  key, value, local_index_read, write_lock, cached_local_row, cached_migrated_row, success, remote);
+                                };
+                                return txn.process_read_requests(lock_request);
+                        };
+                }
+
                 if (this->context.enable_phantom_detection == true) {
                         txn.scanRequestHandler = [this, &txn](std::size_t table_id, std::size_t partition_id, uint32_t key_offset, const void *min_key, const void *max_key,
                                                 uint64_t limit, int type, void *results, ITable::row_entity &next_row_entity, bool &migration_required) -> bool {
@@ -549,10 +481,160 @@ class TwoPLPashaExecutor : public Executor<Workload, TwoPLPasha<typename Workloa
                         };
                 };
 
+                if (this->context.enable_row_prefetch == true) {
+                        txn.prefetch_request_handler = [this](std::size_t table_id, std::size_t partition_id, const void *const *keys,
+                                                              std::tuple<star::ITable::MetaDataType *, void *> *rows, char **migrated_rows, std::size_t n) -> bool {
+                                if (this->partitioner->has_master_partition(partition_id) == false) {
+                                        twopl_pasha_global_helper->prefetch_migrated_rows(table_id, partition_id, keys, migrated_rows, n);
+                                        return true;
+                                }
+
+                                // bring the local metadata and the rows into the cache before they are locked
+                                ITable *table = this->db.find_table(table_id, partition_id);
+                                table->search_batch(keys, rows, n);
+                                for (std::size_t i = 0; i < n; i++) {
+                                        if (std::get<0>(rows[i]) != nullptr) {
+                                                __builtin_prefetch(reinterpret_cast<void *>(std::get<0>(rows[i])->load(std::memory_order_relaxed)), 1);
+                                                TwoPLPashaHelper::prefetch_range(std::get<1>(rows[i]), table->value_size());
+                                        }
+                                }
+                                return false;
+                        };
+
+                        txn.row_prefetch_handler = [this](std::size_t table_id, std::size_t partition_id, const std::tuple<star::ITable::MetaDataType *, void *> &row,
+                                                          int stage) -> bool {
+                                ITable *table = this->db.find_table(table_id, partition_id);
+                                return twopl_pasha_global_helper->prefetch_row(row, stage, table->value_size());
+                        };
+                }
+
 		txn.remote_request_handler = [this](std::size_t) { return this->process_request(); };
 		txn.message_flusher = [this]() { this->flush_messages(); };
 		txn.get_table = [this](std::size_t tableId, std::size_t partitionId) { return this->db.find_table(tableId, partitionId); };
 		txn.set_logger(this->logger);
 	};
+
+    private:
+        // takes the lock of a row and reads it; TableType is ITable or the concrete type of the table found by TypedTables
+        template <class TableType>
+        uint64_t lock_request(TableType *table, TransactionType &txn, std::size_t table_id, std::size_t partition_id, uint32_t key_offset, const void *key,
+                              void *value, bool local_index_read, bool write_lock, std::tuple<star::ITable::MetaDataType *, void *> &cached_local_row,
+                              char *&cached_migrated_row, bool &success, bool &remote)
+        {
+                // wait-die timestamp, also used when the lock is taken after a remote host has moved the row into CXL
+                if (txn.lock_ts == 0) {
+                        txn.lock_ts = TwoPLPashaHelper::make_lock_ts(++lock_ts_counter, this->coordinator_id, this->id);
+                }
+
+		if (local_index_read) {
+			success = true;
+			remote = false;
+                        auto value_bytes = table->value_size();
+                        if (table->get_shared_index() != nullptr && !this->partitioner->has_master_partition(partition_id)) {
+                                // the index of another host's partition is read in place from the shared region
+                                void *src = table->get_shared_index()->search(key);
+                                CHECK(src != nullptr);
+                                std::memcpy(value, src, value_bytes);
+                                return 0;
+                        }
+                        auto row = table->search(key);
+			return twopl_pasha_global_helper->read(row, value, value_bytes, this->n_local_cxl_access);
+		}
+
+                // until the transaction asks for a write, its rows are read without read locks and validated at commit
+                bool optimistic_read = this->context.enable_optimistic_reads == true && write_lock == false && txn.write_requested == false;
+
+		if (this->partitioner->has_master_partition(partition_id)) {
+                        // statistics
+                        this->n_local_access.fetch_add(1);
+
+			remote = false;
+
+                        // the prefetch stage may have found the row already
+			auto row = std::get<0>(cached_local_row) != nullptr ? cached_local_row : table->search(key);
+                        DCHECK(std::get<0>(row) != nullptr && std::get<1>(row) != nullptr);
+
+                        if (this->context.model_cxl_search_overhead == true) {
+                                twopl_pasha_global_helper->model_cxl_search_overhead(row, table_id, partition_id, key);
+                        }
+
+                        cached_local_row = row;
+
+                        uint64_t tid = 0;
+
+			if (write_lock) {
+				tid = twopl_pasha_global_helper->take_write_lock_and_read(row, value, table->value_size(), success, this->n_local_cxl_access, txn.lock_ts);
+			} else if (optimistic_read) {
+				tid = twopl_pasha_global_helper->read_optimistic(row, value, table->value_size(), success, this->n_local_cxl_access, txn.lock_ts);
+				txn.readSet[key_offset].set_optimistic_read_bit();
+			} else {
+				tid = twopl_pasha_global_helper->take_read_lock_and_read(row, value, table->value_size(), success, this->n_local_cxl_access, txn.lock_ts);
+			}
+
+			if (success == true) {
+				return tid;
+			} else {
+				return 0;
+			}
+		} else {
+                        // statistics
+                        this->n_remote_access.fetch_add(1);
+
+                        // multi-host transaction
+                        txn.distributed_transaction = true;
+
+                        if (migration_manager->when_to_move_out == MigrationManager::Reactive) {
+                                // update remote hosts involved
+                                auto coordinatorID = this->partitioner->master_coordinator(partition_id);
+                                txn.remote_hosts_involved.insert(coordinatorID);
+                        }
+
+                        // I am not the owner of the data
+                        char *migrated_row = cached_migrated_row != nullptr ? twopl_pasha_global_helper->pin_migrated_row(partition_id, cached_migrated_row, true)
+                                                                            : twopl_pasha_global_helper->get_migrated_row(table_id, partition_id, key, true);
+                        if (migrated_row != nullptr) {
+                                remote = false;
+
+                                // cache migrated row pointer
+                                cached_migrated_row = migrated_row;
+
+                                uint64_t tid = 0;
+
+                                // mark it as reference counted so that we know if we need to release it upon commit/abort
+                                txn.readSet[key_offset].set_reference_counted();
+
+                                if (write_lock) {
+                                        tid = twopl_pasha_global_helper->remote_take_write_lock_and_read(migrated_row, value, table->value_size(), false, success, txn.lock_ts);
+                                } else if (optimistic_read) {
+                                        tid = twopl_pasha_global_helper->remote_read_optimistic(migrated_row, value, table->value_size(), success, txn.lock_ts);
+                                        txn.readSet[key_offset].set_optimistic_read_bit();
+                                } else {
+                                        tid = twopl_pasha_global_helper->remote_take_read_lock_and_read(migrated_row, value, table->value_size(), false, success, txn.lock_ts);
+                                }
+
+                                if (success == true) {
+                                        return tid;
+                                } else {
+                                        return 0;
+                                }
+                        } else {
+                                // statistics
+                                this->n_remote_access_with_req.fetch_add(1);
+
+                                remote = true;
+
+                                // data is not in the shared region
+                                // ask the remote host to do the data migration
+                                auto coordinatorID = this->partitioner->master_coordinator(partition_id);
+                                txn.network_size += MessageFactoryType::new_data_migration_message(*(this->messages[coordinatorID]), *table, key, txn.transaction_id, key_offset);
+                                txn.pendingResponses++;
+
+                                return 0;
+                        }
+		}
+        }
+
+        // wait-die timestamps handed out by this worker
+        uint64_t lock_ts_counter = 0;
 };
 } // namespace star
@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <immintrin.h>
 #include <list>
 #include <tuple>
 #include <memory>
@@ -29,6 +33,7 @@ namespace star
 struct TwoPLPashaSharedDataSCC {
         TwoPLPashaSharedDataSCC()
                 : tid(0)
+                , lock_ts(0)
                 , flags(0)
                 , ref_cnt(0)
         {}
@@ -49,6 +54,9 @@ struct TwoPLPashaSharedDataSCC {
 
         uint64_t tid{ 0 };
 
+        // lower bound of the wait-die timestamps of the current lock holders
+        uint64_t lock_ts{ 0 };
+
         // is_valid
         uint8_t flags{ 0 };
 
@@ -91,6 +99,12 @@ struct TwoPLPashaMetadataLocal {
 
 	uint64_t tid{ 0 };
 
+        // lower bound of the wait-die timestamps of the current lock holders
+        uint64_t lock_ts{ 0 };
+
+        // number of older transactions waiting for this lock
+        uint32_t n_waiters{ 0 };
+
         bool is_valid{ false };
 
         bool is_migrated{ false };
@@ -264,6 +278,31 @@ retry:
                 clear_bit(is_data_modified_since_moved_in_bit_index);
         }
 
+        // number of older transactions waiting for this lock
+        uint64_t get_waiter_count()
+        {
+                return (atomic_word.load(std::memory_order_acquire) >> WAITER_BITS_OFFSET) & WAITER_BITS_MASK;
+        }
+
+        uint64_t get_waiter_count_max()
+        {
+                return WAITER_BITS_MASK;
+        }
+
+        void increase_waiter_count()
+        {
+                uint64_t orig_atomic_word = atomic_word.load(std::memory_order_acquire);
+                orig_atomic_word += (1ull << WAITER_BITS_OFFSET);
+                atomic_word.store(orig_atomic_word, std::memory_order_release);
+        }
+
+        void decrease_waiter_count()
+        {
+                uint64_t orig_atomic_word = atomic_word.load(std::memory_order_acquire);
+                orig_atomic_word -= (1ull << WAITER_BITS_OFFSET);
+                atomic_word.store(orig_atomic_word, std::memory_order_release);
+        }
+
         // SCC
         void clear_all_scc_bits()
         {
@@ -279,11 +318,14 @@ retry:
 	static constexpr int LATCH_BIT_OFFSET = 63;
 	static constexpr uint64_t LATCH_BIT_MASK = 0x1ull;
 
+        static constexpr int WAITER_BITS_OFFSET = 55;
+	static constexpr uint64_t WAITER_BITS_MASK = 0xffull;
+
         static constexpr int SCC_DATA_OFFSET = 0;
 	static constexpr uint64_t SCC_DATA_MASK = 0x1fffffffffull;
 
         static constexpr int SCC_BITS_OFFSET = 47;
-	static constexpr uint64_t SCC_BITS_MASK = 0xffffull;
+	static constexpr uint64_t SCC_BITS_MASK = 0xffull;
 
         static constexpr int READ_LOCK_BITS_OFFSET = 42;
 	static constexpr uint64_t READ_LOCK_BITS_MASK = 0x1full;
@@ -301,7 +343,8 @@ retry:
         static constexpr int second_chance_bit_index = 37;
 
         // bit 63: latch bit
-        // bit 62 - 47: software cache-coherence metadata
+        // bit 62 - 55: waiter count
+        // bit 54 - 47: software cache-coherence metadata
         // bit 46 - 42: read lock bits
         // bit 41 - 41: write lock bit
         // bit 40 - 40: is_data_modified_since_moved_in
@@ -313,6 +356,27 @@ retry:
 
 uint64_t TwoPLPashaMetadataLocalInit(bool is_tuple_valid);
 
+// the metadata a waiting transaction is counted on, it withdraws from the same one even if the row migrates meanwhile
+struct TwoPLPashaWaiter {
+        bool is_registered() const
+        {
+                return lmeta != nullptr || smeta != nullptr;
+        }
+
+        bool is_counted_on(const TwoPLPashaMetadataLocal *meta) const
+        {
+                return lmeta == meta;
+        }
+
+        bool is_counted_on(const TwoPLPashaMetadataShared *meta) const
+        {
+                return smeta == meta;
+        }
+
+        TwoPLPashaMetadataLocal *lmeta{ nullptr };
+        TwoPLPashaMetadataShared *smeta{ nullptr };
+};
+
 class TwoPLPashaHelper {
     public:
 	using MetaDataType = std::atomic<uint64_t>;
@@ -322,6 +386,31 @@ class TwoPLPashaHelper {
                 , context(context)
                 , cxl_tbl_vecs(cxl_tbl_vecs)
         {
+                CHECK(context.lock_wait_policy == "NoWait" || context.lock_wait_policy == "WaitDie") << "unknown lock wait policy " << context.lock_wait_policy;
+                lock_wait_die = context.lock_wait_policy == "WaitDie";
+
+                // every host sets its own bit in the shared metadata word
+                CHECK(context.coordinator_num <= TwoPLPashaMetadataShared::scc_bits_num) << "too many coordinators for the shared metadata word";
+                if (lock_wait_die == true) {
+                        CHECK(context.coordinator_num <= (1ull << lock_ts_id_bits)) << "too many coordinators for wait-die timestamps";
+                        CHECK(context.worker_num <= (1ull << lock_ts_id_bits)) << "too many workers for wait-die timestamps";
+                }
+        }
+
+        // wait-die timestamp of a transaction, taken at its first start so that it survives retries
+        // the counter is private to each worker, the coordinator id and the worker id break ties, so no shared state is touched
+        static uint64_t make_lock_ts(uint64_t worker_counter, std::size_t coordinator_id, std::size_t worker_id)
+        {
+                return (worker_counter << (2 * lock_ts_id_bits)) | (coordinator_id << lock_ts_id_bits) | worker_id;
+        }
+
+        static constexpr int lock_ts_id_bits = 8;
+
+        // requests served by a worker while it waits for a lock, set by every worker thread
+        static std::function<void()> &lock_wait_poller()
+        {
+                static thread_local std::function<void()> poller;
+                return poller;
         }
 
 	uint64_t read(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, std::atomic<uint64_t> &local_cxl_access)
@@ -441,80 +530,69 @@ class TwoPLPashaHelper {
                 value &= ~(WRITE_LOCK_BIT_MASK << WRITE_LOCK_BIT_OFFSET);
         }
 
-	uint64_t read_lock(std::atomic<uint64_t> &meta, uint64_t size, bool &success)
+        // point locks: with the WaitDie policy, a transaction that conflicts with younger lock holders retries
+        // the lock for a bounded number of attempts instead of aborting right away
+        uint64_t take_read_lock_and_read(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, bool &success, std::atomic<uint64_t> &local_cxl_access,
+                                         uint64_t lock_ts = 0)
 	{
-                TwoPLPashaMetadataLocal *lmeta = reinterpret_cast<TwoPLPashaMetadataLocal *>(meta.load());
-                uint64_t old_value = 0, new_value = 0;
-                uint64_t tid = 0;
-
-                lmeta->lock();
-                if (lmeta->is_migrated == false) {
-                        if (lmeta->is_valid == false) {
-                                success = false;
-                                goto out_unlock_lmeta;
-                        }
-
-                        old_value = lmeta->tid;
-                        tid = remove_lock_bit(old_value);
-
-                        // can we get the lock?
-                        if (is_write_locked(old_value) || read_lock_num(old_value) == read_lock_max()) {
-                                success = false;
-                                goto out_unlock_lmeta;
-                        }
-
-                        // OK, we can get the lock
-                        new_value = old_value + (1ull << READ_LOCK_BIT_OFFSET);
-                        lmeta->tid = new_value;
-                        success = true;
-                } else {
-                        TwoPLPashaMetadataShared *smeta = reinterpret_cast<TwoPLPashaMetadataShared *>(lmeta->migrated_row);
-                        TwoPLPashaSharedDataSCC *scc_data = smeta->get_scc_data();
-
-                        smeta->lock();
-
-                        // SCC prepare read
-                        scc_manager->prepare_read(smeta, coordinator_id, scc_data, sizeof(TwoPLPashaSharedDataSCC) + size);
-
-                        if (scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index) == false) {
-                                smeta->unlock();
-                                success = false;
-                                goto out_unlock_lmeta;
-                        }
+                return lock_or_wait(success, [&](bool &wait, TwoPLPashaWaiter &waiter) {
+                        return try_take_read_lock_and_read(row, dest, size, success, local_cxl_access, lock_ts, wait, waiter);
+                });
+	}
 
-                        old_value = scc_data->tid;
-                        tid = remove_lock_bit(old_value);
+        uint64_t take_write_lock_and_read(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, bool &success, std::atomic<uint64_t> &local_cxl_access,
+                                          uint64_t lock_ts = 0)
+	{
+                return lock_or_wait(success, [&](bool &wait, TwoPLPashaWaiter &waiter) {
+                        return try_take_write_lock_and_read(row, dest, size, success, local_cxl_access, lock_ts, wait, waiter);
+                });
+	}
 
-                        // can we get the lock?
-                        if (smeta->is_write_locked() || smeta->get_reader_count() == smeta->get_reader_count_max()) {
-                                success = false;
-                                smeta->unlock();
-                                goto out_unlock_lmeta;
-                        }
+        uint64_t remote_take_read_lock_and_read(char *row, void *dest, std::size_t size, bool inc_ref_cnt, bool &success, uint64_t lock_ts = 0)
+	{
+                return lock_or_wait(success, [&](bool &wait, TwoPLPashaWaiter &waiter) {
+                        return try_remote_take_read_lock_and_read(row, dest, size, inc_ref_cnt, success, lock_ts, wait, waiter);
+                });
+	}
 
-                        // OK, we can get the lock
-                        smeta->increase_reader_count();
-                        success = true;
+        uint64_t remote_take_write_lock_and_read(char *row, void *dest, std::size_t size, bool inc_ref_cnt, bool &success, uint64_t lock_ts = 0)
+	{
+                return lock_or_wait(success, [&](bool &wait, TwoPLPashaWaiter &waiter) {
+                        return try_remote_take_write_lock_and_read(row, dest, size, inc_ref_cnt, success, lock_ts, wait, waiter);
+                });
+	}
 
-                        smeta->unlock();
-                }
+        // optimistic reads: the row is copied under its latch without joining the lock holders,
+        // its version is checked again at commit; a write-locked row is a lock conflict
+        uint64_t read_optimistic(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, bool &success, std::atomic<uint64_t> &local_cxl_access,
+                                 uint64_t lock_ts = 0)
+	{
+                // optimistic readers never count themselves as waiters
+                return lock_or_wait(success, [&](bool &wait, TwoPLPashaWaiter &) {
+                        return try_read_optimistic(row, dest, size, success, local_cxl_access, lock_ts, wait);
+                });
+	}
 
-out_unlock_lmeta:
-                lmeta->unlock();
-		return tid;
+        uint64_t remote_read_optimistic(char *row, void *dest, std::size_t size, bool &success, uint64_t lock_ts = 0)
+	{
+                return lock_or_wait(success, [&](bool &wait, TwoPLPashaWaiter &) {
+                        return try_remote_read_optimistic(row, dest, size, success, lock_ts, wait);
+                });
 	}
 
-        uint64_t take_read_lock_and_read(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, bool &success, std::atomic<uint64_t> &local_cxl_access)
+        // the latch, SCC-refresh and copy part shared by optimistic reads and lock acquisitions of a local row
+        // acquire(lmeta, smeta, scc_data, old_value) decides with the latches held, smeta is nullptr if the row has not been migrated
+        template <class AcquireFunc>
+        uint64_t latch_and_read(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, bool &success, std::atomic<uint64_t> &local_cxl_access,
+                                AcquireFunc acquire)
 	{
                 MetaDataType &meta = *std::get<0>(row);
                 TwoPLPashaMetadataLocal *lmeta = reinterpret_cast<TwoPLPashaMetadataLocal *>(meta.load());
-                uint64_t old_value = 0, new_value = 0;
+                uint64_t old_value = 0;
                 uint64_t tid = 0;
 
                 lmeta->lock();
                 if (lmeta->is_migrated == false) {
-                        void *src = std::get<1>(row);
-
                         if (lmeta->is_valid == false) {
                                 success = false;
                                 goto out_unlock_lmeta;
@@ -523,23 +601,14 @@ out_unlock_lmeta:
                         old_value = lmeta->tid;
                         tid = remove_lock_bit(old_value);
 
-                        // can we get the lock?
-                        if (is_write_locked(old_value) || read_lock_num(old_value) == read_lock_max()) {
-                                success = false;
-                                goto out_unlock_lmeta;
+                        success = acquire(lmeta, nullptr, nullptr, old_value);
+                        if (success == true) {
+                                // read the data
+                                std::memcpy(dest, std::get<1>(row), size);
                         }
-
-                        // OK, we can get the lock
-                        new_value = old_value + (1ull << READ_LOCK_BIT_OFFSET);
-                        lmeta->tid = new_value;
-                        success = true;
-
-                        // read the data
-                        std::memcpy(dest, src, size);
                 } else {
                         TwoPLPashaMetadataShared *smeta = reinterpret_cast<TwoPLPashaMetadataShared *>(lmeta->migrated_row);
                         TwoPLPashaSharedDataSCC *scc_data = smeta->get_scc_data();
-                        void *src = nullptr;
 
                         smeta->lock();
 
@@ -556,9 +625,6 @@ out_unlock_lmeta:
                                         goto out_unlock_lmeta;
                                 }
 
-                                old_value = scc_data->tid;
-                                tid = remove_lock_bit(old_value);
-
                                 // we update our local cache
                                 lmeta->is_valid = scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index);
                                 lmeta->tid = scc_data->tid;
@@ -566,34 +632,20 @@ out_unlock_lmeta:
 
                                 // unset the flag
                                 smeta->clear_is_data_modified_since_moved_in();
-
-                                src = std::get<1>(row);
-                        } else {
-                                if (lmeta->is_valid == false) {
-                                        smeta->unlock();
-                                        success = false;
-                                        goto out_unlock_lmeta;
-                                }
-
-                                old_value = lmeta->tid;
-                                tid = remove_lock_bit(old_value);
-
-                                src = std::get<1>(row);
-                        }
-
-                        // can we get the lock?
-                        if (smeta->is_write_locked() || smeta->get_reader_count() == smeta->get_reader_count_max()) {
-                                success = false;
+                        } else if (lmeta->is_valid == false) {
                                 smeta->unlock();
+                                success = false;
                                 goto out_unlock_lmeta;
                         }
 
-                        // OK, we can get the lock
-                        smeta->increase_reader_count();
-                        success = true;
+                        old_value = lmeta->tid;
+                        tid = remove_lock_bit(old_value);
 
-                        // read the data from the local copy
-                        memcpy(dest, src, size);
+                        success = acquire(lmeta, smeta, scc_data, old_value);
+                        if (success == true) {
+                                // read the data from the local copy
+                                std::memcpy(dest, std::get<1>(row), size);
+                        }
 
                         smeta->unlock();
                 }
@@ -603,12 +655,11 @@ out_unlock_lmeta:
 		return tid;
 	}
 
-        uint64_t remote_take_read_lock_and_read(char *row, void *dest, std::size_t size, bool inc_ref_cnt, bool &success)
+        // the same for a row in the shared region of another host, acquire(smeta, scc_data) decides with the latch held
+        template <class AcquireFunc> uint64_t remote_latch_and_read(char *row, void *dest, std::size_t size, bool &success, AcquireFunc acquire)
 	{
 		TwoPLPashaMetadataShared *smeta = reinterpret_cast<TwoPLPashaMetadataShared *>(row);
                 TwoPLPashaSharedDataSCC *scc_data = smeta->get_scc_data();
-                void *src = scc_data->data;
-                uint64_t old_value = 0, new_value = 0;
                 uint64_t tid = 0;
 
 		smeta->lock();
@@ -617,31 +668,17 @@ out_unlock_lmeta:
                 scc_manager->prepare_read(smeta, coordinator_id, scc_data, sizeof(TwoPLPashaSharedDataSCC) + size);
 
                 if (scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index) == false) {
-                        success = false;
-                        smeta->unlock();
-                        return remove_lock_bit(old_value);
-                }
-
-                old_value = scc_data->tid;
-                tid = remove_lock_bit(old_value);
-
-                // can we get the lock?
-                if (smeta->is_write_locked() || smeta->get_reader_count() == smeta->get_reader_count_max()) {
                         success = false;
                         smeta->unlock();
                         return tid;
                 }
 
-                // OK, we can get the lock
-                smeta->increase_reader_count();
-                success = true;
-
-                // read the data
-                scc_manager->do_read(nullptr, coordinator_id, dest, src, size);
+                tid = remove_lock_bit(scc_data->tid);
 
-                // increase reference counting only if we get the lock
-                if (inc_ref_cnt == true) {
-                        scc_data->ref_cnt++;
+                success = acquire(smeta, scc_data);
+                if (success == true) {
+                        // read the data
+                        scc_manager->do_read(nullptr, coordinator_id, dest, scc_data->data, size);
                 }
 
                 smeta->unlock();
@@ -649,47 +686,76 @@ out_unlock_lmeta:
 		return tid;
 	}
 
-        uint64_t remote_read_lock_and_inc_ref_cnt(char *row, uint64_t size, bool &success)
+        uint64_t try_read_optimistic(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, bool &success, std::atomic<uint64_t> &local_cxl_access,
+                                     uint64_t lock_ts, bool &wait)
 	{
-		TwoPLPashaMetadataShared *smeta = reinterpret_cast<TwoPLPashaMetadataShared *>(row);
-                TwoPLPashaSharedDataSCC *scc_data = smeta->get_scc_data();
-                uint64_t old_value = 0, new_value = 0;
-                uint64_t tid = 0;
+                return latch_and_read(row, dest, size, success, local_cxl_access,
+                                      [&](TwoPLPashaMetadataLocal *lmeta, TwoPLPashaMetadataShared *smeta, TwoPLPashaSharedDataSCC *scc_data, uint64_t old_value) {
+                                              if (smeta == nullptr) {
+                                                      if (is_write_locked(old_value)) {
+                                                              wait = wait_die(lock_ts, lmeta->lock_ts);
+                                                              return false;
+                                                      }
+                                              } else if (smeta->is_write_locked()) {
+                                                      wait = wait_die(lock_ts, scc_data->lock_ts);
+                                                      return false;
+                                              }
+                                              return true;
+                                      });
+	}
 
-		smeta->lock();
+        uint64_t try_remote_read_optimistic(char *row, void *dest, std::size_t size, bool &success, uint64_t lock_ts, bool &wait)
+	{
+                return remote_latch_and_read(row, dest, size, success, [&](TwoPLPashaMetadataShared *smeta, TwoPLPashaSharedDataSCC *scc_data) {
+                        if (smeta->is_write_locked()) {
+                                wait = wait_die(lock_ts, scc_data->lock_ts);
+                                return false;
+                        }
+                        return true;
+                });
+	}
 
-                // SCC prepare read
-                scc_manager->prepare_read(smeta, coordinator_id, scc_data, sizeof(TwoPLPashaSharedDataSCC) + size);
+        // the version of an optimistically read row is unchanged and no other writer holds it
+        // the write lock of the validating transaction itself does not make the read invalid
+        bool validate_optimistic_read(const std::tuple<MetaDataType *, void *> &row, uint64_t tid, std::size_t size, bool write_locked_by_self)
+	{
+                MetaDataType &meta = *std::get<0>(row);
+                TwoPLPashaMetadataLocal *lmeta = reinterpret_cast<TwoPLPashaMetadataLocal *>(meta.load());
+                bool valid = false;
 
-                if (scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index) == false) {
-                        success = false;
-                        smeta->unlock();
-                        return remove_lock_bit(old_value);
+                lmeta->lock();
+                if (lmeta->is_migrated == false) {
+                        valid = lmeta->is_valid == true && (write_locked_by_self == true || is_write_locked(lmeta->tid) == false) &&
+                                remove_lock_bit(lmeta->tid) == tid;
+                } else {
+                        // the shared copy has the latest version, even if the local cache has not been refreshed
+                        valid = remote_validate_optimistic_read(lmeta->migrated_row, tid, size, write_locked_by_self);
                 }
+                lmeta->unlock();
 
-                old_value = scc_data->tid;
-                tid = remove_lock_bit(old_value);
+		return valid;
+	}
 
-                // can we get the lock?
-                if (smeta->is_write_locked() || smeta->get_reader_count() == smeta->get_reader_count_max()) {
-                        success = false;
-                        smeta->unlock();
-                        return tid;
-                }
+        bool remote_validate_optimistic_read(char *row, uint64_t tid, std::size_t size, bool write_locked_by_self)
+	{
+		TwoPLPashaMetadataShared *smeta = reinterpret_cast<TwoPLPashaMetadataShared *>(row);
+                TwoPLPashaSharedDataSCC *scc_data = smeta->get_scc_data();
+                bool valid = false;
 
-                // OK, we can get the lock
-                smeta->increase_reader_count();
-                success = true;
+		smeta->lock();
 
-                // increase reference counting only if we get the lock
-                scc_data->ref_cnt++;
+                // SCC prepare read
+                scc_manager->prepare_read(smeta, coordinator_id, scc_data, sizeof(TwoPLPashaSharedDataSCC) + size);
+
+                valid = scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index) == true &&
+                        (write_locked_by_self == true || smeta->is_write_locked() == false) && remove_lock_bit(scc_data->tid) == tid;
 
                 smeta->unlock();
 
-		return tid;
+		return valid;
 	}
 
-	uint64_t write_lock(std::atomic<uint64_t> &meta, uint64_t size, bool &success)
+	uint64_t read_lock(std::atomic<uint64_t> &meta, uint64_t size, bool &success)
 	{
                 TwoPLPashaMetadataLocal *lmeta = reinterpret_cast<TwoPLPashaMetadataLocal *>(meta.load());
                 uint64_t old_value = 0, new_value = 0;
@@ -706,13 +772,14 @@ out_unlock_lmeta:
                         tid = remove_lock_bit(old_value);
 
                         // can we get the lock?
-                        if (is_read_locked(old_value) || is_write_locked(old_value)) {
+                        if (is_write_locked(old_value) || read_lock_num(old_value) == read_lock_max()) {
                                 success = false;
                                 goto out_unlock_lmeta;
                         }
 
                         // OK, we can get the lock
-                        new_value = old_value + (WRITE_LOCK_BIT_MASK << WRITE_LOCK_BIT_OFFSET);
+                        add_lock_holder(lmeta->lock_ts, 0, true);
+                        new_value = old_value + (1ull << READ_LOCK_BIT_OFFSET);
                         lmeta->tid = new_value;
                         success = true;
                 } else {
@@ -734,14 +801,15 @@ out_unlock_lmeta:
                         tid = remove_lock_bit(old_value);
 
                         // can we get the lock?
-                        if (smeta->get_reader_count() > 0 || smeta->is_write_locked()) {
+                        if (smeta->is_write_locked() || smeta->get_reader_count() == smeta->get_reader_count_max()) {
                                 success = false;
                                 smeta->unlock();
                                 goto out_unlock_lmeta;
                         }
 
                         // OK, we can get the lock
-                        smeta->set_write_locked();
+                        add_lock_holder(scc_data->lock_ts, 0, true);
+                        smeta->increase_reader_count();
                         success = true;
 
                         smeta->unlock();
@@ -752,17 +820,113 @@ out_unlock_lmeta:
 		return tid;
 	}
 
-        uint64_t take_write_lock_and_read(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, bool &success, std::atomic<uint64_t> &local_cxl_access)
+        uint64_t try_take_read_lock_and_read(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, bool &success, std::atomic<uint64_t> &local_cxl_access,
+                                              uint64_t lock_ts, bool &wait, TwoPLPashaWaiter &waiter)
+	{
+                return latch_and_read(row, dest, size, success, local_cxl_access,
+                                      [&](TwoPLPashaMetadataLocal *lmeta, TwoPLPashaMetadataShared *smeta, TwoPLPashaSharedDataSCC *scc_data, uint64_t old_value) {
+                                              if (smeta == nullptr) {
+                                                      // can we get the lock? readers do not join the holders while an older writer is waiting
+                                                      if (is_write_locked(old_value) || read_lock_num(old_value) == read_lock_max() ||
+                                                          (other_waiters(lmeta, waiter) > 0 && read_lock_num(old_value) > 0)) {
+                                                              wait = wait_die(lock_ts, lmeta->lock_ts);
+                                                              if (wait == true) {
+                                                                      register_waiter(lmeta, waiter);
+                                                              }
+                                                              return false;
+                                                      }
+
+                                                      // OK, we can get the lock
+                                                      add_lock_holder(lmeta->lock_ts, lock_ts, read_lock_num(old_value) == 0);
+                                                      lmeta->tid = old_value + (1ull << READ_LOCK_BIT_OFFSET);
+                                                      return true;
+                                              }
+                                              return take_shared_read_lock(smeta, scc_data, lock_ts, wait, waiter);
+                                      });
+	}
+
+        uint64_t try_remote_take_read_lock_and_read(char *row, void *dest, std::size_t size, bool inc_ref_cnt, bool &success, uint64_t lock_ts, bool &wait, TwoPLPashaWaiter &waiter)
+	{
+                return remote_latch_and_read(row, dest, size, success, [&](TwoPLPashaMetadataShared *smeta, TwoPLPashaSharedDataSCC *scc_data) {
+                        if (take_shared_read_lock(smeta, scc_data, lock_ts, wait, waiter) == false) {
+                                return false;
+                        }
+
+                        // increase reference counting only if we get the lock
+                        if (inc_ref_cnt == true) {
+                                scc_data->ref_cnt++;
+                        }
+                        return true;
+                });
+	}
+
+        bool take_shared_read_lock(TwoPLPashaMetadataShared *smeta, TwoPLPashaSharedDataSCC *scc_data, uint64_t lock_ts, bool &wait, TwoPLPashaWaiter &waiter)
+        {
+                // can we get the lock? readers do not join the holders while an older writer is waiting
+                if (smeta->is_write_locked() || smeta->get_reader_count() == smeta->get_reader_count_max() ||
+                    (other_waiters(smeta, waiter) > 0 && smeta->get_reader_count() > 0)) {
+                        wait = wait_die(lock_ts, scc_data->lock_ts);
+                        if (wait == true) {
+                                register_waiter(smeta, waiter);
+                        }
+                        return false;
+                }
+
+                // OK, we can get the lock
+                add_lock_holder(scc_data->lock_ts, lock_ts, smeta->get_reader_count() == 0);
+                smeta->increase_reader_count();
+                return true;
+        }
+
+        uint64_t remote_read_lock_and_inc_ref_cnt(char *row, uint64_t size, bool &success)
+	{
+		TwoPLPashaMetadataShared *smeta = reinterpret_cast<TwoPLPashaMetadataShared *>(row);
+                TwoPLPashaSharedDataSCC *scc_data = smeta->get_scc_data();
+                uint64_t old_value = 0, new_value = 0;
+                uint64_t tid = 0;
+
+		smeta->lock();
+
+                // SCC prepare read
+                scc_manager->prepare_read(smeta, coordinator_id, scc_data, sizeof(TwoPLPashaSharedDataSCC) + size);
+
+                if (scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index) == false) {
+                        success = false;
+                        smeta->unlock();
+                        return remove_lock_bit(old_value);
+                }
+
+                old_value = scc_data->tid;
+                tid = remove_lock_bit(old_value);
+
+                // can we get the lock?
+                if (smeta->is_write_locked() || smeta->get_reader_count() == smeta->get_reader_count_max()) {
+                        success = false;
+                        smeta->unlock();
+                        return tid;
+                }
+
+                // OK, we can get the lock
+                add_lock_holder(scc_data->lock_ts, 0, true);
+                smeta->increase_reader_count();
+                success = true;
+
+                // increase reference counting only if we get the lock
+                scc_data->ref_cnt++;
+
+                smeta->unlock();
+
+		return tid;
+	}
+
+	uint64_t write_lock(std::atomic<uint64_t> &meta, uint64_t size, bool &success)
 	{
-                MetaDataType &meta = *std::get<0>(row);
                 TwoPLPashaMetadataLocal *lmeta = reinterpret_cast<TwoPLPashaMetadataLocal *>(meta.load());
                 uint64_t old_value = 0, new_value = 0;
                 uint64_t tid = 0;
 
                 lmeta->lock();
                 if (lmeta->is_migrated == false) {
-                        void *src = std::get<1>(row);
-
                         if (lmeta->is_valid == false) {
                                 success = false;
                                 goto out_unlock_lmeta;
@@ -778,57 +942,28 @@ out_unlock_lmeta:
                         }
 
                         // OK, we can get the lock
+                        add_lock_holder(lmeta->lock_ts, 0, true);
                         new_value = old_value + (WRITE_LOCK_BIT_MASK << WRITE_LOCK_BIT_OFFSET);
                         lmeta->tid = new_value;
                         success = true;
-
-                        // read the data
-                        std::memcpy(dest, src, size);
                 } else {
                         TwoPLPashaMetadataShared *smeta = reinterpret_cast<TwoPLPashaMetadataShared *>(lmeta->migrated_row);
                         TwoPLPashaSharedDataSCC *scc_data = smeta->get_scc_data();
-                        void *src = nullptr;
 
                         smeta->lock();
 
                         // SCC prepare read
                         scc_manager->prepare_read(smeta, coordinator_id, scc_data, sizeof(TwoPLPashaSharedDataSCC) + size);
 
-                        if (smeta->is_data_modified_since_moved_in() == true) {
-                                // statistics
-                                local_cxl_access.fetch_add(1);
-
-                                if (scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index) == false) {
-                                        smeta->unlock();
-                                        success = false;
-                                        goto out_unlock_lmeta;
-                                }
-
-                                old_value = scc_data->tid;
-                                tid = remove_lock_bit(old_value);
-
-                                // we update our local cache
-                                lmeta->is_valid = scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index);
-                                lmeta->tid = scc_data->tid;
-                                scc_manager->do_read(nullptr, coordinator_id, std::get<1>(row), scc_data->data, size);
-
-                                // unset the flag
-                                smeta->clear_is_data_modified_since_moved_in();
-
-                                src = std::get<1>(row);
-                        } else {
-                                if (lmeta->is_valid == false) {
-                                        smeta->unlock();
-                                        success = false;
-                                        goto out_unlock_lmeta;
-                                }
-
-                                old_value = lmeta->tid;
-                                tid = remove_lock_bit(old_value);
-
-                                src = std::get<1>(row);
+                        if (scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index) == false) {
+                                smeta->unlock();
+                                success = false;
+                                goto out_unlock_lmeta;
                         }
 
+                        old_value = scc_data->tid;
+                        tid = remove_lock_bit(old_value);
+
                         // can we get the lock?
                         if (smeta->get_reader_count() > 0 || smeta->is_write_locked()) {
                                 success = false;
@@ -837,12 +972,10 @@ out_unlock_lmeta:
                         }
 
                         // OK, we can get the lock
+                        add_lock_holder(scc_data->lock_ts, 0, true);
                         smeta->set_write_locked();
                         success = true;
 
-                        // read the data from the local copy
-                        memcpy(dest, src, size);
-
                         smeta->unlock();
                 }
 
@@ -851,51 +984,61 @@ out_unlock_lmeta:
 		return tid;
 	}
 
-        uint64_t remote_take_write_lock_and_read(char *row, void *dest, std::size_t size, bool inc_ref_cnt, bool &success)
+        uint64_t try_take_write_lock_and_read(const std::tuple<MetaDataType *, void *> &row, void *dest, std::size_t size, bool &success, std::atomic<uint64_t> &local_cxl_access,
+                                               uint64_t lock_ts, bool &wait, TwoPLPashaWaiter &waiter)
 	{
-		TwoPLPashaMetadataShared *smeta = reinterpret_cast<TwoPLPashaMetadataShared *>(row);
-                TwoPLPashaSharedDataSCC *scc_data = smeta->get_scc_data();
-                void *src = scc_data->data;
-                uint64_t old_value = 0, new_value = 0;
-                uint64_t tid = 0;
-
-		smeta->lock();
-
-                // SCC prepare read
-                scc_manager->prepare_read(smeta, coordinator_id, scc_data, sizeof(TwoPLPashaSharedDataSCC) + size);
+                return latch_and_read(row, dest, size, success, local_cxl_access,
+                                      [&](TwoPLPashaMetadataLocal *lmeta, TwoPLPashaMetadataShared *smeta, TwoPLPashaSharedDataSCC *scc_data, uint64_t old_value) {
+                                              if (smeta == nullptr) {
+                                                      // can we get the lock?
+                                                      if (is_read_locked(old_value) || is_write_locked(old_value)) {
+                                                              wait = wait_die(lock_ts, lmeta->lock_ts);
+                                                              if (wait == true) {
+                                                                      register_waiter(lmeta, waiter);
+                                                              }
+                                                              return false;
+                                                      }
+
+                                                      // OK, we can get the lock
+                                                      add_lock_holder(lmeta->lock_ts, lock_ts, true);
+                                                      lmeta->tid = old_value + (WRITE_LOCK_BIT_MASK << WRITE_LOCK_BIT_OFFSET);
+                                                      return true;
+                                              }
+                                              return take_shared_write_lock(smeta, scc_data, lock_ts, wait, waiter);
+                                      });
+	}
 
-                if (scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index) == false) {
-                        success = false;
-                        smeta->unlock();
-                        return remove_lock_bit(old_value);
-                }
+        uint64_t try_remote_take_write_lock_and_read(char *row, void *dest, std::size_t size, bool inc_ref_cnt, bool &success, uint64_t lock_ts, bool &wait, TwoPLPashaWaiter &waiter)
+	{
+                return remote_latch_and_read(row, dest, size, success, [&](TwoPLPashaMetadataShared *smeta, TwoPLPashaSharedDataSCC *scc_data) {
+                        if (take_shared_write_lock(smeta, scc_data, lock_ts, wait, waiter) == false) {
+                                return false;
+                        }
 
-                old_value = scc_data->tid;
-                tid = remove_lock_bit(old_value);
+                        // increase reference counting only if we get the lock
+                        if (inc_ref_cnt == true) {
+                                scc_data->ref_cnt++;
+                        }
+                        return true;
+                });
+	}
 
+        bool take_shared_write_lock(TwoPLPashaMetadataShared *smeta, TwoPLPashaSharedDataSCC *scc_data, uint64_t lock_ts, bool &wait, TwoPLPashaWaiter &waiter)
+        {
                 // can we get the lock?
                 if (smeta->get_reader_count() > 0 || smeta->is_write_locked()) {
-                        success = false;
-                        smeta->unlock();
-                        return tid;
+                        wait = wait_die(lock_ts, scc_data->lock_ts);
+                        if (wait == true) {
+                                register_waiter(smeta, waiter);
+                        }
+                        return false;
                 }
 
                 // OK, we can get the lock
+                add_lock_holder(scc_data->lock_ts, lock_ts, true);
                 smeta->set_write_locked();
-                success = true;
-
-                // read the data
-                scc_manager->do_read(nullptr, coordinator_id, dest, src, size);
-
-                // increase reference counting only if we get the lock
-                if (inc_ref_cnt == true) {
-                        scc_data->ref_cnt++;
-                }
-
-                smeta->unlock();
-
-		return tid;
-	}
+                return true;
+        }
 
         uint64_t remote_write_lock_and_inc_ref_cnt(char *row, uint64_t size, bool &success)
 	{
@@ -926,6 +1069,7 @@ out_unlock_lmeta:
                 }
 
                 // OK, we can get the lock
+                add_lock_holder(scc_data->lock_ts, 0, true);
                 smeta->set_write_locked();
                 success = true;
 
@@ -1105,6 +1249,52 @@ out_unlock_lmeta:
                 smeta->unlock();
         }
 
+        static void prefetch_range(const void *addr, std::size_t size)
+        {
+                for (std::size_t offset = 0; offset < size; offset += 64) {
+                        __builtin_prefetch(reinterpret_cast<const char *>(addr) + offset, 1);
+                }
+        }
+
+        // looks up rows of a remote partition in the CXL index together and prefetches their CXL metadata;
+        // the rows found (nullptr if not in CXL) are returned so that locking them does not search the index again
+        void prefetch_migrated_rows(std::size_t table_id, std::size_t partition_id, const void *const *keys, char **migrated_rows, std::size_t n)
+        {
+                static constexpr std::size_t batch_size = 16;
+                CXLTableBase *target_cxl_table = cxl_tbl_vecs[table_id][partition_id];
+
+                for (std::size_t i = 0; i < n; i += batch_size) {
+                        std::size_t cur_batch_size = std::min(n - i, batch_size);
+                        target_cxl_table->search_batch(keys + i, reinterpret_cast<void **>(migrated_rows + i), cur_batch_size);
+                        for (std::size_t j = i; j < i + cur_batch_size; j++) {
+                                if (migrated_rows[j] != nullptr) {
+                                        __builtin_prefetch(migrated_rows[j], 1);
+                                }
+                        }
+                }
+        }
+
+        // staged prefetching of a row moved into CXL: stage 1 prefetches its CXL metadata (the lock word),
+        // stage 2 its SCC data, both through pointers loaded by the previous stage
+        // the local metadata is read without its latch, which is fine for a prefetch hint
+        // returns true if the row has a next stage
+        bool prefetch_row(const std::tuple<MetaDataType *, void *> &row, int stage, std::size_t size)
+        {
+                TwoPLPashaMetadataLocal *lmeta = reinterpret_cast<TwoPLPashaMetadataLocal *>(std::get<0>(row)->load(std::memory_order_relaxed));
+                if (lmeta->is_migrated == false || lmeta->migrated_row == nullptr) {
+                        return false;
+                }
+
+                TwoPLPashaMetadataShared *smeta = reinterpret_cast<TwoPLPashaMetadataShared *>(lmeta->migrated_row);
+                if (stage == 1) {
+                        __builtin_prefetch(smeta, 1);
+                        return true;
+                }
+
+                prefetch_range(smeta->get_scc_data(), sizeof(TwoPLPashaSharedDataSCC) + size);
+                return false;
+        }
+
 	static uint64_t remove_lock_bit(uint64_t value)
 	{
 		return value & ~(LOCK_BIT_MASK << LOCK_BIT_OFFSET);
@@ -1155,7 +1345,12 @@ out_unlock_lmeta:
         char *get_migrated_row(std::size_t table_id, std::size_t partition_id, const void *key, bool inc_ref_cnt)
         {
                 CXLTableBase *target_cxl_table = cxl_tbl_vecs[table_id][partition_id];
-                char *migrated_row = reinterpret_cast<char *>(target_cxl_table->search(key));
+                return pin_migrated_row(partition_id, reinterpret_cast<char *>(target_cxl_table->search(key)), inc_ref_cnt);
+        }
+
+        // a row found in the CXL index is only usable while it is valid; returns nullptr if it has been moved out since
+        char *pin_migrated_row(std::size_t partition_id, char *migrated_row, bool inc_ref_cnt)
+        {
                 void *migration_policy_meta = nullptr;
 
                 if (migrated_row != nullptr) {
@@ -1267,6 +1462,7 @@ out_unlock_lmeta:
                                 scc_data->clear_flag(TwoPLPashaSharedDataSCC::valid_flag_index);
                         }
                         scc_data->tid = lmeta->tid;
+                        scc_data->lock_ts = lmeta->lock_ts;
                         smeta->set_reader_count(read_lock_num(lmeta->tid));
                         if (is_write_locked(lmeta->tid) == true) {
                                 smeta->set_write_locked();
@@ -1404,6 +1600,7 @@ out_unlock_lmeta:
                                         cur_scc_data->clear_flag(TwoPLPashaSharedDataSCC::valid_flag_index);
                                 }
                                 cur_scc_data->tid = cur_lmeta->tid;
+                                cur_scc_data->lock_ts = cur_lmeta->lock_ts;
                                 cur_smeta->set_reader_count(read_lock_num(cur_lmeta->tid));
                                 if (is_write_locked(cur_lmeta->tid) == true) {
                                         cur_smeta->set_write_locked();
@@ -1582,6 +1779,7 @@ out_unlock_lmeta:
                         // copy metadata back
                         lmeta->is_valid = scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index);
                         lmeta->tid = scc_data->tid;
+                        lmeta->lock_ts = scc_data->lock_ts;
                         set_read_lock_num(lmeta->tid, smeta->get_reader_count());
                         if (smeta->is_write_locked() == true) {
                                 set_write_lock_bit(lmeta->tid);
@@ -1688,6 +1886,7 @@ out_unlock_lmeta:
                                 // copy metadata back
                                 cur_lmeta->is_valid = cur_scc_data->get_flag(TwoPLPashaSharedDataSCC::valid_flag_index);
                                 cur_lmeta->tid = cur_scc_data->tid;
+                                cur_lmeta->lock_ts = cur_scc_data->lock_ts;
                                 set_read_lock_num(cur_lmeta->tid, cur_smeta->get_reader_count());
                                 if (cur_smeta->is_write_locked() == true) {
                                         set_write_lock_bit(cur_lmeta->tid);
@@ -1968,10 +2167,108 @@ out_unlock_lmeta:
 	static constexpr uint64_t WRITE_LOCK_BIT_MASK = 0x1ull;
 
     private:
+        // wait-die: on a conflict, a transaction may only wait if it is older than every lock holder, otherwise it dies (aborts)
+        // holders_ts is a lower bound of the holders' timestamps, a holder without a timestamp (0) makes everybody die
+        bool wait_die(uint64_t lock_ts, uint64_t holders_ts) const
+        {
+                return lock_wait_die == true && lock_ts != 0 && lock_ts < holders_ts;
+        }
+
+        static void add_lock_holder(uint64_t &holders_ts, uint64_t lock_ts, bool is_first_holder)
+        {
+                holders_ts = is_first_holder ? lock_ts : std::min(holders_ts, lock_ts);
+        }
+
+        // a waiter is counted on the row until it gets the lock or gives up, so that readers do not join the holders ahead of it
+        static void register_waiter(TwoPLPashaMetadataLocal *lmeta, TwoPLPashaWaiter &waiter)
+        {
+                if (waiter.is_registered() == false) {
+                        lmeta->n_waiters++;
+                        waiter.lmeta = lmeta;
+                }
+        }
+
+        static void register_waiter(TwoPLPashaMetadataShared *smeta, TwoPLPashaWaiter &waiter)
+        {
+                // a saturated count only means this waiter does not hold readers back
+                if (waiter.is_registered() == false && smeta->get_waiter_count() < smeta->get_waiter_count_max()) {
+                        smeta->increase_waiter_count();
+                        waiter.smeta = smeta;
+                }
+        }
+
+        // waiters other than the caller itself
+        static uint64_t other_waiters(TwoPLPashaMetadataLocal *lmeta, const TwoPLPashaWaiter &waiter)
+        {
+                return lmeta->n_waiters - (waiter.is_counted_on(lmeta) ? 1 : 0);
+        }
+
+        static uint64_t other_waiters(TwoPLPashaMetadataShared *smeta, const TwoPLPashaWaiter &waiter)
+        {
+                return smeta->get_waiter_count() - (waiter.is_counted_on(smeta) ? 1 : 0);
+        }
+
+        static void withdraw_waiter(TwoPLPashaWaiter &waiter)
+        {
+                if (waiter.lmeta != nullptr) {
+                        waiter.lmeta->lock();
+                        DCHECK(waiter.lmeta->n_waiters > 0);
+                        waiter.lmeta->n_waiters--;
+                        waiter.lmeta->unlock();
+                } else if (waiter.smeta != nullptr) {
+                        waiter.smeta->lock();
+                        DCHECK(waiter.smeta->get_waiter_count() > 0);
+                        waiter.smeta->decrease_waiter_count();
+                        waiter.smeta->unlock();
+                }
+                waiter = TwoPLPashaWaiter();
+        }
+
+        // a request served meanwhile may wait for a lock itself, it does not poll again
+        static void poll_while_waiting()
+        {
+                static thread_local bool polling = false;
+                std::function<void()> &poller = lock_wait_poller();
+
+                if (poller && polling == false) {
+                        polling = true;
+                        poller();
+                        polling = false;
+                }
+        }
+
+        template <class TryLockFunc> uint64_t lock_or_wait(bool &success, TryLockFunc try_lock)
+        {
+                TwoPLPashaWaiter waiter;
+                bool wait = false;
+                uint64_t tid = try_lock(wait, waiter);
+
+                // the lock is retried without holding any latch, so the holders can release it in the meantime
+                // and the worker serves the requests sent to it, e.g., on its CXL lane
+                for (uint64_t i = 0; success == false && wait == true && i < context.lock_wait_spins; i++) {
+                        for (int j = 0; j < lock_wait_pauses; j++) {
+                                _mm_pause();
+                        }
+                        poll_while_waiting();
+                        wait = false;
+                        tid = try_lock(wait, waiter);
+                }
+
+                // the waiter leaves the count once it holds the lock, dies or runs out of spins
+                if (waiter.is_registered() == true) {
+                        withdraw_waiter(waiter);
+                }
+                return tid;
+        }
+
+        static constexpr int lock_wait_pauses = 32;
+
         std::size_t coordinator_id;
 
         Context context;
 
+        bool lock_wait_die = false;
+
         std::vector<std::vector<CXLTableBase *> > &cxl_tbl_vecs;
 
         std::atomic<uint64_t> init_finished;
@@ -248,9 +248,9 @@ class TwoPLPashaMessageHandler {
                 } else {
                         // perform execution phase operations
                         if (readKey.get_write_lock_request_bit()) {
-                                tid = twopl_pasha_global_helper->remote_take_write_lock_and_read(migrated_row, readKey.get_value(), value_size, true, success);
+                                tid = twopl_pasha_global_helper->remote_take_write_lock_and_read(migrated_row, readKey.get_value(), value_size, true, success, txn->lock_ts);
                         } else {
-                                tid = twopl_pasha_global_helper->remote_take_read_lock_and_read(migrated_row, readKey.get_value(), value_size, true, success);
+                                tid = twopl_pasha_global_helper->remote_take_read_lock_and_read(migrated_row, readKey.get_value(), value_size, true, success, txn->lock_ts);
                         }
 
                         if (success) {
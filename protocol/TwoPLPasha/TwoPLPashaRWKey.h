@@ -56,6 +56,24 @@ class TwoPLPashaRWKey {
 		return (bitvec >> READ_LOCK_BIT_OFFSET) & READ_LOCK_BIT_MASK;
 	}
 
+	// optimistic read bit
+
+	void set_optimistic_read_bit()
+	{
+		clear_optimistic_read_bit();
+		bitvec |= OPTIMISTIC_READ_BIT_MASK << OPTIMISTIC_READ_BIT_OFFSET;
+	}
+
+	void clear_optimistic_read_bit()
+	{
+		bitvec &= ~(OPTIMISTIC_READ_BIT_MASK << OPTIMISTIC_READ_BIT_OFFSET);
+	}
+
+	uint64_t get_optimistic_read_bit() const
+	{
+		return (bitvec >> OPTIMISTIC_READ_BIT_OFFSET) & OPTIMISTIC_READ_BIT_MASK;
+	}
+
 	// write lock bit
 
 	void set_write_lock_bit()
@@ -285,6 +303,17 @@ class TwoPLPashaRWKey {
                 this->processed = true;
 	}
 
+        // lock requested ahead of the other keys by the prefetch stage
+        bool get_lock_requested() const
+	{
+                return this->lock_requested;
+	}
+
+        void set_lock_requested()
+	{
+                this->lock_requested = true;
+	}
+
         // reference counting
         bool get_reference_counted()
 	{
@@ -333,7 +362,7 @@ class TwoPLPashaRWKey {
 	/*
 	 * A bitvec is a 64-bit word.
 	 *
-	 * [ table id (5) ] | partition id (32) | unused bit (14) |
+	 * [ table id (5) ] | partition id (32) | unused bit (13) | optimistic read bit (1) |
 	 *   write lock request bit (1) | read lock request bit (1)
 	 *   write lock bit(1) | read lock bit (1) | local index read (1)  ]
 	 *
@@ -343,6 +372,7 @@ class TwoPLPashaRWKey {
 	 * read lock bit is set when a read lock is acquired.
 	 * write lock request bit is set when a write lock request is needed.
 	 * read lock request bit is set when a read lock request is needed.
+	 * optimistic read bit is set when the row is read without a read lock and validated at commit.
 	 *
 	 */
 	const void *key = nullptr;
@@ -368,6 +398,8 @@ class TwoPLPashaRWKey {
 
         bool processed = false;
 
+        bool lock_requested = false;
+
         // for remote insert
         char *inserted_cxl_row = nullptr;
 
@@ -385,6 +417,9 @@ class TwoPLPashaRWKey {
 	static constexpr uint64_t PARTITION_ID_MASK = 0xfffff;
 	static constexpr uint64_t PARTITION_ID_OFFSET = 19;
 
+	static constexpr uint64_t OPTIMISTIC_READ_BIT_MASK = 0x1;
+	static constexpr uint64_t OPTIMISTIC_READ_BIT_OFFSET = 5;
+
 	static constexpr uint64_t WRITE_LOCK_REQUEST_BIT_MASK = 0x1;
 	static constexpr uint64_t WRITE_LOCK_REQUEST_BIT_OFFSET = 4;
 
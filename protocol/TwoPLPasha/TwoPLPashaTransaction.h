@@ -11,6 +11,7 @@
 #include "core/Partitioner.h"
 #include "core/Table.h"
 #include "protocol/TwoPLPasha/TwoPLPashaRWKey.h"
+#include <algorithm>
 #include <chrono>
 #include <glog/logging.h>
 #include <vector>
@@ -167,6 +168,29 @@ class TwoPLPashaTransaction {
 		return get_table(tableId, partitionId);
 	}
 
+	// re-initialize a pooled transaction object for a new query
+	// read/write sets are cleared but keep their capacity
+	void reinit(std::size_t partition_id)
+	{
+		this->partition_id = partition_id;
+		startTime = std::chrono::steady_clock::now();
+		commit_unlock_time_us = 0;
+		commit_work_time_us = 0;
+		commit_write_back_time_us = 0;
+		remote_work_time_us = 0;
+		local_work_time_us = 0;
+		stall_time_us = 0;
+		commit_prepare_time_us = 0;
+		commit_persistence_time_us = 0;
+		commit_replication_time_us = 0;
+		txn_random_seed_start = 0;
+		transaction_id = 0;
+		lock_ts = 0;
+		straggler_wait_time = 0;
+		remote_hosts_involved.clear();
+		reset();
+	}
+
 	void reset()
 	{
 		pendingResponses = 0;
@@ -179,6 +203,7 @@ class TwoPLPashaTransaction {
 		si_in_serializable = false;
 		distributed_transaction = false;
 		execution_phase = true;
+		write_requested = false;
 		operation.clear();
 		readSet.clear();
 		writeSet.clear();
@@ -240,6 +265,7 @@ class TwoPLPashaTransaction {
 		readKey.set_value(&value);
 
 		readKey.set_write_lock_request_bit();
+		write_requested = true;
 
 		add_to_read_set(readKey);
 	}
@@ -283,6 +309,7 @@ class TwoPLPashaTransaction {
 		scanKey.set_partition_id(partition_id);
 
                 scanKey.set_scan_args(&min_key, &max_key, limit, results, TwoPLPashaRWKey::SCAN_FOR_UPDATE);
+		write_requested = true;
 
 		add_to_scan_set(scanKey);
 	}
@@ -297,6 +324,7 @@ class TwoPLPashaTransaction {
 		scanKey.set_partition_id(partition_id);
 
                 scanKey.set_scan_args(&min_key, &max_key, limit, results, TwoPLPashaRWKey::SCAN_FOR_INSERT);
+		write_requested = true;
 
 		add_to_scan_set(scanKey);
 	}
@@ -311,6 +339,7 @@ class TwoPLPashaTransaction {
 		scanKey.set_partition_id(partition_id);
 
                 scanKey.set_scan_args(&min_key, &max_key, limit, results, TwoPLPashaRWKey::SCAN_FOR_DELETE);
+		write_requested = true;
 
 		add_to_scan_set(scanKey);
 	}
@@ -333,6 +362,7 @@ class TwoPLPashaTransaction {
 
                 if (require_lock_next_key == true)
                         insertKey.set_require_lock_next_row();
+		write_requested = true;
 
 		add_to_insert_set(insertKey);
 	}
@@ -346,49 +376,148 @@ class TwoPLPashaTransaction {
 		deleteKey.set_partition_id(partition_id);
 
                 deleteKey.set_key(&key);
+		write_requested = true;
 
 		add_to_delete_set(deleteKey);
 	}
 
-	bool process_requests(std::size_t worker_id, bool last_call_in_transaction = true)
-	{
-		bool ret = false;
-		ScopedTimer t_local_work([&, this](uint64_t us) { this->record_local_work_time(us); });
+	// returns false if the lock of a local or migrated row cannot be taken
+	template <class LockRequestFunc> bool process_read_request(int i, LockRequestFunc &lock_request)
+	{
+		const TwoPLPashaRWKey &readKey = readSet[i];
+		// rows found by the prefetch stage are passed in so that the handler does not search the index again
+		std::tuple<star::ITable::MetaDataType *, void *> cached_local_row = readSet[i].get_cached_local_row();
+		char *cached_migrated_row = readSet[i].get_cached_migrated_row();
+		bool success = false, remote = false;
+		auto tid = lock_request(readKey.get_table_id(), readKey.get_partition_id(), i, readKey.get_key(), readKey.get_value(),
+						readSet[i].get_local_index_read_bit(), readSet[i].get_write_lock_request_bit(), cached_local_row,
+						cached_migrated_row, success, remote);
+
+		if (!remote) {
+			readSet[i].set_cached_local_row(cached_local_row);
+			readSet[i].set_cached_migrated_row(cached_migrated_row);
+			if (success) {
+				readSet[i].set_tid(tid);
+				// rows read optimistically are validated at commit instead of being read-locked
+				if (readSet[i].get_read_lock_request_bit() && !readSet[i].get_local_index_read_bit() && !readSet[i].get_optimistic_read_bit()) {
+					readSet[i].set_read_lock_bit();
+				}
 
-		// processing read requests
+				if (readSet[i].get_write_lock_request_bit()) {
+					readSet[i].set_write_lock_bit();
+				}
+			} else {
+				return false;
+			}
+		} else {
+			// set by the data migration response
+			readSet[i].set_cached_migrated_row(nullptr);
+		}
+		return true;
+	}
+
+	// locks the read requests not processed yet; returns false if a lock cannot be taken
+	template <class LockRequestFunc> bool process_read_requests(LockRequestFunc &lock_request)
+	{
 		for (int i = int(readSet.size()) - 1; i >= 0; i--) {
 			// early return
 			if (readSet[i].get_processed() == true) {
 				break;
 			}
 
-			const TwoPLPashaRWKey &readKey = readSet[i];
-                        std::tuple<star::ITable::MetaDataType *, void *> cached_local_row;
-                        char *cached_migrated_row = nullptr;
-			bool success = false, remote = false;
-			auto tid = lock_request_handler(readKey.get_table_id(), readKey.get_partition_id(), i, readKey.get_key(), readKey.get_value(),
-							readSet[i].get_local_index_read_bit(), readSet[i].get_write_lock_request_bit(),
-                                                        cached_local_row, cached_migrated_row, success, remote);
-
-			if (!remote) {
-                                readSet[i].set_cached_local_row(cached_local_row);
-                                readSet[i].set_cached_migrated_row(cached_migrated_row);
-				if (success) {
-					readSet[i].set_tid(tid);
-					if (readSet[i].get_read_lock_request_bit() && !readSet[i].get_local_index_read_bit()) {
-						readSet[i].set_read_lock_bit();
+			if (readSet[i].get_lock_requested() == false && process_read_request(i, lock_request) == false) {
+				return false;
+			}
+			readSet[i].set_processed();
+		}
+		return true;
+	}
+
+	bool process_requests(std::size_t worker_id, bool last_call_in_transaction = true)
+	{
+		bool ret = false;
+		ScopedTimer t_local_work([&, this](uint64_t us) { this->record_local_work_time(us); });
+
+		// prefetch stage: rows owned by remote hosts are requested first and the requests are sent right away,
+		// so that the round trips overlap with locking the local rows, which are prefetched meanwhile
+		if (prefetch_request_handler) {
+			// the keys of a table partition are looked up together, so their index traversals overlap
+			prefetch_indices.clear();
+			for (int i = int(readSet.size()) - 1; i >= 0; i--) {
+				if (readSet[i].get_processed() == true) {
+					break;
+				}
+				if (readSet[i].get_local_index_read_bit()) {
+					continue;
+				}
+				prefetch_indices.push_back(i);
+			}
+			std::stable_sort(prefetch_indices.begin(), prefetch_indices.end(), [this](int a, int b) {
+				return std::make_pair(readSet[a].get_table_id(), readSet[a].get_partition_id()) <
+				       std::make_pair(readSet[b].get_table_id(), readSet[b].get_partition_id());
+			});
+
+			for (std::size_t begin = 0, end = 0; begin < prefetch_indices.size(); begin = end) {
+				auto table_id = readSet[prefetch_indices[begin]].get_table_id();
+				auto partition_id = readSet[prefetch_indices[begin]].get_partition_id();
+				prefetch_keys.clear();
+				for (end = begin; end < prefetch_indices.size(); end++) {
+					auto &key = readSet[prefetch_indices[end]];
+					if (key.get_table_id() != table_id || key.get_partition_id() != partition_id) {
+						break;
 					}
+					prefetch_keys.push_back(key.get_key());
+				}
+				prefetch_rows.resize(prefetch_keys.size());
+				prefetch_migrated_rows.resize(prefetch_keys.size());
+
+				bool remote_partition = prefetch_request_handler(table_id, partition_id, prefetch_keys.data(), prefetch_rows.data(),
+										 prefetch_migrated_rows.data(), prefetch_keys.size());
+				for (auto j = begin; j < end; j++) {
+					int i = prefetch_indices[j];
+					if (remote_partition) {
+						readSet[i].set_cached_migrated_row(prefetch_migrated_rows[j - begin]);
+						readSet[i].set_lock_requested();
+						if (process_read_request(i, lock_request_handler) == false) {
+							abort_lock = true;
+							ret = true;
+							goto process_net_req_and_ret;
+						}
+					} else {
+						readSet[i].set_cached_local_row(prefetch_rows[j - begin]);
+					}
+				}
+			}
+			if (pendingResponses > 0) {
+				message_flusher();
+			}
 
-					if (readSet[i].get_write_lock_request_bit()) {
-						readSet[i].set_write_lock_bit();
+			// rows moved into CXL are reached through a chain of dependent loads (local metadata, CXL metadata, SCC data);
+			// each stage follows one link for every row, so the cache misses of all the rows overlap instead of
+			// being taken one row at a time by the locking pass
+			for (int stage = 1, more = 1; more > 0; stage++) {
+				more = 0;
+				for (int i = int(readSet.size()) - 1; i >= 0; i--) {
+					if (readSet[i].get_processed() == true) {
+						break;
+					}
+					if (readSet[i].get_local_index_read_bit() || readSet[i].get_lock_requested()) {
+						continue;
+					}
+					auto row = readSet[i].get_cached_local_row();
+					if (std::get<0>(row) != nullptr &&
+					    row_prefetch_handler(readSet[i].get_table_id(), readSet[i].get_partition_id(), row, stage)) {
+						more++;
 					}
-				} else {
-					abort_lock = true;
-                                        ret = true;
-                                        goto process_net_req_and_ret;
 				}
 			}
-			readSet[i].set_processed();
+		}
+
+		// processing read requests
+		if ((read_requests_handler ? read_requests_handler() : process_read_requests(lock_request_handler)) == false) {
+			abort_lock = true;
+			ret = true;
+			goto process_net_req_and_ret;
 		}
 
                 // processing scan requests
@@ -526,10 +655,20 @@ process_net_req_and_ret:
 	bool abort_lock, abort_read_validation, abort_insert, abort_delete, local_validated, si_in_serializable;
 	bool distributed_transaction;
 	bool execution_phase;
+	bool write_requested; // any write, insert, delete or locking scan issued so far
 
 	// table id, partition id, key, value, local_index_read?, write_lock?,
 	// success?, remote?
 	std::function<uint64_t(std::size_t, std::size_t, uint32_t, const void *, void *, bool, bool, std::tuple<star::ITable::MetaDataType *, void *> &, char *&, bool &, bool &)> lock_request_handler;
+	// locks all the pending read requests with a lookup and lock path typed on the concrete table,
+	// so that there is one indirect call per batch instead of per row; unset if the workload has no typed tables
+	std::function<bool()> read_requests_handler;
+	// table id, partition id, keys, rows (output), rows moved into CXL (output), number of keys,
+	// returns true if the partition is owned by a remote host; unset if prefetching is disabled
+	std::function<bool(std::size_t, std::size_t, const void *const *, std::tuple<star::ITable::MetaDataType *, void *> *, char **, std::size_t)>
+		prefetch_request_handler;
+	// table id, partition id, row, stage, returns true if the row has a next prefetch stage
+	std::function<bool(std::size_t, std::size_t, const std::tuple<star::ITable::MetaDataType *, void *> &, int)> row_prefetch_handler;
         // table id, partition id, key_offset, min_key, max_key, results
 	std::function<bool(std::size_t, std::size_t, uint32_t, const void *, const void *, uint64_t, int, void *, ITable::row_entity &, bool &)> scanRequestHandler;
         // table id, partition id, key_offset, key, value
@@ -547,10 +686,17 @@ process_net_req_and_ret:
 	std::size_t ith_replica;
 	Operation operation;
 	std::vector<TwoPLPashaRWKey> readSet, writeSet, scanSet, insertSet, deleteSet;
+	// scratch space of the prefetch stage
+	std::vector<int> prefetch_indices;
+	std::vector<const void *> prefetch_keys;
+	std::vector<std::tuple<star::ITable::MetaDataType *, void *> > prefetch_rows;
+	std::vector<char *> prefetch_migrated_rows;
 	WALLogger *logger = nullptr;
 	uint64_t txn_random_seed_start = 0;
 	uint64_t transaction_id = 0;
+	uint64_t lock_ts = 0; // wait-die timestamp, kept across retries
 	uint64_t straggler_wait_time = 0;
+	int32_t pool_slot = -1; // TransactionPool free list this object returns to, -1 if not pooled
 
         std::unordered_set<std::size_t> remote_hosts_involved;
 };
@@ -13,7 +13,7 @@ def get_row(input):
         # tput, CXL_usage_index, CXL_usage_data, CXL_usage_transport
         for line in fileinput.FileInput(input[1]):
                 tokens = line.strip().split()
-                if len(tokens) > 7 and tokens[3] == "Coordinator.h:610]":
+                if len(tokens) > 7 and tokens[3].startswith("Coordinator.h:") and tokens[4:6] == ["Global", "Stats:"]:
                         tputs.append(float(tokens[7]))
 
         return tputs
@@ -11,7 +11,7 @@ def get_row(input):
         # tput, CXL_usage_index, CXL_usage_data, CXL_usage_transport
         for line in fileinput.FileInput(input[1]):
                 tokens = line.strip().split()
-                if len(tokens) > 7 and tokens[3] == "Coordinator.h:610]":
+                if len(tokens) > 7 and tokens[3].startswith("Coordinator.h:") and tokens[4:6] == ["Global", "Stats:"]:
                         tputs.append(float(tokens[7]))
 
         return tputs
@@ -42,7 +42,7 @@ def get_latency_p50(input):
         # tput, CXL_usage_index, CXL_usage_data, CXL_usage_transport
         for line in fileinput.FileInput(input[1]):
                 tokens = line.strip().split()
-                if len(tokens) > 7 and tokens[3] == "WALLogger.h:539]":
+                if len(tokens) > 7 and tokens[3].startswith("WALLogger.h:") and tokens[4:7] == ["Group", "Commit", "Stats:"]:
                         lat_p50.append(float(tokens[7]))
 
         return lat_p50
@@ -54,7 +54,7 @@ def get_latency_p99(input):
         # tput, CXL_usage_index, CXL_usage_data, CXL_usage_transport
         for line in fileinput.FileInput(input[1]):
                 tokens = line.strip().split()
-                if len(tokens) > 7 and tokens[3] == "WALLogger.h:539]":
+                if len(tokens) > 7 and tokens[3].startswith("WALLogger.h:") and tokens[4:7] == ["Group", "Commit", "Stats:"]:
                         lat_p50.append(float(tokens[16]))
 
         return lat_p50
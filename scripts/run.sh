@@ -9,11 +9,11 @@ typeset current_date_time="`date +%Y%m%d%H%M`"
 source $SCRIPT_DIR/utilities.sh
 
 function print_usage {
-        echo "[usage] ./run.sh [TPCC/YCSB/KILL/COMPILE/COMPILE_SYNC/CI/COLLECT_OUTPUTS] EXP-SPECIFIC"
-        echo "TPCC: [SundialPasha/Sundial/TwoPLPasha/TwoPLPashaPhantom/TwoPL] HOST_NUM WORKER_NUM QUERY_TYPE REMOTE_NEWORDER_PERC REMOTE_PAYMENT_PERC USE_CXL_TRANS USE_OUTPUT_THREAD ENABLE_MIGRATION_OPTIMIZATION MIGRATION_POLICY WHEN_TO_MOVE_OUT HW_CC_BUDGET ENABLE_SCC SCC_MECH PRE_MIGRATE TIME_TO_RUN TIME_TO_WARMUP LOGGING_TYPE EPOCH_LEN MODEL_CXL_SEARCH GATHER_OUTPUTS"
-        echo "YCSB: [SundialPasha/Sundial/TwoPLPasha/TwoPLPashaPhantom/TwoPL] HOST_NUM WORKER_NUM QUERY_TYPE KEYS RW_RATIO ZIPF_THETA CROSS_RATIO USE_CXL_TRANS USE_OUTPUT_THREAD ENABLE_MIGRATION_OPTIMIZATION MIGRATION_POLICY WHEN_TO_MOVE_OUT HW_CC_BUDGET ENABLE_SCC SCC_MECH PRE_MIGRATE TIME_TO_RUN TIME_TO_WARMUP LOGGING_TYPE EPOCH_LEN MODEL_CXL_SEARCH GATHER_OUTPUTS"
-        echo "SmallBank: [SundialPasha/Sundial/TwoPLPasha/TwoPLPashaPhantom/TwoPL] HOST_NUM WORKER_NUM KEYS ZIPF_THETA CROSS_RATIO USE_CXL_TRANS USE_OUTPUT_THREAD ENABLE_MIGRATION_OPTIMIZATION MIGRATION_POLICY WHEN_TO_MOVE_OUT HW_CC_BUDGET ENABLE_SCC SCC_MECH PRE_MIGRATE TIME_TO_RUN TIME_TO_WARMUP LOGGING_TYPE EPOCH_LEN MODEL_CXL_SEARCH GATHER_OUTPUTS"
-        echo "TATP: [SundialPasha/Sundial/TwoPLPasha/TwoPLPashaPhantom/TwoPL] HOST_NUM WORKER_NUM KEYS CROSS_RATIO USE_CXL_TRANS USE_OUTPUT_THREAD ENABLE_MIGRATION_OPTIMIZATION MIGRATION_POLICY WHEN_TO_MOVE_OUT HW_CC_BUDGET ENABLE_SCC SCC_MECH PRE_MIGRATE TIME_TO_RUN TIME_TO_WARMUP LOGGING_TYPE EPOCH_LEN MODEL_CXL_SEARCH GATHER_OUTPUTS"
+        echo "[usage] ./run.sh [TPCC/YCSB/SmallBank/TATP/KILL/COMPILE/COMPILE_SYNC/CI/COLLECT_OUTPUTS] EXP-SPECIFIC"
+        echo "TPCC: [SundialPasha/SiloPasha/Sundial/TwoPLPasha/TwoPLPashaPhantom/TwoPL] HOST_NUM WORKER_NUM QUERY_TYPE REMOTE_NEWORDER_PERC REMOTE_PAYMENT_PERC USE_CXL_TRANS USE_OUTPUT_THREAD ENABLE_MIGRATION_OPTIMIZATION MIGRATION_POLICY WHEN_TO_MOVE_OUT HW_CC_BUDGET ENABLE_SCC SCC_MECH PRE_MIGRATE TIME_TO_RUN TIME_TO_WARMUP LOGGING_TYPE EPOCH_LEN MODEL_CXL_SEARCH GATHER_OUTPUTS"
+        echo "YCSB: [SundialPasha/SiloPasha/Sundial/TwoPLPasha/TwoPLPashaPhantom/TwoPL] HOST_NUM WORKER_NUM QUERY_TYPE KEYS RW_RATIO ZIPF_THETA CROSS_RATIO USE_CXL_TRANS USE_OUTPUT_THREAD ENABLE_MIGRATION_OPTIMIZATION MIGRATION_POLICY WHEN_TO_MOVE_OUT HW_CC_BUDGET ENABLE_SCC SCC_MECH PRE_MIGRATE TIME_TO_RUN TIME_TO_WARMUP LOGGING_TYPE EPOCH_LEN MODEL_CXL_SEARCH GATHER_OUTPUTS"
+        echo "SmallBank: [SundialPasha/SiloPasha/Sundial/TwoPLPasha/TwoPLPashaPhantom/TwoPL] HOST_NUM WORKER_NUM KEYS ZIPF_THETA CROSS_RATIO USE_CXL_TRANS USE_OUTPUT_THREAD ENABLE_MIGRATION_OPTIMIZATION MIGRATION_POLICY WHEN_TO_MOVE_OUT HW_CC_BUDGET ENABLE_SCC SCC_MECH PRE_MIGRATE TIME_TO_RUN TIME_TO_WARMUP LOGGING_TYPE EPOCH_LEN MODEL_CXL_SEARCH GATHER_OUTPUTS"
+        echo "TATP: [SundialPasha/SiloPasha/Sundial/TwoPLPasha/TwoPLPashaPhantom/TwoPL] HOST_NUM WORKER_NUM KEYS ZIPF_THETA CROSS_RATIO USE_CXL_TRANS USE_OUTPUT_THREAD ENABLE_MIGRATION_OPTIMIZATION MIGRATION_POLICY WHEN_TO_MOVE_OUT HW_CC_BUDGET ENABLE_SCC SCC_MECH PRE_MIGRATE TIME_TO_RUN TIME_TO_WARMUP LOGGING_TYPE EPOCH_LEN MODEL_CXL_SEARCH GATHER_OUTPUTS"
         echo "KILL: None"
         echo "COMPILE: None"
         echo "COMPILE_SYNC: HOST_NUM"
@@ -30,8 +30,8 @@ function kill_prev_exps {
         do
                 ssh_command "pkill bench_tpcc" $i
                 ssh_command "pkill bench_ycsb" $i
-                # ssh_command "pkill bench_smallbank" $i
-                # ssh_command "pkill bench_tatp" $i
+                ssh_command "pkill bench_smallbank" $i
+                ssh_command "pkill bench_tatp" $i
         done
 }
 
@@ -71,8 +71,8 @@ function sync_binaries {
         done
         sync_files $SCRIPT_DIR/../build/bench_tpcc /root/pasha/ $HOST_NUM
         sync_files $SCRIPT_DIR/../build/bench_ycsb /root/pasha/ $HOST_NUM
-        # sync_files $SCRIPT_DIR/../build/bench_smallbank /root/pasha/ $HOST_NUM
-        # sync_files $SCRIPT_DIR/../build/bench_tatp /root/pasha/ $HOST_NUM
+        sync_files $SCRIPT_DIR/../build/bench_smallbank /root/pasha/ $HOST_NUM
+        sync_files $SCRIPT_DIR/../build/bench_tatp /root/pasha/ $HOST_NUM
         exit -1
 }
 
@@ -132,7 +132,7 @@ function run_exp_tpcc {
         delete_log_files
         init_cxl_for_vms $HOST_NUM
 
-        if [ $PROTOCOL = "SundialPasha" ]; then
+        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "SiloPasha" ]; then
                 # launch 1-$HOST_NUM processes
                 for (( i=1; i < $HOST_NUM; ++i ))
                 do
@@ -145,7 +145,7 @@ function run_exp_tpcc {
                                 --enable_migration_optimization=$ENABLE_MIGRATION_OPTIMIZATION --migration_policy=$MIGRATION_POLICY --when_to_move_out=$WHEN_TO_MOVE_OUT --hw_cc_budget=$HW_CC_BUDGET
                                 --enable_scc=$ENABLE_SCC --scc_mechanism=$SCC_MECH
                                 --pre_migrate=$PRE_MIGRATE
-                                --protocol=SundialPasha --query=$QUERY_TYPE --neworder_dist=$REMOTE_NEWORDER_PERC --payment_dist=$REMOTE_PAYMENT_PERC &> output.txt < /dev/null &" $i
+                                --protocol=$PROTOCOL --query=$QUERY_TYPE --neworder_dist=$REMOTE_NEWORDER_PERC --payment_dist=$REMOTE_PAYMENT_PERC &> output.txt < /dev/null &" $i
                 done
 
                 # launch the first process
@@ -158,7 +158,7 @@ function run_exp_tpcc {
                         --enable_migration_optimization=$ENABLE_MIGRATION_OPTIMIZATION --migration_policy=$MIGRATION_POLICY --when_to_move_out=$WHEN_TO_MOVE_OUT --hw_cc_budget=$HW_CC_BUDGET
                         --enable_scc=$ENABLE_SCC --scc_mechanism=$SCC_MECH
                         --pre_migrate=$PRE_MIGRATE
-                        --protocol=SundialPasha --query=$QUERY_TYPE --neworder_dist=$REMOTE_NEWORDER_PERC --payment_dist=$REMOTE_PAYMENT_PERC" 0
+                        --protocol=$PROTOCOL --query=$QUERY_TYPE --neworder_dist=$REMOTE_NEWORDER_PERC --payment_dist=$REMOTE_PAYMENT_PERC" 0
 
         elif [ $PROTOCOL = "Sundial" ]; then
                 # launch 1-$HOST_NUM processes
@@ -312,7 +312,7 @@ function run_exp_ycsb {
         delete_log_files
         init_cxl_for_vms $HOST_NUM
 
-        if [ $PROTOCOL = "SundialPasha" ]; then
+        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "SiloPasha" ]; then
                 # launch 1-$HOST_NUM processes
                 for (( i=1; i < $HOST_NUM; ++i ))
                 do
@@ -325,7 +325,7 @@ function run_exp_ycsb {
                                 --enable_migration_optimization=$ENABLE_MIGRATION_OPTIMIZATION --migration_policy=$MIGRATION_POLICY --when_to_move_out=$WHEN_TO_MOVE_OUT --hw_cc_budget=$HW_CC_BUDGET
                                 --enable_scc=$ENABLE_SCC --scc_mechanism=$SCC_MECH
                                 --pre_migrate=$PRE_MIGRATE
-                                --protocol=SundialPasha --query=$QUERY_TYPE --keys=$KEYS --read_write_ratio=$RW_RATIO --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO --cross_part_num=2 &> output.txt < /dev/null &" $i
+                                --protocol=$PROTOCOL --query=$QUERY_TYPE --keys=$KEYS --read_write_ratio=$RW_RATIO --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO --cross_part_num=2 &> output.txt < /dev/null &" $i
                 done
 
                 # launch the first process
@@ -338,7 +338,7 @@ function run_exp_ycsb {
                         --enable_migration_optimization=$ENABLE_MIGRATION_OPTIMIZATION --migration_policy=$MIGRATION_POLICY --when_to_move_out=$WHEN_TO_MOVE_OUT --hw_cc_budget=$HW_CC_BUDGET
                         --enable_scc=$ENABLE_SCC --scc_mechanism=$SCC_MECH
                         --pre_migrate=$PRE_MIGRATE
-                        --protocol=SundialPasha --query=$QUERY_TYPE --keys=$KEYS --read_write_ratio=$RW_RATIO --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO --cross_part_num=2" 0
+                        --protocol=$PROTOCOL --query=$QUERY_TYPE --keys=$KEYS --read_write_ratio=$RW_RATIO --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO --cross_part_num=2" 0
 
         elif [ $PROTOCOL = "Sundial" ]; then
                 # launch 1-$HOST_NUM processes
@@ -490,7 +490,7 @@ function run_exp_smallbank {
         delete_log_files
         init_cxl_for_vms $HOST_NUM
 
-        if [ $PROTOCOL = "SundialPasha" ]; then
+        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "SiloPasha" ]; then
                 # launch 1-$HOST_NUM processes
                 for (( i=1; i < $HOST_NUM; ++i ))
                 do
@@ -503,7 +503,7 @@ function run_exp_smallbank {
                                 --enable_migration_optimization=$ENABLE_MIGRATION_OPTIMIZATION --migration_policy=$MIGRATION_POLICY --when_to_move_out=$WHEN_TO_MOVE_OUT --hw_cc_budget=$HW_CC_BUDGET
                                 --enable_scc=$ENABLE_SCC --scc_mechanism=$SCC_MECH
                                 --pre_migrate=$PRE_MIGRATE
-                                --protocol=SundialPasha --keys=$KEYS --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO &> output.txt < /dev/null &" $i
+                                --protocol=$PROTOCOL --keys=$KEYS --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO &> output.txt < /dev/null &" $i
                 done
 
                 # launch the first process
@@ -516,7 +516,7 @@ function run_exp_smallbank {
                         --enable_migration_optimization=$ENABLE_MIGRATION_OPTIMIZATION --migration_policy=$MIGRATION_POLICY --when_to_move_out=$WHEN_TO_MOVE_OUT --hw_cc_budget=$HW_CC_BUDGET
                         --enable_scc=$ENABLE_SCC --scc_mechanism=$SCC_MECH
                         --pre_migrate=$PRE_MIGRATE
-                        --protocol=SundialPasha --keys=$KEYS --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO" 0
+                        --protocol=$PROTOCOL --keys=$KEYS --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO" 0
 
         elif [ $PROTOCOL = "Sundial" ]; then
                 # launch 1-$HOST_NUM processes
@@ -668,7 +668,7 @@ function run_exp_tatp {
         delete_log_files
         init_cxl_for_vms $HOST_NUM
 
-        if [ $PROTOCOL = "SundialPasha" ]; then
+        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "SiloPasha" ]; then
                 # launch 1-$HOST_NUM processes
                 for (( i=1; i < $HOST_NUM; ++i ))
                 do
@@ -681,7 +681,7 @@ function run_exp_tatp {
                                 --enable_migration_optimization=$ENABLE_MIGRATION_OPTIMIZATION --migration_policy=$MIGRATION_POLICY --when_to_move_out=$WHEN_TO_MOVE_OUT --hw_cc_budget=$HW_CC_BUDGET
                                 --enable_scc=$ENABLE_SCC --scc_mechanism=$SCC_MECH
                                 --pre_migrate=$PRE_MIGRATE
-                                --protocol=SundialPasha --keys=$KEYS --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO &> output.txt < /dev/null &" $i
+                                --protocol=$PROTOCOL --keys=$KEYS --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO &> output.txt < /dev/null &" $i
                 done
 
                 # launch the first process
@@ -694,7 +694,7 @@ function run_exp_tatp {
                         --enable_migration_optimization=$ENABLE_MIGRATION_OPTIMIZATION --migration_policy=$MIGRATION_POLICY --when_to_move_out=$WHEN_TO_MOVE_OUT --hw_cc_budget=$HW_CC_BUDGET
                         --enable_scc=$ENABLE_SCC --scc_mechanism=$SCC_MECH
                         --pre_migrate=$PRE_MIGRATE
-                        --protocol=SundialPasha --keys=$KEYS --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO" 0
+                        --protocol=$PROTOCOL --keys=$KEYS --zipf=$ZIPF_THETA --cross_ratio=$CROSS_RATIO" 0
 
         elif [ $PROTOCOL = "Sundial" ]; then
                 # launch 1-$HOST_NUM processes
@@ -850,7 +850,7 @@ if [ $RUN_TYPE = "TPCC" ]; then
         typeset MODEL_CXL_SEARCH_OVERHEAD=${21}
         typeset GATHER_OUTPUT=${22}
 
-        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "TwoPLPasha" ]; then
+        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "TwoPLPasha" ] || [ $PROTOCOL = "SiloPasha" ]; then
                 typeset CXL_TRANS_ENTRY_STRUCT_SIZE=$PASHA_CXL_TRANS_ENTRY_STRUCT_SIZE
                 typeset CXL_TRANS_ENTRY_NUM=$PASHA_CXL_TRANS_ENTRY_NUM
         else
@@ -910,7 +910,7 @@ elif [ $RUN_TYPE = "YCSB" ]; then
         typeset MODEL_CXL_SEARCH_OVERHEAD=${23}
         typeset GATHER_OUTPUT=${24}
 
-        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "TwoPLPasha" ]; then
+        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "TwoPLPasha" ] || [ $PROTOCOL = "SiloPasha" ]; then
                 typeset CXL_TRANS_ENTRY_STRUCT_SIZE=$PASHA_CXL_TRANS_ENTRY_STRUCT_SIZE
                 typeset CXL_TRANS_ENTRY_NUM=$PASHA_CXL_TRANS_ENTRY_NUM
         else
@@ -968,7 +968,7 @@ elif [ $RUN_TYPE = "SmallBank" ]; then
         typeset MODEL_CXL_SEARCH_OVERHEAD=${21}
         typeset GATHER_OUTPUT=${22}
 
-        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "TwoPLPasha" ]; then
+        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "TwoPLPasha" ] || [ $PROTOCOL = "SiloPasha" ]; then
                 typeset CXL_TRANS_ENTRY_STRUCT_SIZE=$PASHA_CXL_TRANS_ENTRY_STRUCT_SIZE
                 typeset CXL_TRANS_ENTRY_NUM=$PASHA_CXL_TRANS_ENTRY_NUM
         else
@@ -1026,7 +1026,7 @@ elif [ $RUN_TYPE = "TATP" ]; then
         typeset MODEL_CXL_SEARCH_OVERHEAD=${21}
         typeset GATHER_OUTPUT=${22}
 
-        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "TwoPLPasha" ]; then
+        if [ $PROTOCOL = "SundialPasha" ] || [ $PROTOCOL = "TwoPLPasha" ] || [ $PROTOCOL = "SiloPasha" ]; then
                 typeset CXL_TRANS_ENTRY_STRUCT_SIZE=$PASHA_CXL_TRANS_ENTRY_STRUCT_SIZE
                 typeset CXL_TRANS_ENTRY_NUM=$PASHA_CXL_TRANS_ENTRY_NUM
         else